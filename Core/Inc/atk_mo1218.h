@@ -22,8 +22,12 @@
 #define __ATK_MO1218_H
 
 #include "atk_mo1218_bin_msg.h"
+#include "atk_mo1218_config.h"
+#include "atk_mo1218_rate.h"
+#include "atk_mo1218_satdb.h"
 #include "atk_mo1218_nmea_msg.h"
 #include "atk_mo1218_uart.h"
+#include "spsc_queue.h"
 
 #include "main.h"
 
@@ -46,25 +50,112 @@ typedef struct
     atk_mo1218_longitude_t longitude;               /* 经度信息 */
 } atk_mo1218_position_t;
 
+/* ATK-MO1218模块定位信息中保存的定位卫星编号的最大数量 */
+#define ATK_MO1218_FIX_SATELLITE_MAX        24
+
+/* ATK-MO1218模块定位卫星位图每个星座的字数（PRN 1~64） */
+#define ATK_MO1218_FIX_PRN_WORDS            (((ATK_MO1218_SATDB_GPS_PRN_MAX > ATK_MO1218_SATDB_BEIDOU_PRN_MAX ? ATK_MO1218_SATDB_GPS_PRN_MAX : ATK_MO1218_SATDB_BEIDOU_PRN_MAX) + 31) / 32)
+
 /* ATK-MO1218模块定位信息结构体 */
 typedef struct
 {
     atk_mo1218_gps_quality_indicator_t quality;     /* 定位质量 */
     uint8_t satellite_num;                          /* 用于定位的卫星数量 */
     atk_mo1218_fix_type_t type;                     /* 定位类型 */
-    uint16_t satellite_id[12];                      /* 用于定位的卫星编号 */
+    uint8_t satellite_id_num;                       /* satellite_id中的卫星数量 */
+    uint16_t satellite_id[ATK_MO1218_FIX_SATELLITE_MAX]; /* 用于定位的卫星编号（历元中全部GSA消息） */
+    uint32_t satellite_used[ATK_MO1218_SATDB_CONSTELLATION_NUM][ATK_MO1218_FIX_PRN_WORDS]; /* 按星座和PRN的定位卫星位图，见atk_mo1218_fix_satellite_used() */
     uint16_t pdop;                                  /* 位置精度因子（扩大10倍） */
     uint16_t hdop;                                  /* 水平精度因子（扩大10倍） */
     uint16_t vdop;                                  /* 垂直精度因子（扩大10倍） */
 } atk_mo1218_fix_info_t;
 
+/* ATK-MO1218模块各星座可见卫星表的容量，可见卫星超出容量时只保存前面的卫星 */
+#define ATK_MO1218_GPS_SATELLITE_MAX        16
+#define ATK_MO1218_GLONASS_SATELLITE_MAX    12
+#define ATK_MO1218_GALILEO_SATELLITE_MAX    12
+#define ATK_MO1218_BEIDOU_SATELLITE_MAX     24
+#define ATK_MO1218_QZSS_SATELLITE_MAX       4
+#define ATK_MO1218_SATELLITE_VIEW_MAX       ATK_MO1218_NMEA_GSV_SATELLITE_MAX  /* 不小于以上各星座的容量 */
+
 /* ATK-MO1218模块可见卫星信息结构体 */
 typedef struct
 {
-    uint8_t satellite_num;                          /* 可见卫星数量 */
-    atk_mo1218_satellite_info_t satellite_info[12]; /* 可见卫星信息 */
+    uint8_t satellite_view;                         /* 模块报告的可见卫星总数 */
+    uint8_t satellite_num;                          /* satellite_info中的卫星数量 */
+    atk_mo1218_satellite_info_t satellite_info[ATK_MO1218_SATELLITE_VIEW_MAX]; /* 可见卫星信息 */
 } atk_mo1218_visible_satellite_info_t;
 
+/* ATK-MO1218模块NMEA消息类型掩码 */
+#define ATK_MO1218_NMEA_MSG_MASK(nmea)      (1UL << (nmea))
+
+/* ATK-MO1218模块定位历元来自导航数据消息（Binary输出模式）的标志 */
+#define ATK_MO1218_FIX_MASK_NAV_DATA        (1UL << 31)
+
+/* ATK-MO1218模块定位历元默认完成条件（收到以下NMEA消息即认为历元完成）
+ * 未定位时模块不输出GSV，因此默认不包含GSV
+ */
+#define ATK_MO1218_EPOCH_REQUIRED_DEFAULT   (ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GGA) | \
+                                             ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GSA) | \
+                                             ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_RMC) | \
+                                             ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_VTG))
+
+/* ATK-MO1218模块定位历元结构体（同一UTC时间输出的全部数据） */
+typedef struct
+{
+    uint32_t mask;                                  /* 已收到的NMEA消息类型，见ATK_MO1218_NMEA_MSG_MASK()和ATK_MO1218_FIX_MASK_NAV_DATA */
+    atk_mo1218_time_t utc;                          /* UTC时间 */
+    atk_mo1218_navigation_data_status_t status;     /* 导航数据状态 */
+    atk_mo1218_position_t position;                 /* 位置信息（经纬度扩大100000倍） */
+    int32_t altitude;                               /* 海拔高度（扩大10倍），单位：米 */
+    uint16_t speed;                                 /* 地面速度（扩大10倍），单位：千米/时 */
+    uint16_t course;                                /* 地面航向（扩大10倍），单位：度 */
+    atk_mo1218_fix_info_t fix_info;                 /* 定位信息 */
+    atk_mo1218_visible_satellite_info_t satellite_info[ATK_MO1218_SATDB_CONSTELLATION_NUM]; /* 各星座的可见卫星信息，按atk_mo1218_satdb_constellation_t索引 */
+    atk_mo1218_nmea_gst_msg_t accuracy;             /* 伪距误差统计（仅mask包含GST时有效） */
+    atk_mo1218_nmea_gbs_msg_t integrity;            /* 卫星故障检测（仅mask包含GBS时有效） */
+    atk_mo1218_nmea_dtm_msg_t datum;                /* 大地基准（仅mask包含DTM时有效） */
+    atk_mo1218_nav_data_t nav_data;                 /* 导航数据（仅mask包含ATK_MO1218_FIX_MASK_NAV_DATA时有效） */
+    uint32_t timestamp;                             /* 历元完成的时间，单位：1毫秒 */
+} atk_mo1218_fix_t;
+
+/* ATK-MO1218模块定位历元中的时间和位置（供只需要位置的模块读取，不必拷贝整个定位历元） */
+typedef struct
+{
+    atk_mo1218_time_t utc;                          /* UTC时间 */
+    atk_mo1218_navigation_data_status_t status;     /* 导航数据状态 */
+    atk_mo1218_position_t position;                 /* 位置信息（经纬度扩大100000倍） */
+    int32_t altitude;                               /* 海拔高度（扩大10倍），单位：米 */
+} atk_mo1218_fix_position_t;
+
+/* ATK-MO1218模块接收流量统计结构体 */
+typedef struct
+{
+    uint32_t bytes;                                 /* 已处理的字节数（NMEA和Binary Message） */
+    uint32_t epochs;                                /* 已开始的定位历元数 */
+} atk_mo1218_rx_stats_t;
+
+/* ATK-MO1218模块定位历元完成事件结构体 */
+typedef struct
+{
+    uint32_t seq;                                   /* 历元序号，不连续时表示读取方错过了历元，同一历元再次发布时不变 */
+    uint32_t mask;                                  /* 历元已收到的NMEA消息类型 */
+    uint32_t timestamp;                             /* 历元完成的时间，单位：1毫秒 */
+} atk_mo1218_fix_event_t;
+
+/* ATK-MO1218模块定位历元完成事件队列大小（必须为2的幂） */
+#define ATK_MO1218_FIX_EVENT_QUEUE_SIZE     4
+
+/* 读取已发布的定位历元时，遇到正在写入而重试的最大次数
+ * 在打断写入方的中断中读取时，重试期间写入无法完成，因此重试次数必须有上限
+ */
+#define ATK_MO1218_FIX_SNAPSHOT_RETRY       4
+
+/* ATK-MO1218模块定位历元完成回调函数类型
+ * republished为1时表示同一历元发布后又收到消息（如GST、GBS）而再次发布
+ */
+typedef void (*atk_mo1218_fix_callback_t)(const atk_mo1218_fix_t *fix, uint8_t republished);
+
 /* 错误代码 */
 #define ATK_MO1218_EOK      0                       /* 没有错误 */
 #define ATK_MO1218_ERROR    1                       /* 错误 */
@@ -72,6 +163,21 @@ typedef struct
 #define ATK_MO1218_EINVAL   3                       /* 参数错误 */
 
 /* 操作函数 */
+uint8_t *atk_mo1218_get_nmea_sentence(void);                                                                                                                                                                                                                                                    /* 从UART接收环形缓冲中提取一条完整的NMEA消息 */
+uint8_t atk_mo1218_get_nmea_stats(atk_mo1218_nmea_stats_t *stats);                                                                                                                                                                                                                              /* 获取NMEA消息接收统计 */
+uint8_t atk_mo1218_get_rx_stats(atk_mo1218_rx_stats_t *stats);                                                                                                                                                                                                                                  /* 获取接收流量统计 */
+void atk_mo1218_process(void);                                                                                                                                                                                                                                                                  /* 处理NMEA消息和异步Binary命令（在主循环中调用） */
+uint8_t atk_mo1218_process_bin(void);                                                                                                                                                                                                                                                           /* 只处理Binary Message和异步Binary命令（阻塞等待Binary命令时调用） */
+void atk_mo1218_nav_data_input(const atk_mo1218_nav_data_t *nav_data);                                                                                                                                                                                                                          /* 将导航数据消息加入定位历元 */
+void atk_mo1218_set_epoch_required(uint32_t required);                                                                                                                                                                                                                                          /* 设置定位历元的完成条件 */
+void atk_mo1218_set_fix_callback(atk_mo1218_fix_callback_t callback);                                                                                                                                                                                                                           /* 设置定位历元完成回调函数 */
+uint8_t atk_mo1218_get_fix(atk_mo1218_fix_t *fix);                                                                                                                                                                                                                                              /* 获取最近完成的定位历元 */
+uint8_t atk_mo1218_fix_satellite_used(const atk_mo1218_fix_info_t *fix_info, atk_mo1218_satdb_constellation_t constellation, uint8_t prn);                                                                                                                                                      /* 查询卫星是否用于定位 */
+uint8_t atk_mo1218_get_fix_event(atk_mo1218_fix_event_t *event);                                                                                                                                                                                                                                /* 获取定位历元完成事件 */
+uint8_t atk_mo1218_get_fix_event_stats(spsc_queue_stats_t *stats);                                                                                                                                                                                                                              /* 获取定位历元完成事件队列统计 */
+uint8_t atk_mo1218_get_last_fix(atk_mo1218_fix_t *fix);                                                                                                                                                                                                                                         /* 获取最近发布的定位历元 */
+uint8_t atk_mo1218_get_last_position(atk_mo1218_fix_position_t *position);                                                                                                                                                                                                                      /* 获取最近发布的定位历元中的时间和位置 */
+uint8_t atk_mo1218_rtc_get_time(atk_mo1218_time_t *utc);                                                                                                                                                                                                                                        /* 获取RTC的当前UTC时间（弱定义） */
 uint8_t atk_mo1218_init(uint32_t baudrate);                                                                                                                                                                                                                                                     /* ATK-MO1218初始化 */
 uint8_t atk_mo1218_update(atk_mo1218_time_t *utc, atk_mo1218_position_t *position, int16_t *altitude, uint16_t *speed, atk_mo1218_fix_info_t *fix_info, atk_mo1218_visible_satellite_info_t *gps_satellite_info, atk_mo1218_visible_satellite_info_t *beidou_satellite_info, uint32_t timeout); /* 获取并更新ATK-MO1218模块数据 */
 
@@ -29,6 +29,24 @@
 /* ATK-MO1218模块Binary Message中Playload的最大大小 */
 #define ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN             0x0057
 
+/* ATK-MO1218模块Binary Message起始字节（Start of Sequence的第一个字节，不会出现在NMEA消息中） */
+#define ATK_MO1218_BIN_MSG_SYNC                         0xA0
+
+/* ATK-MO1218模块异步Binary命令队列大小（必须为2的幂） */
+#define ATK_MO1218_BIN_CMD_QUEUE_SIZE                   4
+
+/* ATK-MO1218模块异步Binary命令单次等待响应超时时间，单位：1毫秒 */
+#define ATK_MO1218_BIN_CMD_TIMEOUT                      1000
+
+/* ATK-MO1218模块异步Binary命令默认超时重发次数 */
+#define ATK_MO1218_BIN_CMD_RETRY                        2
+
+/* ATK-MO1218模块批量配置事务最大消息数量 */
+#define ATK_MO1218_BIN_BATCH_SIZE                       20
+
+/* ATK-MO1218模块批量配置事务消息缓冲大小（全部已组帧的Binary Message） */
+#define ATK_MO1218_BIN_BATCH_BUF_SIZE                   384
+
 /* ATK-MO1218重新启动枚举 */
 typedef enum
 {
@@ -37,6 +55,20 @@ typedef enum
     ATK_MO1218_RESTART_COLD,                            /* 冷启动 */
 } atk_mo1218_restart_t;
 
+/* ATK-MO1218模块重启时提供的UTC时间和概略位置结构体 */
+typedef struct
+{
+    uint16_t year;                                      /* UTC年，不小于1980 */
+    uint8_t month;                                      /* UTC月 */
+    uint8_t day;                                        /* UTC日 */
+    uint8_t hour;                                       /* UTC时 */
+    uint8_t minute;                                     /* UTC分 */
+    uint8_t second;                                     /* UTC秒 */
+    int16_t latitude;                                   /* 纬度（扩大100倍），北纬为正，范围：-9000~9000，单位：度 */
+    int16_t longitude;                                  /* 经度（扩大100倍），东经为正，范围：-18000~18000，单位：度 */
+    int16_t altitude;                                   /* 海拔高度，范围：-1000~18300，单位：米 */
+} atk_mo1218_restart_hint_t;
+
 /* ATK-MO1218模块恢复出厂设置类型枚举 */
 typedef enum
 {
@@ -222,6 +254,15 @@ typedef enum
     ATK_MO1218_GNSS_GPS_BEIDOU,                         /* GPS和北斗 */
 } atk_mo1218_gnss_for_navigation_t;
 
+/* ATK-MO1218模块导航数据定位模式枚举 */
+typedef enum
+{
+    ATK_MO1218_NAV_FIX_NONE = 0x00,                     /* 未定位 */
+    ATK_MO1218_NAV_FIX_2D,                              /* 2D定位 */
+    ATK_MO1218_NAV_FIX_3D,                              /* 3D定位 */
+    ATK_MO1218_NAV_FIX_3D_DGNSS,                        /* 3D差分定位 */
+} atk_mo1218_nav_fix_mode_t;
+
 /* ATK-MO1218软件版本结构体定义 */
 typedef struct
 {
@@ -310,9 +351,61 @@ typedef struct
     atk_mo1218_interence_status_t interence_status;     /* 干扰检测结果 */
 } atk_mo1218_interence_detection_status_t;
 
+/* ATK-MO1218模块异步Binary命令完成回调函数
+ * ret     : ATK_MO1218_EOK（收到ACK及期望的响应）、ATK_MO1218_ERROR（收到NACK）、ATK_MO1218_ETIMEOUT（重发后仍等待响应超时）
+ * playload: 响应消息的Playload，不需要响应或未收到响应时为NULL，仅在回调函数中有效
+ * pl      : 响应消息的Playload Length
+ * arg     : 提交命令时传入的用户参数
+ */
+typedef void (*atk_mo1218_bin_cmd_callback_t)(uint8_t ret, const uint8_t *playload, uint16_t pl, void *arg);
+
+/* ATK-MO1218模块批量配置事务完成回调函数
+ * ret: 每条消息的结果，ATK_MO1218_EOK（收到ACK）、ATK_MO1218_ERROR（收到NACK）、ATK_MO1218_ETIMEOUT（重发后仍未收到ACK/NACK），仅在回调函数中有效
+ * num: 消息数量
+ * arg: 提交事务时传入的用户参数
+ */
+typedef void (*atk_mo1218_bin_batch_callback_t)(const uint8_t *ret, uint8_t num, void *arg);
+
+/* ATK-MO1218模块导航数据结构体（Navigation Data Message） */
+typedef struct
+{
+    atk_mo1218_nav_fix_mode_t fix_mode;                 /* 定位模式 */
+    uint8_t satellite_num;                              /* 用于定位的卫星数量 */
+    uint16_t gps_week;                                  /* GPS周数 */
+    uint32_t tow;                                       /* GPS周内时间，单位：0.01秒 */
+    int32_t latitude;                                   /* 纬度（扩大10000000倍），单位：度，北纬为正 */
+    int32_t longitude;                                  /* 经度（扩大10000000倍），单位：度，东经为正 */
+    int32_t ellipsoid_altitude;                         /* 椭球高，单位：厘米 */
+    int32_t msl_altitude;                               /* 海拔高度，单位：厘米 */
+    uint16_t gdop;                                      /* 几何精度因子（扩大100倍） */
+    uint16_t pdop;                                      /* 位置精度因子（扩大100倍） */
+    uint16_t hdop;                                      /* 水平精度因子（扩大100倍） */
+    uint16_t vdop;                                      /* 垂直精度因子（扩大100倍） */
+    uint16_t tdop;                                      /* 时间精度因子（扩大100倍） */
+    int32_t ecef_x;                                     /* ECEF坐标X，单位：厘米 */
+    int32_t ecef_y;                                     /* ECEF坐标Y，单位：厘米 */
+    int32_t ecef_z;                                     /* ECEF坐标Z，单位：厘米 */
+    int32_t ecef_vx;                                    /* ECEF速度X，单位：厘米/秒 */
+    int32_t ecef_vy;                                    /* ECEF速度Y，单位：厘米/秒 */
+    int32_t ecef_vz;                                    /* ECEF速度Z，单位：厘米/秒 */
+} atk_mo1218_nav_data_t;
+
 /* 操作函数 */
+uint16_t atk_mo1218_bin_msg_extract(uint8_t *block, uint16_t block_len);                                                                                                                                                                /* 从UART接收数据中提取一条Binary Message */
+uint8_t atk_mo1218_decode_nav_data(const uint8_t *playload, uint16_t pl, atk_mo1218_nav_data_t *nav_data);                                                                                                                              /* 解析ATK-MO1218模块导航数据消息 */
+uint8_t atk_mo1218_bin_cmd_submit(uint8_t *playload, uint16_t pl, uint8_t res_mid, uint8_t res_sid, uint32_t timeout, uint8_t retry, atk_mo1218_bin_cmd_callback_t callback, void *arg);                                                /* 提交异步Binary命令 */
+void atk_mo1218_bin_cmd_poll(void);                                                                                                                                                                                                     /* 发送排队的Binary命令并处理超时重发 */
+uint8_t atk_mo1218_bin_cmd_pending(void);                                                                                                                                                                                               /* 获取未完成的异步Binary命令数量 */
+void atk_mo1218_bin_batch_begin(void);                                                                                                                                                                                                  /* 开始组建批量配置事务 */
+uint8_t atk_mo1218_bin_batch_add(uint8_t *playload, uint16_t pl);                                                                                                                                                                       /* 往批量配置事务中添加一条消息 */
+uint8_t atk_mo1218_bin_batch_count(void);                                                                                                                                                                                               /* 获取批量配置事务中的消息数量 */
+uint8_t atk_mo1218_bin_batch_commit(atk_mo1218_bin_batch_callback_t callback, void *arg);                                                                                                                                               /* 提交批量配置事务 */
+uint8_t atk_mo1218_bin_batch_execute(uint8_t *ret);                                                                                                                                                                                     /* 提交批量配置事务并阻塞等待完成 */
+uint8_t atk_mo1218_bin_batch_busy(void);                                                                                                                                                                                                /* 查询批量配置事务是否未完成 */
 uint8_t atk_mo1218_send_bin_msg(uint8_t *playload, uint16_t pl, uint16_t timeout);                                                                                                                                                      /* 往ATK-MO1218发送Binary Message */
 uint8_t atk_mo1218_restart(atk_mo1218_restart_t restart);                                                                                                                                                                               /* ATK-MO1218模块系统重启 */
+uint8_t atk_mo1218_restart_with_hint(atk_mo1218_restart_t restart, const atk_mo1218_restart_hint_t *hint);                                                                                                                              /* ATK-MO1218模块系统重启，并提供UTC时间和概略位置 */
+uint8_t atk_mo1218_restart_async(atk_mo1218_restart_t restart, const atk_mo1218_restart_hint_t *hint, atk_mo1218_bin_cmd_callback_t callback, void *arg);                                                                               /* 异步重启ATK-MO1218模块系统 */
 uint8_t atk_mo1218_get_sw_version(atk_mo1218_sw_version_t *version);                                                                                                                                                                    /* 获取ATK-MO1218模块软件版本 */
 uint8_t atk_mo1218_get_sw_crc(uint16_t *crc);                                                                                                                                                                                           /* 获取ATK-MO1218模块软件CRC值 */
 uint8_t atk_mo1218_factory_reset(atk_mo1218_factory_reset_type_t type);                                                                                                                                                                 /* ATK-MO1218模块恢复出厂设置 */
@@ -330,10 +423,13 @@ uint8_t atk_mo1218_get_datum(uint16_t *datum_index);
 uint8_t atk_mo1218_get_dop_mask(atk_mo1218_dop_mode_t *mode, uint16_t *pdop_val, uint16_t *hdop_val, uint16_t *gdop_val);                                                                                                               /* 获取ATK-MO1218模块DOP掩码 */
 uint8_t atk_mo1218_get_evelation_cnr_mask(atk_mo1218_elevation_cnr_mode_t *mode, uint8_t *elevation_mask, uint8_t *cnr_mask);                                                                                                           /* 获取ATK-MO1218模块Elevation和CNR掩码 */
 uint8_t atk_mo1218_get_gps_ephemeris(uint8_t sv, atk_mo1218_gps_ephemeris_data_t *data);                                                                                                                                                /* 获取ATK-MO1218模块GPS星历数据 */
+uint8_t atk_mo1218_decode_gps_ephemeris(const uint8_t *playload, uint16_t pl, atk_mo1218_gps_ephemeris_data_t *data);                                                                                                                   /* 解析ATK-MO1218模块GPS星历数据消息 */
+uint8_t atk_mo1218_get_gps_ephemeris_async(uint8_t sv, atk_mo1218_bin_cmd_callback_t callback, void *arg);                                                                                                                              /* 异步获取ATK-MO1218模块GPS星历数据 */
 uint8_t atk_mo1218_config_position_pinning(atk_mo1218_position_pinning_t status, atk_mo1218_save_type_t save_type);                                                                                                                     /* 配置ATK-MO1218模块Position Pinning */
 uint8_t atk_mo1218_get_position_pinning_status(atk_mo1218_position_pinning_status_t *status);                                                                                                                                           /* 获取ATK-MO1218模块Position Pinning状态 */
 uint8_t atk_mo1218_config_position_pinning_parameters(atk_mo1218_position_pinning_parameter_t *parameter, atk_mo1218_save_type_t save_type);                                                                                            /* 配置ATK-MO1218模块Position Pinning参数 */
 uint8_t atk_mo1218_set_gps_ephemeris(atk_mo1218_gps_ephemeris_data_t *data);                                                                                                                                                            /* 设置ATK-MO1218模块GPS星历数据 */
+uint8_t atk_mo1218_set_gps_ephemeris_async(const atk_mo1218_gps_ephemeris_data_t *data, atk_mo1218_bin_cmd_callback_t callback, void *arg);                                                                                             /* 异步设置ATK-MO1218模块GPS星历数据 */
 uint8_t atk_mo1218_config_1pps_cable_delay(int32_t cable_delay, atk_mo1218_save_type_t save_type);                                                                                                                                      /* 配置ATK-MO1218模块1PPS的电缆延时 */
 uint8_t atk_mo1218_get_1pps_cable_delay(int32_t *cable_delay);                                                                                                                                                                          /* 获取ATK-MO1218模块1PPS的电缆延时 */
 uint8_t atk_mo1218_config_sbas(atk_mo1218_sbas_parameter_t *parameter, atk_mo1218_save_type_t save_type);                                                                                                                               /* 配置ATK-MO1218模块SBAS */
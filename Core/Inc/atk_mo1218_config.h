@@ -0,0 +1,103 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_config.h
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块配置影子缓存驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __ATK_MO1218_CONFIG_H
+#define __ATK_MO1218_CONFIG_H
+
+#include "atk_mo1218_bin_msg.h"
+
+/* ATK-MO1218模块配置项
+ * 输出类型和导航数据消息间隔无法从模块读取，首次应用配置时总是发送，但只保存到SRAM
+ */
+#define ATK_MO1218_CONFIG_SERIAL                    (1UL << 0)      /* 串口波特率 */
+#define ATK_MO1218_CONFIG_OUTPUT_TYPE               (1UL << 1)      /* 输出类型 */
+#define ATK_MO1218_CONFIG_NMEA_INTERVAL             (1UL << 2)      /* NMEA输出信息间隔 */
+#define ATK_MO1218_CONFIG_POSITION_RATE             (1UL << 3)      /* 位置更新频率 */
+#define ATK_MO1218_CONFIG_NAVIGATION_INTERVAL       (1UL << 4)      /* 导航数据消息间隔 */
+#define ATK_MO1218_CONFIG_POWER_MODE                (1UL << 5)      /* 系统电源模式 */
+#define ATK_MO1218_CONFIG_NAVIGATION_MODE           (1UL << 6)      /* 导航模式 */
+#define ATK_MO1218_CONFIG_GNSS                      (1UL << 7)      /* 用于导航的GNSS */
+#define ATK_MO1218_CONFIG_SBAS                      (1UL << 8)      /* SBAS */
+#define ATK_MO1218_CONFIG_QZSS                      (1UL << 9)      /* QZSS */
+#define ATK_MO1218_CONFIG_SAEE                      (1UL << 10)     /* SAEE */
+#define ATK_MO1218_CONFIG_DOP_MASK                  (1UL << 11)     /* DOP掩码 */
+#define ATK_MO1218_CONFIG_ELEVATION_CNR_MASK        (1UL << 12)     /* Elevation和CNR掩码 */
+#define ATK_MO1218_CONFIG_POSITION_PINNING          (1UL << 13)     /* Position Pinning及其参数 */
+#define ATK_MO1218_CONFIG_INTERFERENCE_DETECTION    (1UL << 14)     /* 干扰检测 */
+#define ATK_MO1218_CONFIG_1PPS_CABLE_DELAY          (1UL << 15)     /* 1PPS电缆延时 */
+#define ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH          (1UL << 16)     /* 1PPS脉冲宽度 */
+#define ATK_MO1218_CONFIG_ALL                       ((1UL << 17) - 1)
+
+/* ATK-MO1218模块配置结构体 */
+typedef struct
+{
+    uint32_t mask;                                                  /* 需要管理的配置项，其余配置项保持模块当前配置 */
+    atk_mo1218_serial_baudrate_t baudrate;                          /* 串口波特率 */
+    atk_mo1218_output_type_t output_type;                           /* 输出类型 */
+    struct
+    {
+        uint8_t gga;
+        uint8_t gsa;
+        uint8_t gsv;
+        uint8_t gll;
+        uint8_t rmc;
+        uint8_t vtg;
+        uint8_t zda;
+        uint8_t gns;
+        uint8_t gbs;
+        uint8_t grs;
+        uint8_t dtm;
+        uint8_t gst;
+    } nmea_interval;                                                /* NMEA输出信息间隔，单位：秒，0表示不输出 */
+    atk_mo1218_position_rate_t position_rate;                       /* 位置更新频率 */
+    uint8_t navigation_interval;                                    /* 导航数据消息间隔 */
+    atk_mo1218_power_mode_t power_mode;                             /* 系统电源模式 */
+    atk_mo1218_navigation_mode_t navigation_mode;                   /* 导航模式 */
+    atk_mo1218_gnss_for_navigation_t gnss;                          /* 用于导航的GNSS */
+    atk_mo1218_sbas_parameter_t sbas;                               /* SBAS参数 */
+    atk_mo1218_qzss_parameter_t qzss;                               /* QZSS参数 */
+    atk_mo1218_saee_parameter_t saee;                               /* SAEE参数 */
+    struct
+    {
+        atk_mo1218_dop_mode_t mode;
+        uint16_t pdop_val;
+        uint16_t hdop_val;
+        uint16_t gdop_val;
+    } dop_mask;                                                     /* DOP掩码（扩大10倍） */
+    struct
+    {
+        atk_mo1218_elevation_cnr_mode_t mode;
+        uint8_t elevation_mask;
+        uint8_t cnr_mask;
+    } elevation_cnr_mask;                                           /* Elevation和CNR掩码 */
+    atk_mo1218_position_pinning_status_t position_pinning;         /* Position Pinning及其参数 */
+    atk_mo1218_interence_detection_enable_t interference_detection; /* 干扰检测 */
+    int32_t pps_cable_delay;                                        /* 1PPS电缆延时，单位：0.01纳秒 */
+    uint32_t pps_pulse_width;                                       /* 1PPS脉冲宽度，单位：微秒 */
+} atk_mo1218_config_t;
+
+/* 操作函数 */
+uint8_t atk_mo1218_config_read(uint32_t mask);                                                  /* 从ATK-MO1218模块读取当前配置到影子缓存 */
+uint32_t atk_mo1218_config_diff(const atk_mo1218_config_t *config);                             /* 获取与影子缓存不同的配置项 */
+uint8_t atk_mo1218_config_apply(const atk_mo1218_config_t *config, atk_mo1218_save_type_t save_type); /* 仅发送与模块当前配置不同的配置项 */
+void atk_mo1218_config_invalidate(uint32_t mask);                                               /* 使影子缓存中的配置项失效 */
+uint32_t atk_mo1218_config_get_shadow(atk_mo1218_config_t *config);                             /* 获取影子缓存 */
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_ephemeris.h
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块GPS星历保存与恢复驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __ATK_MO1218_EPHEMERIS_H
+#define __ATK_MO1218_EPHEMERIS_H
+
+#include "main.h"
+
+/* GPS星历和最后定位位置保存区域
+ * 使用内部Flash末尾的6页，分为两个存储区交替写入，掉电时总有一个完整的存储区，
+ * 工程中IROM1的大小已相应减小为0x1E800
+ */
+#define ATK_MO1218_EPHEMERIS_FLASH_ADDR         0x0801E800
+#define ATK_MO1218_EPHEMERIS_FLASH_BANK_PAGES   3               /* 每个存储区的页数 */
+#define ATK_MO1218_EPHEMERIS_FLASH_BANK_NUM     2               /* 存储区数量 */
+
+/* GPS卫星数量（SV 1~32） */
+#define ATK_MO1218_EPHEMERIS_SV_NUM             32
+
+/* 星历有效时长，超过后不再恢复到模块，单位：秒 */
+#define ATK_MO1218_EPHEMERIS_MAX_AGE            (4 * 3600)
+
+/* 定位后首次保存星历的等待时间（等待模块解调出更多卫星的星历），单位：1毫秒 */
+#define ATK_MO1218_EPHEMERIS_FIRST_DELAY        (2 * 60 * 1000)
+
+/* 保存星历的间隔，单位：1毫秒 */
+#define ATK_MO1218_EPHEMERIS_INTERVAL           (30 * 60 * 1000)
+
+/* 操作函数 */
+void atk_mo1218_ephemeris_init(void);           /* 从Flash恢复GPS星历到ATK-MO1218模块 */
+void atk_mo1218_ephemeris_process(void);        /* 后台保存和恢复GPS星历（在主循环中调用） */
+uint8_t atk_mo1218_ephemeris_save(void);        /* 立即开始保存GPS星历 */
+uint8_t atk_mo1218_ephemeris_busy(void);        /* 查询是否正在保存或恢复GPS星历 */
+uint32_t atk_mo1218_ephemeris_get_ttff(void);   /* 获取首次定位时间（TTFF） */
+
+#endif
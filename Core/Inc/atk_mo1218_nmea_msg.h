@@ -23,21 +23,102 @@
 
 #include "main.h"
 
-/* ATK-MO1218模块NMEA消息类型枚举 */
+/* ATK-MO1218模块NMEA消息最大字段数（含地址段） */
+#define ATK_MO1218_NMEA_FIELD_MAX   24
+
+/* ATK-MO1218模块NMEA消息目录中每种类型最多记录的消息数 */
+#define ATK_MO1218_NMEA_DIR_MSG_MAX         8
+
+/* ATK-MO1218模块NMEA消息最大长度（含句首'$'和句末CR、LF） */
+#define ATK_MO1218_NMEA_SENTENCE_MAX_LEN    96
+
+/* ATK-MO1218模块NMEA消息注册表
+ * 每行注册一种NMEA语句：X(语句ID, 语句ID字符, 解析结果类别)
+ * 语句类型枚举、语句ID字符串、整数键及解析函数的绑定均由此表生成，
+ * 新增一种语句的步骤：
+ * 1. 在此表中添加一行；
+ * 2. 在ATK_MO1218_NMEA_DECODER_TABLE中添加解析结果类别，并定义atk_mo1218_nmea_<类别>_msg_t（含talker和valid成员）；
+ * 3. 在atk_mo1218_nmea_msg.c中定义字段表g_nmea_<类别>_field，并用ATK_MO1218_NMEA_LAYOUT_DEFINE()生成消息描述；
+ * 4. 在本文件中声明、在atk_mo1218_nmea_msg.c中实现atk_mo1218_decode_nmea_xx<类别>()（通常只需以该消息描述调用atk_mo1218_decode_nmea_fields()）；
+ * 发送者ID（星座）与语句类型相互独立，见ATK_MO1218_NMEA_TALKER_TABLE
+ */
+#define ATK_MO1218_NMEA_MSG_TABLE(X)                            \
+    X(GGA, 'G', 'G', 'A', gga)                                  \
+    X(GLL, 'G', 'L', 'L', gll)                                  \
+    X(GSA, 'G', 'S', 'A', gsa)                                  \
+    X(GSV, 'G', 'S', 'V', gsv)                                  \
+    X(RMC, 'R', 'M', 'C', rmc)                                  \
+    X(VTG, 'V', 'T', 'G', vtg)                                  \
+    X(ZDA, 'Z', 'D', 'A', zda)                                  \
+    X(GNS, 'G', 'N', 'S', gns)                                  \
+    X(GBS, 'G', 'B', 'S', gbs)                                  \
+    X(GRS, 'G', 'R', 'S', grs)                                  \
+    X(DTM, 'D', 'T', 'M', dtm)                                  \
+    X(GST, 'G', 'S', 'T', gst)
+
+/* ATK-MO1218模块NMEA消息解析结果类别
+ * 每个类别对应解析函数atk_mo1218_decode_nmea_xx<类别>()和解析结果结构体atk_mo1218_nmea_<类别>_msg_t
+ */
+#define ATK_MO1218_NMEA_DECODER_TABLE(X)                        \
+    X(gga)                                                      \
+    X(gll)                                                      \
+    X(gsa)                                                      \
+    X(gsv)                                                      \
+    X(rmc)                                                      \
+    X(vtg)                                                      \
+    X(zda)                                                      \
+    X(gns)                                                      \
+    X(gbs)                                                      \
+    X(grs)                                                      \
+    X(dtm)                                                      \
+    X(gst)
+
+/* ATK-MO1218模块NMEA发送者ID表
+ * 每行注册一个发送者ID：X(发送者ID字符, 对应的星座)
+ */
+#define ATK_MO1218_NMEA_TALKER_TABLE(X)                         \
+    X('G', 'N', ATK_MO1218_NMEA_TALKER_GN)                      \
+    X('G', 'P', ATK_MO1218_NMEA_TALKER_GP)                      \
+    X('G', 'L', ATK_MO1218_NMEA_TALKER_GL)                      \
+    X('G', 'A', ATK_MO1218_NMEA_TALKER_GA)                      \
+    X('B', 'D', ATK_MO1218_NMEA_TALKER_BD)                      \
+    X('G', 'B', ATK_MO1218_NMEA_TALKER_BD)                      \
+    X('G', 'Q', ATK_MO1218_NMEA_TALKER_GQ)
+
+/* ATK-MO1218模块NMEA消息地址段整数键
+ * 地址段为2个字符的发送者ID和3个字符的语句ID，
+ * 每个字符（0x20~0x5F）压缩为6位，共30位
+ */
+#define ATK_MO1218_NMEA_KEY_CHAR(ch)                (((uint32_t)(ch) - 0x20) & 0x3F)
+#define ATK_MO1218_NMEA_TALKER_KEY(t0, t1)          ((ATK_MO1218_NMEA_KEY_CHAR(t0) << 6) | ATK_MO1218_NMEA_KEY_CHAR(t1))
+#define ATK_MO1218_NMEA_SENTENCE_KEY(s0, s1, s2)    ((ATK_MO1218_NMEA_KEY_CHAR(s0) << 12) | (ATK_MO1218_NMEA_KEY_CHAR(s1) << 6) | ATK_MO1218_NMEA_KEY_CHAR(s2))
+#define ATK_MO1218_NMEA_KEY(t0, t1, s0, s1, s2)     ((ATK_MO1218_NMEA_TALKER_KEY(t0, t1) << 18) | ATK_MO1218_NMEA_SENTENCE_KEY(s0, s1, s2))
+#define ATK_MO1218_NMEA_KEY_TALKER(key)             ((uint32_t)(key) >> 18)         /* 键中的发送者ID部分 */
+#define ATK_MO1218_NMEA_KEY_SENTENCE(key)           ((uint32_t)(key) & 0x3FFFF)     /* 键中的语句ID部分 */
+
+/* ATK-MO1218模块NMEA消息类型枚举（不含发送者ID） */
 typedef enum
 {
-    ATK_MO1218_NMEA_MSG_GNGGA = 0x00,               /* $GNGGA */
-    ATK_MO1218_NMEA_MSG_GNGLL,                      /* $GNGLL */
-    ATK_MO1218_NMEA_MSG_GNGSA,                      /* $GNGSA */
-    ATK_MO1218_NMEA_MSG_GPGSA,                      /* $GPGSA */
-    ATK_MO1218_NMEA_MSG_BDGSA,                      /* $BDGSA */
-    ATK_MO1218_NMEA_MSG_GPGSV,                      /* $GPGSV */
-    ATK_MO1218_NMEA_MSG_BDGSV,                      /* $BDGSV */
-    ATK_MO1218_NMEA_MSG_GNRMC,                      /* $GNRMC */
-    ATK_MO1218_NMEA_MSG_GNVTG,                      /* $GNVTG */
-    ATK_MO1218_NMEA_MSG_GNZDA,                      /* $GNZDA */
+#define ATK_MO1218_NMEA_MSG_ENUM(name, s0, s1, s2, kind)    ATK_MO1218_NMEA_MSG_##name,
+    ATK_MO1218_NMEA_MSG_TABLE(ATK_MO1218_NMEA_MSG_ENUM)
+#undef ATK_MO1218_NMEA_MSG_ENUM
+    ATK_MO1218_NMEA_MSG_NUM,                        /* NMEA消息类型数量 */
 } atk_mo1218_nmea_msg_t;
 
+/* ATK-MO1218模块NMEA发送者（星座）枚举 */
+typedef enum
+{
+    ATK_MO1218_NMEA_TALKER_GN = 0x00,               /* 多星座联合定位（GN） */
+    ATK_MO1218_NMEA_TALKER_GP,                      /* GPS（GP） */
+    ATK_MO1218_NMEA_TALKER_GL,                      /* GLONASS（GL） */
+    ATK_MO1218_NMEA_TALKER_GA,                      /* Galileo（GA） */
+    ATK_MO1218_NMEA_TALKER_BD,                      /* 北斗（BD、GB） */
+    ATK_MO1218_NMEA_TALKER_GQ,                      /* QZSS（GQ） */
+    ATK_MO1218_NMEA_TALKER_UNKNOWN,                 /* 未知发送者 */
+    ATK_MO1218_NMEA_TALKER_NUM,                     /* NMEA发送者数量 */
+    ATK_MO1218_NMEA_TALKER_ANY = 0xFF,              /* 任意发送者（仅用于查找消息） */
+} atk_mo1218_nmea_talker_t;
+
 /* ATK-MO1218模块北纬南纬枚举 */
 typedef enum
 {
@@ -138,9 +219,85 @@ typedef struct
     uint8_t snr;                                    /* 信噪比，单位：dB */
 } atk_mo1218_satellite_info_t;
 
+/* ATK-MO1218模块NMEA消息字段表结构体 */
+typedef struct
+{
+    uint8_t num;                                    /* 字段数量 */
+    struct
+    {
+        uint8_t offset;                             /* 字段相对于句首'$'的偏移 */
+        uint8_t len;                                /* 字段长度 */
+    } field[ATK_MO1218_NMEA_FIELD_MAX];
+} atk_mo1218_nmea_fields_t;
+
+/* ATK-MO1218模块NMEA消息目录结构体 */
+typedef struct
+{
+    uint8_t *buf;                                   /* 建立目录的数据缓冲 */
+    uint8_t num[ATK_MO1218_NMEA_MSG_NUM];           /* 各类型消息的数量 */
+    uint16_t offset[ATK_MO1218_NMEA_MSG_NUM][ATK_MO1218_NMEA_DIR_MSG_MAX]; /* 各类型各条消息相对于数据缓冲的偏移 */
+    uint8_t talker[ATK_MO1218_NMEA_MSG_NUM][ATK_MO1218_NMEA_DIR_MSG_MAX];  /* 各类型各条消息的发送者 */
+} atk_mo1218_nmea_dir_t;
+
+/* ATK-MO1218模块NMEA消息流式解析器状态枚举 */
+typedef enum
+{
+    ATK_MO1218_NMEA_STREAM_WAIT_SS = 0x00,          /* 等待句首'$' */
+    ATK_MO1218_NMEA_STREAM_BODY,                    /* 接收地址段和数据段 */
+    ATK_MO1218_NMEA_STREAM_CHECKSUM_H,              /* 接收校验和高4位 */
+    ATK_MO1218_NMEA_STREAM_CHECKSUM_L,              /* 接收校验和低4位 */
+    ATK_MO1218_NMEA_STREAM_CR,                      /* 等待CR */
+    ATK_MO1218_NMEA_STREAM_LF,                      /* 等待LF */
+} atk_mo1218_nmea_stream_state_t;
+
+/* ATK-MO1218模块NMEA消息接收计数结构体 */
+typedef struct
+{
+    uint32_t ok;                                    /* 校验通过的消息数 */
+    uint32_t bad_checksum;                          /* 校验和错误的消息数 */
+    uint32_t truncated;                             /* 不完整（被截断、超长或格式错误）的消息数 */
+} atk_mo1218_nmea_counter_t;
+
+/* ATK-MO1218模块NMEA消息接收统计结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_counter_t msg[ATK_MO1218_NMEA_MSG_NUM]; /* 各类型NMEA消息的计数 */
+    atk_mo1218_nmea_counter_t unknown;              /* 未知类型或地址段不完整的消息的计数 */
+} atk_mo1218_nmea_stats_t;
+
+/* ATK-MO1218模块NMEA消息流式解析器结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_stream_state_t state;           /* 解析器状态 */
+    uint8_t len;                                    /* 已接收的消息长度 */
+    uint8_t checksum;                               /* 边接收边计算的校验和 */
+    uint8_t checksum_recv;                          /* 消息中携带的校验和 */
+    uint8_t buf[ATK_MO1218_NMEA_SENTENCE_MAX_LEN + 1]; /* 消息缓冲（以'\0'结尾） */
+    atk_mo1218_nmea_stats_t stats;                  /* 接收统计 */
+} atk_mo1218_nmea_stream_t;
+
+/* ATK-MO1218模块NMEA消息字段掩码，第n位表示第n个字段（地址段为第0个字段）
+ * 用于请求解析的字段和解析结果中的有效字段（非空且解析成功），未请求和无效字段的值为0；
+ * 纬度、经度字段同时包含其后的方向字段
+ */
+#define ATK_MO1218_NMEA_FIELD_MASK(index)   (1UL << (index))
+#define ATK_MO1218_NMEA_FIELD_ALL           0xFFFFFFFFUL
+
+/* ATK-MO1218模块NMEA消息XXGGA字段掩码 */
+#define ATK_MO1218_NMEA_GGA_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GGA_LATITUDE        (ATK_MO1218_NMEA_FIELD_MASK(2) | ATK_MO1218_NMEA_FIELD_MASK(3))
+#define ATK_MO1218_NMEA_GGA_LONGITUDE       (ATK_MO1218_NMEA_FIELD_MASK(4) | ATK_MO1218_NMEA_FIELD_MASK(5))
+#define ATK_MO1218_NMEA_GGA_GPS_QUALITY     ATK_MO1218_NMEA_FIELD_MASK(6)
+#define ATK_MO1218_NMEA_GGA_SATELLITE_NUM   ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_GGA_HDOP            ATK_MO1218_NMEA_FIELD_MASK(8)
+#define ATK_MO1218_NMEA_GGA_ALTITUDE        ATK_MO1218_NMEA_FIELD_MASK(9)
+#define ATK_MO1218_NMEA_GGA_GEOIDAL_SEPARATION  ATK_MO1218_NMEA_FIELD_MASK(11)
+#define ATK_MO1218_NMEA_GGA_DGPS_ID         ATK_MO1218_NMEA_FIELD_MASK(14)
+
 /* ATK-MO1218模块NMEA消息XXGGA消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
     atk_mo1218_latitude_t latitude;                 /* 纬度 */
     atk_mo1218_longitude_t longitude;               /* 经度 */
@@ -148,40 +305,85 @@ typedef struct
     uint8_t satellite_num;                          /* 使用的卫星数量 */
     uint16_t hdop;                                  /* 水平精度因子，扩大10倍 */
     int32_t altitude;                               /* 海拔高度，扩大10倍 */
-    /* 大地水准面差距 */
-    uint16_t dgps_id;                               /* DGPS站ID */
+    int32_t geoidal_separation;                     /* 大地水准面差距，扩大10倍，单位：米 */
+    uint16_t dgps_id;                               /* DGPS站ID（非差分定位时无效） */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_gga_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXGLL字段掩码 */
+#define ATK_MO1218_NMEA_GLL_LATITUDE        (ATK_MO1218_NMEA_FIELD_MASK(1) | ATK_MO1218_NMEA_FIELD_MASK(2))
+#define ATK_MO1218_NMEA_GLL_LONGITUDE       (ATK_MO1218_NMEA_FIELD_MASK(3) | ATK_MO1218_NMEA_FIELD_MASK(4))
+#define ATK_MO1218_NMEA_GLL_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(5)
+#define ATK_MO1218_NMEA_GLL_STATUS          ATK_MO1218_NMEA_FIELD_MASK(6)
+
 /* ATK-MO1218模块NMEA消息XXGLL消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     atk_mo1218_latitude_t latitude;                 /* 纬度 */
     atk_mo1218_longitude_t longitude;               /* 经度 */
     atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
     atk_mo1218_xxgll_status_t status;               /* 数据状态 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_gll_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXGSA字段掩码 */
+#define ATK_MO1218_NMEA_GSA_MODE            ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GSA_TYPE            ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_GSA_SATELLITE_ID    (0xFFFUL << 3)                  /* 第3~14个字段 */
+#define ATK_MO1218_NMEA_GSA_PDOP            ATK_MO1218_NMEA_FIELD_MASK(15)
+#define ATK_MO1218_NMEA_GSA_HDOP            ATK_MO1218_NMEA_FIELD_MASK(16)
+#define ATK_MO1218_NMEA_GSA_VDOP            ATK_MO1218_NMEA_FIELD_MASK(17)
+
 /* ATK-MO1218模块NMEA消息XXGSA消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     atk_mo1218_gps_operation_mode_t mode;           /* GPS接收器操作模式 */
     atk_mo1218_fix_type_t type;                     /* 定位类型 */
-    uint8_t satellite_id[12];                       /* 卫星ID */
+    uint16_t satellite_id[12];                      /* 卫星ID */
     uint16_t pdop;                                  /* 位置精度因子，扩大10倍 */
     uint16_t hdop;                                  /* 水平精度因子，扩大10倍 */
     uint16_t vdop;                                  /* 垂直精度因子，扩大10倍 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_gsa_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXGSV消息可保存的卫星数量，与ATK_MO1218_SATELLITE_VIEW_MAX一致 */
+#define ATK_MO1218_NMEA_GSV_SATELLITE_MAX   24
+
 /* ATK-MO1218模块NMEA消息XXGSV消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     uint8_t satellite_view;                         /* 可见卫星总数 */
-    atk_mo1218_satellite_info_t satellite_info[12]; /* 卫星信息 */
+    atk_mo1218_satellite_info_t satellite_info[ATK_MO1218_NMEA_GSV_SATELLITE_MAX]; /* 卫星信息 */
 } atk_mo1218_nmea_gsv_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXGSV单条语句结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    uint8_t msg_num;                                /* 本组语句总数 */
+    uint8_t msg_index;                              /* 本条语句序号，从1开始 */
+    uint8_t satellite_view;                         /* 可见卫星总数 */
+    uint8_t satellite_num;                          /* 本条语句包含的卫星数量 */
+    atk_mo1218_satellite_info_t satellite_info[4];  /* 卫星信息 */
+} atk_mo1218_nmea_gsv_part_t;
+
+/* ATK-MO1218模块NMEA消息XXRMC字段掩码 */
+#define ATK_MO1218_NMEA_RMC_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_RMC_STATUS          ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_RMC_LATITUDE        (ATK_MO1218_NMEA_FIELD_MASK(3) | ATK_MO1218_NMEA_FIELD_MASK(4))
+#define ATK_MO1218_NMEA_RMC_LONGITUDE       (ATK_MO1218_NMEA_FIELD_MASK(5) | ATK_MO1218_NMEA_FIELD_MASK(6))
+#define ATK_MO1218_NMEA_RMC_SPEED_GROUND    ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_RMC_COURSE_GROUND   ATK_MO1218_NMEA_FIELD_MASK(8)
+#define ATK_MO1218_NMEA_RMC_UTC_DATE        ATK_MO1218_NMEA_FIELD_MASK(9)
+#define ATK_MO1218_NMEA_RMC_MODE            ATK_MO1218_NMEA_FIELD_MASK(12)
+
 /* ATK-MO1218模块NMEA消息XXRMC消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
     atk_mo1218_utc_date_t utc_date;                 /* UTC日期 */
     atk_mo1218_navigation_data_status_t status;     /* 导航数据状态 */
@@ -190,35 +392,208 @@ typedef struct
     uint16_t speed_ground;                          /* 地面速度，扩大10倍，单位：节（knot） */
     uint16_t course_ground;                         /* 地面航向，扩大10倍，单位：度 */
     atk_mo1218_pos_sys_mode_t position_system_mode; /* 定位系统模式 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_rmc_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXVTG字段掩码 */
+#define ATK_MO1218_NMEA_VTG_COURSE_TRUE     ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_VTG_COURSE_MAGNETIC ATK_MO1218_NMEA_FIELD_MASK(3)
+#define ATK_MO1218_NMEA_VTG_SPEED_KNOTS     ATK_MO1218_NMEA_FIELD_MASK(5)
+#define ATK_MO1218_NMEA_VTG_SPEED_KPH       ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_VTG_MODE            ATK_MO1218_NMEA_FIELD_MASK(9)
+
 /* ATK-MO1218模块NMEA消息XXVTG消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     uint16_t course_true;                           /* 地面航向，扩大10倍，单位：度 */
     uint16_t course_magnetic;                       /* 地面航向，扩大10倍，单位：度 */
     uint16_t speed_knots;                           /* 地面速度，扩大10倍，单位：节（knot） */
     uint16_t speed_kph;                             /* 地面速度，扩大10倍，单位：千米/时 */
     atk_mo1218_pos_sys_mode_t position_system_mode; /* 定位系统模式 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_vtg_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXZDA字段掩码 */
+#define ATK_MO1218_NMEA_ZDA_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_ZDA_UTC_DATE        (ATK_MO1218_NMEA_FIELD_MASK(2) | ATK_MO1218_NMEA_FIELD_MASK(3) | ATK_MO1218_NMEA_FIELD_MASK(4))
+#define ATK_MO1218_NMEA_ZDA_LOCAL_ZONE      (ATK_MO1218_NMEA_FIELD_MASK(5) | ATK_MO1218_NMEA_FIELD_MASK(6))
+
 /* ATK-MO1218模块NMEA消息XXZDA消息结构体 */
 typedef struct
 {
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
     atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
     atk_mo1218_utc_date_t utc_date;                 /* UTC日期 */
     int8_t local_zone_hour;                         /* 本地时区时，范围：-13~+13 */
     uint8_t local_zone_minute;                      /* 本地时区分，范围：0~59 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
 } atk_mo1218_nmea_zda_msg_t;
 
+/* ATK-MO1218模块NMEA消息XXGNS字段掩码 */
+#define ATK_MO1218_NMEA_GNS_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GNS_LATITUDE        (ATK_MO1218_NMEA_FIELD_MASK(2) | ATK_MO1218_NMEA_FIELD_MASK(3))
+#define ATK_MO1218_NMEA_GNS_LONGITUDE       (ATK_MO1218_NMEA_FIELD_MASK(4) | ATK_MO1218_NMEA_FIELD_MASK(5))
+#define ATK_MO1218_NMEA_GNS_MODE            ATK_MO1218_NMEA_FIELD_MASK(6)
+#define ATK_MO1218_NMEA_GNS_SATELLITE_NUM   ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_GNS_HDOP            ATK_MO1218_NMEA_FIELD_MASK(8)
+#define ATK_MO1218_NMEA_GNS_ALTITUDE        ATK_MO1218_NMEA_FIELD_MASK(9)
+#define ATK_MO1218_NMEA_GNS_GEOIDAL_SEPARATION  ATK_MO1218_NMEA_FIELD_MASK(10)
+#define ATK_MO1218_NMEA_GNS_DGPS_AGE        ATK_MO1218_NMEA_FIELD_MASK(11)
+#define ATK_MO1218_NMEA_GNS_DGPS_ID         ATK_MO1218_NMEA_FIELD_MASK(12)
+#define ATK_MO1218_NMEA_GNS_NAVIGATION_STATUS   ATK_MO1218_NMEA_FIELD_MASK(13)
+
+/* ATK-MO1218模块NMEA消息XXGNS定位模式字符串的最大长度（每个星座一个字符） */
+#define ATK_MO1218_NMEA_GNS_MODE_LEN        6
+
+/* ATK-MO1218模块NMEA消息XXGNS消息结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
+    atk_mo1218_latitude_t latitude;                 /* 纬度 */
+    atk_mo1218_longitude_t longitude;               /* 经度 */
+    uint8_t mode[ATK_MO1218_NMEA_GNS_MODE_LEN + 1]; /* 各星座的定位模式（'N'、'A'、'D'等），以'\0'结尾 */
+    uint8_t satellite_num;                          /* 使用的卫星数量 */
+    uint16_t hdop;                                  /* 水平精度因子，扩大10倍 */
+    int32_t altitude;                               /* 海拔高度，扩大10倍，单位：米 */
+    int32_t geoidal_separation;                     /* 大地水准面差距，扩大10倍，单位：米 */
+    uint16_t dgps_age;                              /* 差分数据龄期，扩大10倍，单位：秒 */
+    uint16_t dgps_id;                               /* DGPS站ID */
+    uint8_t navigation_status;                      /* 导航状态（NMEA 4.1） */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
+} atk_mo1218_nmea_gns_msg_t;
+
+/* ATK-MO1218模块NMEA消息XXGBS字段掩码 */
+#define ATK_MO1218_NMEA_GBS_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GBS_LATITUDE_ERROR  ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_GBS_LONGITUDE_ERROR ATK_MO1218_NMEA_FIELD_MASK(3)
+#define ATK_MO1218_NMEA_GBS_ALTITUDE_ERROR  ATK_MO1218_NMEA_FIELD_MASK(4)
+#define ATK_MO1218_NMEA_GBS_SATELLITE_ID    ATK_MO1218_NMEA_FIELD_MASK(5)
+#define ATK_MO1218_NMEA_GBS_PROBABILITY     ATK_MO1218_NMEA_FIELD_MASK(6)
+#define ATK_MO1218_NMEA_GBS_BIAS            ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_GBS_BIAS_DEVIATION  ATK_MO1218_NMEA_FIELD_MASK(8)
+#define ATK_MO1218_NMEA_GBS_SYSTEM_ID       ATK_MO1218_NMEA_FIELD_MASK(9)
+#define ATK_MO1218_NMEA_GBS_SIGNAL_ID       ATK_MO1218_NMEA_FIELD_MASK(10)
+
+/* ATK-MO1218模块NMEA消息XXGBS消息结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
+    int32_t latitude_error;                         /* 纬度的预期误差，扩大100倍，单位：米 */
+    int32_t longitude_error;                        /* 经度的预期误差，扩大100倍，单位：米 */
+    int32_t altitude_error;                         /* 高度的预期误差，扩大100倍，单位：米 */
+    uint16_t satellite_id;                          /* 最可能故障的卫星ID，未检测到故障时无效 */
+    uint16_t probability;                           /* 故障卫星的漏检概率，扩大1000倍 */
+    int32_t bias;                                   /* 故障卫星的偏差估计，扩大100倍，单位：米 */
+    int32_t bias_deviation;                         /* 偏差估计的标准差，扩大100倍，单位：米 */
+    uint8_t system_id;                              /* GNSS系统ID（NMEA 4.1） */
+    uint8_t signal_id;                              /* 信号ID（NMEA 4.1） */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
+} atk_mo1218_nmea_gbs_msg_t;
+
+/* ATK-MO1218模块NMEA消息XXGRS字段掩码 */
+#define ATK_MO1218_NMEA_GRS_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GRS_MODE            ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_GRS_RESIDUAL        (0xFFFUL << 3)                  /* 第3~14个字段 */
+#define ATK_MO1218_NMEA_GRS_SYSTEM_ID       ATK_MO1218_NMEA_FIELD_MASK(15)
+#define ATK_MO1218_NMEA_GRS_SIGNAL_ID       ATK_MO1218_NMEA_FIELD_MASK(16)
+
+/* ATK-MO1218模块NMEA消息XXGRS消息结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
+    uint8_t mode;                                   /* 0：残差用于计算GGA中的位置，1：残差在计算GGA中的位置后重新计算 */
+    int32_t residual[12];                           /* 与GSA中卫星顺序对应的距离残差，扩大100倍，单位：米 */
+    uint8_t system_id;                              /* GNSS系统ID（NMEA 4.1） */
+    uint8_t signal_id;                              /* 信号ID（NMEA 4.1） */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
+} atk_mo1218_nmea_grs_msg_t;
+
+/* ATK-MO1218模块NMEA消息XXDTM字段掩码 */
+#define ATK_MO1218_NMEA_DTM_DATUM           ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_DTM_SUB_DATUM       ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_DTM_LATITUDE_OFFSET (ATK_MO1218_NMEA_FIELD_MASK(3) | ATK_MO1218_NMEA_FIELD_MASK(4))
+#define ATK_MO1218_NMEA_DTM_LONGITUDE_OFFSET    (ATK_MO1218_NMEA_FIELD_MASK(5) | ATK_MO1218_NMEA_FIELD_MASK(6))
+#define ATK_MO1218_NMEA_DTM_ALTITUDE_OFFSET ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_DTM_REFERENCE_DATUM ATK_MO1218_NMEA_FIELD_MASK(8)
+
+/* ATK-MO1218模块NMEA消息XXDTM大地基准代码的最大长度 */
+#define ATK_MO1218_NMEA_DATUM_LEN           5
+
+/* ATK-MO1218模块NMEA消息XXDTM消息结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    uint8_t datum[ATK_MO1218_NMEA_DATUM_LEN + 1];   /* 本地大地基准代码（如"W84"），以'\0'结尾 */
+    uint8_t sub_datum[ATK_MO1218_NMEA_DATUM_LEN + 1]; /* 本地大地基准子代码，以'\0'结尾 */
+    int32_t latitude_offset;                        /* 纬度偏移，扩大10000倍，单位：分 */
+    uint8_t latitude_indicator;                     /* 纬度偏移方向（'N'、'S'） */
+    int32_t longitude_offset;                       /* 经度偏移，扩大10000倍，单位：分 */
+    uint8_t longitude_indicator;                    /* 经度偏移方向（'E'、'W'） */
+    int32_t altitude_offset;                        /* 高度偏移，扩大100倍，单位：米 */
+    uint8_t reference_datum[ATK_MO1218_NMEA_DATUM_LEN + 1]; /* 参考大地基准代码，以'\0'结尾 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
+} atk_mo1218_nmea_dtm_msg_t;
+
+/* ATK-MO1218模块NMEA消息XXGST字段掩码 */
+#define ATK_MO1218_NMEA_GST_UTC_TIME        ATK_MO1218_NMEA_FIELD_MASK(1)
+#define ATK_MO1218_NMEA_GST_RMS             ATK_MO1218_NMEA_FIELD_MASK(2)
+#define ATK_MO1218_NMEA_GST_SEMI_MAJOR_DEVIATION    ATK_MO1218_NMEA_FIELD_MASK(3)
+#define ATK_MO1218_NMEA_GST_SEMI_MINOR_DEVIATION    ATK_MO1218_NMEA_FIELD_MASK(4)
+#define ATK_MO1218_NMEA_GST_ORIENTATION     ATK_MO1218_NMEA_FIELD_MASK(5)
+#define ATK_MO1218_NMEA_GST_LATITUDE_DEVIATION  ATK_MO1218_NMEA_FIELD_MASK(6)
+#define ATK_MO1218_NMEA_GST_LONGITUDE_DEVIATION ATK_MO1218_NMEA_FIELD_MASK(7)
+#define ATK_MO1218_NMEA_GST_ALTITUDE_DEVIATION  ATK_MO1218_NMEA_FIELD_MASK(8)
+
+/* ATK-MO1218模块NMEA消息XXGST消息结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_talker_t talker;                /* 发送者（星座） */
+    atk_mo1218_utc_time_t utc_time;                 /* UTC时间 */
+    int32_t rms;                                    /* 伪距残差的均方根值，扩大100倍，单位：米 */
+    int32_t semi_major_deviation;                   /* 误差椭圆长半轴标准差，扩大100倍，单位：米 */
+    int32_t semi_minor_deviation;                   /* 误差椭圆短半轴标准差，扩大100倍，单位：米 */
+    uint16_t orientation;                           /* 误差椭圆长半轴方向，扩大10倍，单位：度（以真北为准） */
+    int32_t latitude_deviation;                     /* 纬度误差标准差，扩大100倍，单位：米 */
+    int32_t longitude_deviation;                    /* 经度误差标准差，扩大100倍，单位：米 */
+    int32_t altitude_deviation;                     /* 高度误差标准差，扩大100倍，单位：米 */
+    uint32_t valid;                                 /* 有效字段掩码，见ATK_MO1218_NMEA_FIELD_MASK() */
+} atk_mo1218_nmea_gst_msg_t;
+
+/* ATK-MO1218模块NMEA消息解析结果联合体 */
+typedef union
+{
+#define ATK_MO1218_NMEA_DECODE_MSG_MEMBER(kind)     atk_mo1218_nmea_##kind##_msg_t kind;
+    ATK_MO1218_NMEA_DECODER_TABLE(ATK_MO1218_NMEA_DECODE_MSG_MEMBER)
+#undef ATK_MO1218_NMEA_DECODE_MSG_MEMBER
+} atk_mo1218_nmea_decode_msg_t;
+
 /* 操作函数 */
-uint8_t atk_mo1218_get_nmea_msg_from_buf(uint8_t *buf, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg);   /* 从数据缓冲中获取指定类型和索引的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxgga(uint8_t *xxgga_msg, atk_mo1218_nmea_gga_msg_t *decode_msg);                        /* 解析$XXGGA类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxgll(uint8_t *xxgll_msg, atk_mo1218_nmea_gll_msg_t *decode_msg);                        /* 解析$XXGLL类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxgsa(uint8_t *xxgsa_msg, atk_mo1218_nmea_gsa_msg_t *decode_msg);                        /* 解析$XXGSA类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxgsv(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_msg_t *decode_msg);                        /* 解析$XXGSV类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxrmc(uint8_t *xxrmc_msg, atk_mo1218_nmea_rmc_msg_t *decode_msg);                        /* 解析$XXRMC类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxvtg(uint8_t *xxvtg_msg, atk_mo1218_nmea_vtg_msg_t *decode_msg);                        /* 解析$XXVTG类型的NMEA消息 */
-uint8_t atk_mo1218_decode_nmea_xxzda(uint8_t *xxzda_msg, atk_mo1218_nmea_zda_msg_t *decode_msg);                        /* 解析$XXZDA类型的NMEA消息 */
+uint8_t atk_mo1218_nmea_tokenize(uint8_t *nmea, atk_mo1218_nmea_fields_t *fields);                                                                          /* 扫描一次NMEA消息，建立字段表 */
+void atk_mo1218_nmea_stream_init(atk_mo1218_nmea_stream_t *stream);                                                                                         /* 初始化NMEA消息流式解析器 */
+uint16_t atk_mo1218_nmea_stream_input(atk_mo1218_nmea_stream_t *stream, uint8_t *dat, uint16_t len, uint8_t **sentence);                                    /* 向NMEA消息流式解析器输入数据 */
+uint8_t atk_mo1218_get_nmea_msg_type(uint8_t *address, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea);                                      /* 根据地址段获取NMEA消息类型 */
+const char *atk_mo1218_get_nmea_msg_address(atk_mo1218_nmea_msg_t nmea);                                                                                    /* 获取NMEA消息类型对应的地址段 */
+uint8_t atk_mo1218_decode_nmea_msg(uint8_t *msg, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea, atk_mo1218_nmea_decode_msg_t *decode_msg);  /* 识别并解析一条NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_msg_fields(uint8_t *msg, uint32_t request, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea, atk_mo1218_nmea_decode_msg_t *decode_msg); /* 识别一条NMEA消息并只解析请求的字段 */
+uint8_t atk_mo1218_nmea_dir_build(uint8_t *buf, atk_mo1218_nmea_dir_t *dir);                                                                                /* 遍历一次数据缓冲，建立NMEA消息目录 */
+uint8_t atk_mo1218_nmea_dir_get(atk_mo1218_nmea_dir_t *dir, atk_mo1218_nmea_talker_t talker, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg); /* 从NMEA消息目录中获取指定类型和索引的NMEA消息 */
+uint8_t atk_mo1218_get_nmea_msg_from_buf(uint8_t *buf, atk_mo1218_nmea_talker_t talker, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg);      /* 从数据缓冲中获取指定类型和索引的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgga(uint8_t *xxgga_msg, atk_mo1218_nmea_gga_msg_t *decode_msg);                                                            /* 解析$XXGGA类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgll(uint8_t *xxgll_msg, atk_mo1218_nmea_gll_msg_t *decode_msg);                                                            /* 解析$XXGLL类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgsa(uint8_t *xxgsa_msg, atk_mo1218_nmea_gsa_msg_t *decode_msg);                                                            /* 解析$XXGSA类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgsv(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_msg_t *decode_msg);                                                            /* 解析$XXGSV类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgsv_part(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_part_t *part);                                                            /* 解析一条$XXGSV语句 */
+uint8_t atk_mo1218_decode_nmea_xxrmc(uint8_t *xxrmc_msg, atk_mo1218_nmea_rmc_msg_t *decode_msg);                                                            /* 解析$XXRMC类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxvtg(uint8_t *xxvtg_msg, atk_mo1218_nmea_vtg_msg_t *decode_msg);                                                            /* 解析$XXVTG类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxzda(uint8_t *xxzda_msg, atk_mo1218_nmea_zda_msg_t *decode_msg);                                                            /* 解析$XXZDA类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgns(uint8_t *xxgns_msg, atk_mo1218_nmea_gns_msg_t *decode_msg);                                                            /* 解析$XXGNS类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgbs(uint8_t *xxgbs_msg, atk_mo1218_nmea_gbs_msg_t *decode_msg);                                                            /* 解析$XXGBS类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgrs(uint8_t *xxgrs_msg, atk_mo1218_nmea_grs_msg_t *decode_msg);                                                            /* 解析$XXGRS类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxdtm(uint8_t *xxdtm_msg, atk_mo1218_nmea_dtm_msg_t *decode_msg);                                                            /* 解析$XXDTM类型的NMEA消息 */
+uint8_t atk_mo1218_decode_nmea_xxgst(uint8_t *xxgst_msg, atk_mo1218_nmea_gst_msg_t *decode_msg);                                                            /* 解析$XXGST类型的NMEA消息 */
 
 #endif
@@ -0,0 +1,54 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_rate.h
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块波特率与位置更新频率协商驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __ATK_MO1218_RATE_H
+#define __ATK_MO1218_RATE_H
+
+#include "atk_mo1218_bin_msg.h"
+
+/* 探测波特率时每个波特率的监听时间（1Hz输出时至少包含一条完整的NMEA消息），单位：1毫秒 */
+#define ATK_MO1218_RATE_PROBE_TIME          1500
+
+/* 测量每个历元的字节数时统计的历元数 */
+#define ATK_MO1218_RATE_MEASURE_EPOCHS      5
+
+/* 测量每个历元的字节数的超时时间，单位：1毫秒 */
+#define ATK_MO1218_RATE_MEASURE_TIMEOUT     8000
+
+/* 链路负载上限（百分比），为GSV消息随可见卫星数增长留出余量 */
+#define ATK_MO1218_RATE_LOAD_PERCENT        70
+
+/* 链路健康判定：校验和错误和不完整的消息数不超过校验通过的消息数的1/N */
+#define ATK_MO1218_RATE_ERROR_RATIO         16
+
+/* ATK-MO1218模块协商结果结构体 */
+typedef struct
+{
+    atk_mo1218_serial_baudrate_t baudrate;          /* 协商后的串口波特率 */
+    atk_mo1218_position_rate_t position_rate;       /* 协商后的位置更新频率 */
+    uint32_t bytes_per_epoch;                       /* 测量得到的每个历元的字节数 */
+} atk_mo1218_rate_result_t;
+
+/* 操作函数 */
+uint8_t atk_mo1218_rate_probe(atk_mo1218_serial_baudrate_t *baudrate);                          /* 探测ATK-MO1218模块当前的串口波特率 */
+uint8_t atk_mo1218_rate_measure(uint32_t *bytes_per_epoch);                                     /* 测量每个历元的字节数 */
+uint8_t atk_mo1218_rate_negotiate(atk_mo1218_serial_baudrate_t max_baudrate, atk_mo1218_position_rate_t max_rate, atk_mo1218_save_type_t save_type, atk_mo1218_rate_result_t *result); /* 提升波特率并选择链路带宽允许的最高位置更新频率 */
+
+#endif
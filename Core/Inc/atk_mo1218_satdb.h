@@ -0,0 +1,85 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_satdb.h
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块卫星数据库代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ * 按星座和PRN保存卫星的仰角、方位角、信噪比（来自GSV）和是否用于定位（来自GSA），
+ * 数据库在历元之间保留，长时间未出现的卫星被移除；
+ * 每次修改卫星数据时递增修订号，读取方只需读取修订号大于上次读取时的卫星
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __ATK_MO1218_SATDB_H
+#define __ATK_MO1218_SATDB_H
+
+#include "atk_mo1218_nmea_msg.h"
+
+/* 各星座的PRN范围（GPS包括SBAS） */
+#define ATK_MO1218_SATDB_GPS_PRN_MAX        64
+#define ATK_MO1218_SATDB_GLONASS_PRN_MAX    32
+#define ATK_MO1218_SATDB_GALILEO_PRN_MAX    36
+#define ATK_MO1218_SATDB_BEIDOU_PRN_MAX     63
+#define ATK_MO1218_SATDB_QZSS_PRN_MAX       10
+
+/* 各星座的卫星数据库容量 */
+#define ATK_MO1218_SATDB_GPS_CAPACITY       24
+#define ATK_MO1218_SATDB_GLONASS_CAPACITY   12
+#define ATK_MO1218_SATDB_GALILEO_CAPACITY   12
+#define ATK_MO1218_SATDB_BEIDOU_CAPACITY    24
+#define ATK_MO1218_SATDB_QZSS_CAPACITY      4
+
+/* 卫星超过该时长未出现在GSV和GSA中即被移除，单位：1毫秒 */
+#define ATK_MO1218_SATDB_MAX_AGE            5000
+
+/* ATK-MO1218模块卫星数据库星座枚举 */
+typedef enum
+{
+    ATK_MO1218_SATDB_GPS = 0x00,                    /* GPS */
+    ATK_MO1218_SATDB_GLONASS,                       /* GLONASS */
+    ATK_MO1218_SATDB_GALILEO,                       /* Galileo */
+    ATK_MO1218_SATDB_BEIDOU,                        /* 北斗 */
+    ATK_MO1218_SATDB_QZSS,                          /* QZSS */
+    ATK_MO1218_SATDB_CONSTELLATION_NUM,
+} atk_mo1218_satdb_constellation_t;
+
+/* ATK-MO1218模块卫星数据库条目结构体（读取时使用，数据库内部按字段分别存储） */
+typedef struct
+{
+    atk_mo1218_satdb_constellation_t constellation; /* 星座 */
+    uint8_t prn;                                    /* PRN */
+    uint8_t elevation;                              /* 卫星仰角，单位：度 */
+    uint16_t azimuth;                               /* 卫星方位角，单位：度 */
+    uint8_t snr;                                    /* 信噪比，单位：dB，未跟踪时为0 */
+    uint8_t used;                                   /* 用于定位 */
+    uint32_t seen_tick;                             /* 最近出现在GSV中的时间，单位：1毫秒 */
+    uint32_t used_tick;                             /* 最近出现在GSA中的时间，单位：1毫秒 */
+    uint32_t revision;                              /* 最近修改时的修订号 */
+} atk_mo1218_satdb_entry_t;
+
+/* 操作函数 */
+void atk_mo1218_satdb_gsv_input(atk_mo1218_nmea_talker_t talker, const atk_mo1218_satellite_info_t *satellite_info, uint8_t satellite_num); /* 将一组GSV语句的卫星信息加入数据库 */
+void atk_mo1218_satdb_gsa_input(atk_mo1218_nmea_talker_t talker, const uint16_t *satellite_id, uint8_t satellite_num);                      /* 将一条GSA语句的定位卫星加入数据库 */
+uint8_t atk_mo1218_satdb_get_constellation(atk_mo1218_nmea_talker_t talker, atk_mo1218_satdb_constellation_t *constellation);               /* 根据发送者确定星座 */
+uint8_t atk_mo1218_satdb_get_prn(atk_mo1218_nmea_talker_t talker, uint16_t satellite_id, atk_mo1218_satdb_constellation_t *constellation, uint8_t *prn); /* 根据发送者和卫星编号确定星座和PRN */
+void atk_mo1218_satdb_epoch_begin(void);                                                                                                    /* 开始一个历元 */
+void atk_mo1218_satdb_epoch_end(uint8_t gsa_received);                                                                                      /* 结束一个历元，更新定位卫星并移除过期卫星 */
+uint32_t atk_mo1218_satdb_get_revision(void);                                                                                               /* 获取数据库当前的修订号 */
+uint32_t atk_mo1218_satdb_get_removed_revision(void);                                                                                       /* 获取最近移除卫星时的修订号 */
+uint8_t atk_mo1218_satdb_get_num(atk_mo1218_satdb_constellation_t constellation, uint8_t *used_num);                                        /* 获取星座的卫星数量和定位卫星数量 */
+uint8_t atk_mo1218_satdb_get(atk_mo1218_satdb_constellation_t constellation, uint8_t prn, atk_mo1218_satdb_entry_t *entry);                 /* 获取指定卫星的数据 */
+uint8_t atk_mo1218_satdb_get_changed(uint32_t revision, uint8_t *index, atk_mo1218_satdb_entry_t *entry);                                   /* 遍历指定修订号之后修改过的卫星 */
+
+#endif
@@ -37,28 +37,42 @@
 #define ATK_MO1218_UART_IRQHandler              USART2_IRQHandler
 #define ATK_MO1218_UART_CLK_ENABLE()            do{ __HAL_RCC_UART2_CLK_ENABLE(); }while(0)
 
-/* UART收发缓冲大小 */
-#define ATK_MO1218_UART_RX_BUF_SIZE             2048
+/* UART发送缓冲大小 */
 #define ATK_MO1218_UART_TX_BUF_SIZE             64
 
+/* UART DMA循环接收缓冲大小
+ * DMA每传输半个缓冲就会产生一次事件，
+ * 921600bps时约11ms一次，应用需在此时间内取走数据
+ */
+#define ATK_MO1218_UART_RX_RING_SIZE            2048
+
 /* 操作函数 */
 void atk_mo1218_uart_send(uint8_t *dat, uint8_t len);   /* ATK-MO1218 UART发送数据 */
 void atk_mo1218_uart_printf(char *fmt, ...);            /* ATK-MO1218 UART printf */
-void atk_mo1218_uart_rx_restart(void);                  /* ATK-MO1218 UART重新开始接收数据 */
-uint8_t *atk_mo1218_uart_rx_get_frame(void);            /* 获取ATK-MO1218 UART接收到的一帧数据 */
-uint16_t atk_mo1218_uart_rx_get_frame_len(void);        /* 获取ATK-MO1218 UART接收到的一帧数据的长度 */
 void atk_mo1218_uart_init(uint32_t baudrate);           /* ATK-MO1218 UART初始化 */
+void atk_mo1218_uart_set_baudrate(uint32_t baudrate);   /* 修改ATK-MO1218 UART通讯波特率 */
+uint32_t atk_mo1218_uart_get_baudrate(void);            /* 获取ATK-MO1218 UART通讯波特率 */
+void atk_mo1218_uart_rx_ring_start(void);               /* 启动ATK-MO1218 UART循环DMA接收 */
+void atk_mo1218_uart_rx_ring_update(void);              /* 根据DMA传输进度更新环形缓冲写位置 */
+uint16_t atk_mo1218_uart_rx_ring_available(void);       /* 获取环形缓冲中未读取数据的长度 */
+uint16_t atk_mo1218_uart_rx_ring_get_block(uint8_t **block); /* 获取环形缓冲中可连续读取的数据块 */
+void atk_mo1218_uart_rx_ring_consume(uint16_t len);     /* 释放环形缓冲中已读取的数据 */
+uint16_t atk_mo1218_uart_rx_ring_read(uint8_t *buf, uint16_t len); /* 从环形缓冲中读取数据 */
+uint16_t atk_mo1218_uart_rx_ring_peek(uint8_t *buf, uint16_t len); /* 从环形缓冲中复制数据，不释放 */
+void atk_mo1218_uart_rx_ring_flush(void);               /* 丢弃环形缓冲中未读取的数据 */
+uint32_t atk_mo1218_uart_rx_ring_get_overflow(void);    /* 获取环形缓冲溢出次数 */
+void atk_mo1218_uart_rx_event_from_isr(void);           /* ATK-MO1218 UART接收事件处理（在中断中调用） */
+uint32_t atk_mo1218_uart_rx_get_isr_max_cycles(void);   /* 获取接收事件中断处理的最大耗时 */
 
 typedef struct
 {
-    uint8_t buf[ATK_MO1218_UART_RX_BUF_SIZE]; /* 帧接收缓冲 */
-    struct
-    {
-        uint16_t len : 15;  /* 帧接收长度，sta[14:0] */
-        uint16_t finsh : 1; /* 帧接收完成标志，sta[15] */
-    } sta;                  /* 帧状态信息 */
-} g_uart_rx_frame_t;
-
-extern g_uart_rx_frame_t g_uart_rx_frame;
+    uint8_t buf[ATK_MO1218_UART_RX_RING_SIZE]; /* DMA循环接收缓冲 */
+    volatile uint16_t head;                    /* 写位置，跟随DMA传输进度 */
+    volatile uint32_t head_cnt;                /* 累计写入的字节数 */
+    uint16_t tail;                             /* 读位置，仅由应用修改 */
+    uint32_t tail_cnt;                         /* 累计读取的字节数 */
+    volatile uint32_t overflow;                /* 溢出次数 */
+    volatile uint8_t resync;                   /* DMA重新启动，需要重新同步读位置 */
+} g_uart_rx_ring_t;
 
 #endif
@@ -54,7 +54,7 @@ void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
 
-void user_gps_getdata(void);
+void user_hmi_process(void);
 
 /* USER CODE END EFP */
 
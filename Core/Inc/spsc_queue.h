@@ -0,0 +1,68 @@
+/**
+ ****************************************************************************************************
+ * @file        spsc_queue.h
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       单生产者单消费者无锁队列代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ * 用于中断与主循环之间传递定长消息：
+ * 生产者只写wr，消费者只写rd，元素写入（读出）完成后以内存屏障发布索引，无需关中断；
+ * 同一队列的生产者（消费者）必须在同一执行上下文（或同一抢占优先级的中断）中调用
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __SPSC_QUEUE_H
+#define __SPSC_QUEUE_H
+
+#include "main.h"
+
+/* 错误代码 */
+#define SPSC_QUEUE_EOK      0               /* 没有错误 */
+#define SPSC_QUEUE_ERROR    1               /* 队列满（入队）或队列空（出队） */
+
+/* 单生产者单消费者队列结构体 */
+typedef struct
+{
+    uint8_t *buf;                           /* 元素缓冲 */
+    uint16_t elem_size;                     /* 元素大小 */
+    uint16_t size;                          /* 元素个数（必须为2的幂） */
+    volatile uint16_t wr;                   /* 写索引（自由计数），仅由生产者修改 */
+    volatile uint16_t rd;                   /* 读索引（自由计数），仅由消费者修改 */
+    volatile uint16_t high_water;           /* 队列中元素个数的最大值，仅由生产者修改 */
+    volatile uint32_t overflow;             /* 队列满丢弃的元素个数，仅由生产者修改 */
+} spsc_queue_t;
+
+/* 单生产者单消费者队列统计结构体 */
+typedef struct
+{
+    uint16_t high_water;                    /* 队列中元素个数的最大值 */
+    uint32_t overflow;                      /* 队列满丢弃的元素个数 */
+} spsc_queue_stats_t;
+
+/* 定义静态队列及其元素缓冲，size必须为2的幂 */
+#define SPSC_QUEUE_DEFINE(name, type, size)                                                         \
+    typedef char name##_size_check[(((size) & ((size) - 1)) == 0) ? 1 : -1];                        \
+    static type name##_buf[(size)];                                                                 \
+    static spsc_queue_t name = {(uint8_t *)name##_buf, sizeof(type), (size), 0, 0, 0, 0}
+
+/* 操作函数 */
+uint8_t spsc_queue_push(spsc_queue_t *queue, const void *elem);    /* 元素入队（生产者调用） */
+void *spsc_queue_front(spsc_queue_t *queue);                       /* 获取队首元素，不出队（消费者调用） */
+void spsc_queue_release(spsc_queue_t *queue);                      /* 释放队首元素（消费者调用） */
+uint8_t spsc_queue_pop(spsc_queue_t *queue, void *elem);           /* 元素出队（消费者调用） */
+void spsc_queue_flush(spsc_queue_t *queue);                        /* 丢弃队列中的全部元素（消费者调用） */
+uint16_t spsc_queue_count(spsc_queue_t *queue);                    /* 获取队列中的元素个数 */
+void spsc_queue_get_stats(spsc_queue_t *queue, spsc_queue_stats_t *stats); /* 获取队列统计 */
+
+#endif
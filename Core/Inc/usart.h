@@ -29,6 +29,7 @@ extern "C" {
 #include "main.h"
 
 /* USER CODE BEGIN Includes */
+#include "spsc_queue.h"
 
 /* USER CODE END Includes */
 
@@ -40,28 +41,65 @@ extern UART_HandleTypeDef huart3;
 
 /* USER CODE BEGIN Private defines */
 
-#define USART1_MAX_SENDLEN 256
+#define USART1_MAX_SENDLEN 1024  /* USART1 发送队列大小 */
 #define USART1_MAX_RECVLEN 256
 #define USART2_MAX_SENDLEN 512
 #define USART2_MAX_RECVLEN 1024
-#define USART3_MAX_SENDLEN 256
+#define USART3_MAX_SENDLEN 512   /* USART3 发送队列大小 */
 #define USART3_MAX_RECVLEN 256
 
+#define USART3_RX_FRAME_MAXLEN 64       /* USART3 接收帧队列中单帧的最大长度，超出部分被截断并计数 */
+#define USART3_RX_FRAME_QUEUE_SIZE 4    /* USART3 接收帧队列大小（必须为2的幂） */
+
+#define UART_TX_MSG_MAXLEN 256          /* 单条格式化消息的最大长度（在栈上格式化） */
+#define UART_TX_BLOCK_TIMEOUT 200       /* UART_TX_POLICY_BLOCK 等待队列空间的超时时间，单位：1毫秒 */
+
+/* 发送队列满时的处理策略 */
+typedef enum
+{
+  UART_TX_POLICY_DROP = 0x00,           /* 丢弃新消息（日志输出，不影响主循环） */
+  UART_TX_POLICY_BLOCK,                 /* 等待队列空间，超时后丢弃（中断中调用时直接丢弃） */
+} uart_tx_policy_t;
+
+/* 发送队列统计 */
+typedef struct
+{
+  uint32_t queued;                      /* 入队的消息数 */
+  uint32_t dropped;                     /* 丢弃的消息数 */
+  uint32_t dropped_bytes;               /* 丢弃的字节数 */
+  uint16_t high_water;                  /* 队列占用的最大字节数 */
+} uart_tx_stats_t;
+
+/* USART3 接收帧 */
+typedef struct
+{
+  uint16_t len;
+  uint8_t data[USART3_RX_FRAME_MAXLEN];
+} usart3_rx_frame_t;
+
 extern uint8_t USART1_TxBUF[USART1_MAX_SENDLEN];
 extern uint8_t USART1_RxBUF[USART1_MAX_RECVLEN];
 extern uint8_t USART2_TxBUF[USART2_MAX_SENDLEN];
 extern uint8_t USART2_RxBUF[USART2_MAX_RECVLEN];
 extern uint8_t USART3_TxBUF[USART3_MAX_SENDLEN];
 extern uint8_t USART3_RxBUF[USART3_MAX_RECVLEN];
-extern volatile uint16_t USART2_RxLen, USART3_RxLen;
-extern volatile uint8_t USART2_RecvEndFlag, USART3_RecvEndFlag;
-extern volatile uint8_t print_mode;
+extern volatile uint16_t USART2_RxLen;
+extern volatile uint8_t USART2_RecvEndFlag;
 
 void u2_start_idle_receive(void);
 void u3_start_idle_receive(void);
 void u1_printf(char *fmt, ...);
 void u2_printf(char *fmt, ...);
 void u3_printf(char *fmt, ...);
+uint16_t u1_write(const uint8_t *data, uint16_t len);
+uint16_t u3_write(const uint8_t *data, uint16_t len);
+void uart_tx_get_stats(UART_HandleTypeDef *huart, uart_tx_stats_t *stats);
+void uart_tx_flush(UART_HandleTypeDef *huart, uint32_t timeout);
+void uart_tx_error(UART_HandleTypeDef *huart);
+uint8_t u3_get_frame(usart3_rx_frame_t *frame);
+void u3_get_rx_stats(spsc_queue_stats_t *stats);
+uint32_t u3_get_rx_truncated(void);
+uint32_t uart_get_error_count(UART_HandleTypeDef *huart);
 
 /* USER CODE END Private defines */
 
@@ -20,10 +20,75 @@
 
 #include "atk_mo1218.h"
 #include "usart.h"
-#include "delay.h"
+#include <string.h>
+#include <math.h>
+
+/* GPS时间与UTC时间的差值（闰秒数，2017年起为18秒），单位：秒 */
+#define ATK_MO1218_GPS_UTC_LEAP_SECONDS     18
+
+/* GPS时间起点（1980-01-06）距1970-01-01的天数 */
+#define ATK_MO1218_GPS_EPOCH_DAYS           3657
+
+/* 接收数据处理的执行状态，用于拒绝在回调函数中重入 */
+#define ATK_MO1218_PROCESS_IDLE             0   /* 未在处理 */
+#define ATK_MO1218_PROCESS_ALL              1   /* 正在处理NMEA消息和异步Binary命令 */
+#define ATK_MO1218_PROCESS_BIN              2   /* 正在阻塞等待Binary命令，只处理Binary Message */
+
+/* ATK-MO1218模块GSV消息组装器
+ * GSV消息由多条语句组成，每收到一条语句即解析并写入本星座的卫星表，
+ * 收到最后一条语句后才将整组卫星一次性发布到定位历元，不会出现新旧卫星混合的情况
+ */
+typedef struct
+{
+    atk_mo1218_satellite_info_t *table;         /* 卫星表 */
+    uint8_t capacity;                           /* 卫星表容量 */
+    uint8_t msg_num;                            /* 正在组装的一组语句的总数 */
+    uint8_t next_index;                         /* 期望的下一条语句序号，为0时等待第1条语句 */
+    uint8_t satellite_view;                     /* 可见卫星总数 */
+    uint8_t satellite_num;                      /* 卫星表中的卫星数量 */
+} atk_mo1218_gsv_assembler_t;
+
+static atk_mo1218_satellite_info_t g_gpgsv_table[ATK_MO1218_GPS_SATELLITE_MAX];      /* $GPGSV卫星表 */
+static atk_mo1218_satellite_info_t g_glgsv_table[ATK_MO1218_GLONASS_SATELLITE_MAX];  /* $GLGSV卫星表 */
+static atk_mo1218_satellite_info_t g_gagsv_table[ATK_MO1218_GALILEO_SATELLITE_MAX];  /* $GAGSV卫星表 */
+static atk_mo1218_satellite_info_t g_bdgsv_table[ATK_MO1218_BEIDOU_SATELLITE_MAX];   /* $BDGSV卫星表 */
+static atk_mo1218_satellite_info_t g_gqgsv_table[ATK_MO1218_QZSS_SATELLITE_MAX];     /* $GQGSV卫星表 */
+
+static atk_mo1218_nmea_stream_t g_nmea_stream = {0};                              /* NMEA消息流式解析器 */
+static atk_mo1218_gsv_assembler_t g_gsv_assembler[ATK_MO1218_SATDB_CONSTELLATION_NUM] = {   /* 各星座的GSV组装器，按atk_mo1218_satdb_constellation_t索引 */
+    {g_gpgsv_table, ATK_MO1218_GPS_SATELLITE_MAX, 0, 0, 0, 0},                  /* ATK_MO1218_SATDB_GPS */
+    {g_glgsv_table, ATK_MO1218_GLONASS_SATELLITE_MAX, 0, 0, 0, 0},              /* ATK_MO1218_SATDB_GLONASS */
+    {g_gagsv_table, ATK_MO1218_GALILEO_SATELLITE_MAX, 0, 0, 0, 0},              /* ATK_MO1218_SATDB_GALILEO */
+    {g_bdgsv_table, ATK_MO1218_BEIDOU_SATELLITE_MAX, 0, 0, 0, 0},               /* ATK_MO1218_SATDB_BEIDOU */
+    {g_gqgsv_table, ATK_MO1218_QZSS_SATELLITE_MAX, 0, 0, 0, 0},                 /* ATK_MO1218_SATDB_QZSS */
+};
+static atk_mo1218_rx_stats_t g_rx_stats = {0};                                    /* 接收流量统计 */
+static uint8_t g_process_state = ATK_MO1218_PROCESS_IDLE;                          /* 接收数据处理的执行状态 */
+
+/* 定位历元完成事件队列，历元组装器为生产者，读取定位历元的应用为消费者 */
+SPSC_QUEUE_DEFINE(g_fix_event_queue, atk_mo1218_fix_event_t, ATK_MO1218_FIX_EVENT_QUEUE_SIZE);
+
+/* ATK-MO1218模块定位历元组装器
+ * 按UTC时间将逐条解析的NMEA消息组装为定位历元，仅在主循环中访问；
+ * 已发布的历元ready由序号ready_seq保护（顺序锁），可在任意上下文中读取
+ */
+static struct
+{
+    atk_mo1218_fix_t fix;                       /* 正在组装的历元 */
+    uint32_t time_tag;                          /* 正在组装的历元的UTC时间，单位：1毫秒 */
+    uint8_t open;                               /* 正在组装的历元已收到带UTC时间的消息 */
+    uint8_t published;                          /* 正在组装的历元已发布 */
+    uint8_t updated;                            /* 正在组装的历元发布后又收到了消息，需要再次发布 */
+    uint32_t required;                          /* 历元完成条件，为0时使用ATK_MO1218_EPOCH_REQUIRED_DEFAULT */
+    atk_mo1218_fix_t ready;                     /* 最近一个已完成的历元 */
+    volatile uint32_t ready_seq;                /* ready的写入序号，为奇数时正在写入 */
+    uint32_t seq;                               /* 已发布的历元数 */
+    atk_mo1218_fix_callback_t callback;         /* 历元完成回调函数 */
+} g_epoch = {0};
 
 /**
  * @brief       ATK-MO1218初始化
+ * @note        模块在指定波特率下无响应时自动探测模块当前的波特率
  * @param       baudrate: ATK-MO1218 UART通讯波特率
  * @retval      ATK_MO1218_EOK  : ATK-MO1218初始化成功
  *              ATK_MO1218_ERROR: ATK-MO1218初始化失败
@@ -33,9 +98,15 @@ uint8_t atk_mo1218_init(uint32_t baudrate)
     uint8_t ret;
     atk_mo1218_sw_version_t version;
     
-    // atk_mo1218_uart_init(baudrate);
+    /* UART由CubeMX初始化，此处只在波特率不同时重新配置 */
+    if (atk_mo1218_uart_get_baudrate() != baudrate)
+    {
+        atk_mo1218_uart_set_baudrate(baudrate);
+    }
+    
+    /* 模块可能仍保持上次协商的波特率（只复位了MCU），无响应时探测模块当前的波特率 */
     ret = atk_mo1218_get_sw_version(&version);
-    if (ret != ATK_MO1218_EOK)
+    if ((ret != ATK_MO1218_EOK) && (atk_mo1218_rate_probe(NULL) != ATK_MO1218_EOK))
     {
         return ATK_MO1218_ERROR;
     }
@@ -44,241 +115,1028 @@ uint8_t atk_mo1218_init(uint32_t baudrate)
 }
 
 /**
- * @brief       获取并更新ATK-MO1218模块数据
- * @param       utc                  : UTC时间
- *              position             : 位置信息（经纬度扩大100000倍）
- *              altitude             : 海拔高度（扩大10倍），单位：米
- *              speed                : 地面速度（扩大10倍），单位：千米/时
- *              fix_info             : 定位信息
- *              gps_satellite_info   : 可见GPS卫星信息
- *              beidou_satellite_info: 可见北斗卫星信息
- *              timeout              : 等待超时时间，单位：1毫秒
- * @retval      ATK_MO1218_EOK     : 获取并更新ATK-MO1218模块数据成功
- *              ATK_MO1218_EINVAL  : 函数参数错误
- *              ATK_MO1218_ETIMEOUT: 等待超时
+ * @brief       从UART接收环形缓冲中提取一条完整的NMEA消息
+ * @note        直接解析DMA环形缓冲中的数据，无需等待整帧接收完成，
+ *              夹在其中的Binary Message被提取并交由异步Binary命令队列处理
+ * @param       无
+ * @retval      NULL: 暂无完整的NMEA消息
+ *              其他: 提取到的NMEA消息（下次调用前有效）
  */
-uint8_t atk_mo1218_update(atk_mo1218_time_t *utc, atk_mo1218_position_t *position, int16_t *altitude, uint16_t *speed, atk_mo1218_fix_info_t *fix_info, atk_mo1218_visible_satellite_info_t *gps_satellite_info, atk_mo1218_visible_satellite_info_t *beidou_satellite_info, uint32_t timeout)
+uint8_t *atk_mo1218_get_nmea_sentence(void)
 {
-    uint8_t ret;
-    uint8_t *buf;
-    uint8_t *nmea;
-    struct
-    {
-        atk_mo1218_nmea_gga_msg_t msg;
-        uint8_t done;
-    } gngga;
-    struct
-    {
-        atk_mo1218_nmea_gsa_msg_t msg;
-        uint8_t done;
-    } gngsa;
-    struct
-    {
-        atk_mo1218_nmea_gsv_msg_t msg;
-        uint8_t done;
-    } gpgsv;
-    struct
-    {
-        atk_mo1218_nmea_gsv_msg_t msg;
-        uint8_t done;
-    } bdgsv;
-    struct
-    {
-        atk_mo1218_nmea_rmc_msg_t msg;
-        uint8_t done;
-    } gnrmc;
-    struct
-    {
-        atk_mo1218_nmea_vtg_msg_t msg;
-        uint8_t done;
-    } gnvtg;
-    uint8_t satellite_index;
+    uint8_t *block;
+    uint16_t block_len;
+    uint8_t *sync;
+    uint16_t used;
+    uint8_t *sentence = NULL;
     
-    if ((utc == NULL) && (position == NULL) && (altitude == NULL) && (speed == NULL) && (fix_info == NULL) && (gps_satellite_info == NULL) && (beidou_satellite_info == NULL))
+    /* 主动读取DMA传输进度，不必等待IDLE或半传输事件 */
+    atk_mo1218_uart_rx_ring_update();
+    
+    while (sentence == NULL)
+    {
+        block_len = atk_mo1218_uart_rx_ring_get_block(&block);
+        if (block_len == 0)
+        {
+            break;
+        }
+        
+        if (block[0] == ATK_MO1218_BIN_MSG_SYNC)
+        {
+            /* Binary Message，帧不完整时等待后续数据 */
+            used = atk_mo1218_bin_msg_extract(block, block_len);
+            if (used == 0)
+            {
+                break;
+            }
+        }
+        else
+        {
+            /* NMEA消息，只解析到下一个Binary Message起始字节之前 */
+            sync = memchr(block, ATK_MO1218_BIN_MSG_SYNC, block_len);
+            if (sync != NULL)
+            {
+                block_len = sync - block;
+            }
+            used = atk_mo1218_nmea_stream_input(&g_nmea_stream, block, block_len, &sentence);
+        }
+        
+        atk_mo1218_uart_rx_ring_consume(used);
+        g_rx_stats.bytes += used;
+    }
+    
+    return sentence;
+}
+
+/**
+ * @brief       获取NMEA消息接收统计
+ * @note        用于监测通讯链路质量
+ * @param       stats: NMEA消息接收统计（各类型消息的校验通过、校验和错误、不完整计数）
+ * @retval      ATK_MO1218_EOK   : 获取成功
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_nmea_stats(atk_mo1218_nmea_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    memcpy(stats, &g_nmea_stream.stats, sizeof(atk_mo1218_nmea_stats_t));
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取接收流量统计
+ * @note        用于计算每个历元的字节数，见atk_mo1218_rate_measure()
+ * @param       stats: 接收流量统计
+ * @retval      ATK_MO1218_EOK   : 获取成功
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_rx_stats(atk_mo1218_rx_stats_t *stats)
+{
+    if (stats == NULL)
     {
         return ATK_MO1218_EINVAL;
     }
     
-    gngga.done = 0;
-    gngsa.done = 0;
-    gpgsv.done = 0;
-    bdgsv.done = 0;
-    gnrmc.done = 0;
-    gnvtg.done = 0;
+    memcpy(stats, &g_rx_stats, sizeof(atk_mo1218_rx_stats_t));
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       将一条GSV语句加入组装器
+ * @note        收到第1条语句时开始新的一组，语句缺失或乱序时丢弃正在组装的一组
+ * @param       assembler: GSV消息组装器
+ *              part     : 解析后的GSV语句
+ * @retval      ATK_MO1218_EOK  : 一组GSV语句已收齐
+ *              ATK_MO1218_ERROR: 一组GSV语句尚未收齐或已被丢弃
+ */
+static uint8_t atk_mo1218_gsv_assemble(atk_mo1218_gsv_assembler_t *assembler, const atk_mo1218_nmea_gsv_part_t *part)
+{
+    uint8_t satellite_index;
+    uint8_t table_index;
     
-    // atk_mo1218_uart_rx_restart();
-    while (timeout > 0)
+    /* Sequence number为1，开始新的一组GSV语句 */
+    if (part->msg_index == 1)
     {
-        buf = atk_mo1218_uart_rx_get_frame();
-        if (buf != NULL)
+        assembler->msg_num = part->msg_num;
+        assembler->satellite_view = part->satellite_view;
+        assembler->satellite_num = 0;
+        assembler->next_index = 1;
+    }
+    
+    if ((assembler->next_index != part->msg_index) || (assembler->msg_num != part->msg_num) || (assembler->satellite_view != part->satellite_view))
+    {
+        assembler->next_index = 0;
+        return ATK_MO1218_ERROR;
+    }
+    
+    for (satellite_index=0; satellite_index<part->satellite_num; satellite_index++)
+    {
+        table_index = (part->msg_index - 1) * 4 + satellite_index;
+        if (table_index >= assembler->capacity)
         {
-            /* GNGGA */
-            if (((altitude != NULL) || (fix_info != NULL)) && (gngga.done == 0))
+            break;
+        }
+        assembler->table[table_index] = part->satellite_info[satellite_index];
+        assembler->satellite_num = table_index + 1;
+    }
+    
+    if (part->msg_index != part->msg_num)
+    {
+        assembler->next_index++;
+        return ATK_MO1218_ERROR;
+    }
+    
+    assembler->next_index = 0;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       写入已发布的定位历元
+ * @note        写入期间序号为奇数，读取方据此丢弃不完整的数据，无需关中断
+ * @param       fix: 定位历元
+ * @retval      无
+ */
+static void atk_mo1218_fix_snapshot_write(const atk_mo1218_fix_t *fix)
+{
+    g_epoch.ready_seq++;
+    __DMB();                                    /* 先使序号为奇数，再写入数据 */
+    memcpy(&g_epoch.ready, fix, sizeof(atk_mo1218_fix_t));
+    __DMB();                                    /* 数据写入完成后，再使序号为偶数 */
+    g_epoch.ready_seq++;
+}
+
+/**
+ * @brief       读取已发布的定位历元
+ * @note        读取前后的序号相同且为偶数时读到的数据完整，否则重试
+ * @param       fix: 定位历元
+ * @retval      ATK_MO1218_EOK     : 读取成功
+ *              ATK_MO1218_ETIMEOUT: 重试ATK_MO1218_FIX_SNAPSHOT_RETRY次后仍在写入
+ */
+static uint8_t atk_mo1218_fix_snapshot_read(atk_mo1218_fix_t *fix)
+{
+    uint8_t retry;
+    uint32_t seq;
+    
+    for (retry = 0; retry < ATK_MO1218_FIX_SNAPSHOT_RETRY; retry++)
+    {
+        seq = g_epoch.ready_seq;
+        if ((seq & 1) != 0)
+        {
+            continue;
+        }
+        
+        __DMB();                                /* 读到序号后再读数据 */
+        memcpy(fix, &g_epoch.ready, sizeof(atk_mo1218_fix_t));
+        __DMB();                                /* 数据读取完成后再检查序号 */
+        
+        if (g_epoch.ready_seq == seq)
+        {
+            return ATK_MO1218_EOK;
+        }
+    }
+    
+    return ATK_MO1218_ETIMEOUT;
+}
+
+/**
+ * @brief       发布正在组装的定位历元
+ * @note        已发布的历元此后又收到消息时再次发布，历元序号不变
+ * @param       无
+ * @retval      无
+ */
+static void atk_mo1218_epoch_publish(void)
+{
+    atk_mo1218_fix_event_t event;
+    uint8_t republished;
+    
+    if ((g_epoch.open == 0) || (g_epoch.fix.mask == 0) || ((g_epoch.published != 0) && (g_epoch.updated == 0)))
+    {
+        return;
+    }
+    
+    republished = g_epoch.published;
+    g_epoch.fix.timestamp = HAL_GetTick();
+    atk_mo1218_fix_snapshot_write(&g_epoch.fix);
+    if (republished == 0)
+    {
+        atk_mo1218_satdb_epoch_end(((g_epoch.fix.mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GSA)) != 0) ? 1 : 0);
+        g_epoch.seq++;
+    }
+    g_epoch.published = 1;
+    g_epoch.updated = 0;
+    
+    /* 队列满时事件被丢弃并计入队列统计，读取方仍可通过序号发现错过的历元 */
+    event.seq = g_epoch.seq;
+    event.mask = g_epoch.fix.mask;
+    event.timestamp = g_epoch.fix.timestamp;
+    spsc_queue_push(&g_fix_event_queue, &event);
+    
+    /* 回调在写入方的上下文中执行，此时没有并发写入，直接传递已发布的历元 */
+    if (g_epoch.callback != NULL)
+    {
+        g_epoch.callback(&g_epoch.ready, republished);
+    }
+}
+
+/**
+ * @brief       开始组装新的定位历元
+ * @note        未发布（或发布后又收到消息）的上一个历元视为已完成，先将其发布
+ * @param       time_tag: 新历元的UTC时间，单位：1毫秒
+ * @retval      无
+ */
+static void atk_mo1218_epoch_start(uint32_t time_tag)
+{
+    atk_mo1218_epoch_publish();
+    
+    memset(&g_epoch.fix, 0, sizeof(atk_mo1218_fix_t));
+    g_epoch.time_tag = time_tag;
+    g_epoch.open = 1;
+    g_epoch.published = 0;
+    g_epoch.updated = 0;
+    g_rx_stats.epochs++;
+    atk_mo1218_satdb_epoch_begin();
+}
+
+/**
+ * @brief       检查带UTC时间的消息是否属于正在组装的历元，不属于则开始新的历元
+ * @param       utc_time: 消息中的UTC时间
+ * @retval      无
+ */
+static void atk_mo1218_epoch_check_time(atk_mo1218_utc_time_t *utc_time)
+{
+    uint32_t time_tag;
+    
+    time_tag = (((uint32_t)utc_time->hour * 60 + utc_time->minute) * 60 + utc_time->second) * 1000 + utc_time->millisecond;
+    if ((g_epoch.open == 0) || (time_tag != g_epoch.time_tag))
+    {
+        atk_mo1218_epoch_start(time_tag);
+    }
+}
+
+/**
+ * @brief       将一条GSA消息的定位卫星合并到定位信息
+ * @note        同一卫星只保存一次，卫星编号超出satellite_id的容量时仍记录到定位卫星位图
+ * @param       fix_info: 定位信息
+ *              talker  : GSA消息的发送者
+ *              gsa     : 解析后的GSA消息
+ * @retval      无
+ */
+static void atk_mo1218_epoch_gsa_merge(atk_mo1218_fix_info_t *fix_info, atk_mo1218_nmea_talker_t talker, const atk_mo1218_nmea_gsa_msg_t *gsa)
+{
+    uint8_t satellite_index;
+    atk_mo1218_satdb_constellation_t constellation;
+    uint8_t prn;
+    uint32_t *word;
+    uint32_t bit;
+    
+    for (satellite_index=0; satellite_index<12; satellite_index++)
+    {
+        if (atk_mo1218_satdb_get_prn(talker, gsa->satellite_id[satellite_index], &constellation, &prn) != ATK_MO1218_EOK)
+        {
+            continue;
+        }
+        
+        word = &fix_info->satellite_used[constellation][(prn - 1) >> 5];
+        bit = 1UL << ((prn - 1) & 0x1F);
+        if ((*word & bit) != 0)
+        {
+            continue;
+        }
+        *word |= bit;
+        
+        if (fix_info->satellite_id_num < ATK_MO1218_FIX_SATELLITE_MAX)
+        {
+            fix_info->satellite_id[fix_info->satellite_id_num++] = gsa->satellite_id[satellite_index];
+        }
+    }
+}
+
+/**
+ * @brief       获取定位历元使用的NMEA消息字段
+ * @note        未使用的字段不解析，也不会因为为空导致整条消息被丢弃
+ * @param       nmea: NMEA消息类型
+ * @retval      需要解析的字段掩码
+ */
+static uint32_t atk_mo1218_epoch_fields(atk_mo1218_nmea_msg_t nmea)
+{
+    switch (nmea)
+    {
+        case ATK_MO1218_NMEA_MSG_GGA:
+        {
+            return ATK_MO1218_NMEA_GGA_UTC_TIME | ATK_MO1218_NMEA_GGA_GPS_QUALITY | ATK_MO1218_NMEA_GGA_SATELLITE_NUM | ATK_MO1218_NMEA_GGA_ALTITUDE;
+        }
+        case ATK_MO1218_NMEA_MSG_GSA:
+        {
+            return ATK_MO1218_NMEA_GSA_TYPE | ATK_MO1218_NMEA_GSA_SATELLITE_ID | ATK_MO1218_NMEA_GSA_PDOP | ATK_MO1218_NMEA_GSA_HDOP | ATK_MO1218_NMEA_GSA_VDOP;
+        }
+        case ATK_MO1218_NMEA_MSG_RMC:
+        {
+            return ATK_MO1218_NMEA_RMC_UTC_TIME | ATK_MO1218_NMEA_RMC_STATUS | ATK_MO1218_NMEA_RMC_LATITUDE | ATK_MO1218_NMEA_RMC_LONGITUDE | ATK_MO1218_NMEA_RMC_UTC_DATE;
+        }
+        case ATK_MO1218_NMEA_MSG_VTG:
+        {
+            return ATK_MO1218_NMEA_VTG_COURSE_TRUE | ATK_MO1218_NMEA_VTG_SPEED_KPH;
+        }
+        case ATK_MO1218_NMEA_MSG_GLL:
+        {
+            return ATK_MO1218_NMEA_GLL_UTC_TIME;
+        }
+        case ATK_MO1218_NMEA_MSG_ZDA:
+        {
+            return ATK_MO1218_NMEA_ZDA_UTC_TIME;
+        }
+        case ATK_MO1218_NMEA_MSG_GNS:
+        {
+            return ATK_MO1218_NMEA_GNS_UTC_TIME | ATK_MO1218_NMEA_GNS_LATITUDE | ATK_MO1218_NMEA_GNS_LONGITUDE | ATK_MO1218_NMEA_GNS_SATELLITE_NUM | ATK_MO1218_NMEA_GNS_ALTITUDE;
+        }
+        case ATK_MO1218_NMEA_MSG_GRS:
+        {
+            return ATK_MO1218_NMEA_GRS_UTC_TIME;
+        }
+        default:
+        {
+            return ATK_MO1218_NMEA_FIELD_ALL;
+        }
+    }
+}
+
+/**
+ * @brief       将一条解析后的NMEA消息加入定位历元
+ * @param       sentence: NMEA消息
+ * @retval      无
+ */
+static void atk_mo1218_epoch_input(uint8_t *sentence)
+{
+    atk_mo1218_nmea_talker_t talker;
+    atk_mo1218_nmea_msg_t nmea;
+    atk_mo1218_nmea_decode_msg_t msg;
+    atk_mo1218_nmea_gsv_part_t gsv_part;
+    atk_mo1218_fix_t *fix = &g_epoch.fix;
+    atk_mo1218_visible_satellite_info_t *satellite_info;
+    atk_mo1218_gsv_assembler_t *assembler;
+    atk_mo1218_satdb_constellation_t constellation;
+    uint32_t required;
+    
+    if (atk_mo1218_get_nmea_msg_type(&sentence[1], &talker, &nmea) != ATK_MO1218_EOK)
+    {
+        return;
+    }
+    
+    /* GSV消息逐条解析并组装，收齐一组后再加入定位历元 */
+    if (nmea == ATK_MO1218_NMEA_MSG_GSV)
+    {
+        if (atk_mo1218_satdb_get_constellation(talker, &constellation) != ATK_MO1218_EOK)
+        {
+            return;
+        }
+        assembler = &g_gsv_assembler[constellation];
+        satellite_info = &fix->satellite_info[constellation];
+        
+        if ((atk_mo1218_decode_nmea_xxgsv_part(sentence, &gsv_part) != ATK_MO1218_EOK) ||
+            (atk_mo1218_gsv_assemble(assembler, &gsv_part) != ATK_MO1218_EOK))
+        {
+            return;
+        }
+        
+        atk_mo1218_satdb_gsv_input(talker, assembler->table, assembler->satellite_num);
+        
+        satellite_info->satellite_view = assembler->satellite_view;
+        satellite_info->satellite_num = assembler->satellite_num;
+        memcpy(satellite_info->satellite_info, assembler->table, assembler->satellite_num * sizeof(atk_mo1218_satellite_info_t));
+    }
+    else
+    {
+        if (atk_mo1218_decode_nmea_msg_fields(sentence, atk_mo1218_epoch_fields(nmea), &talker, &nmea, &msg) != ATK_MO1218_EOK)
+        {
+            return;
+        }
+        
+        switch (nmea)
+        {
+            case ATK_MO1218_NMEA_MSG_GGA:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_GNGGA, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
-                {
-                    ret = atk_mo1218_decode_nmea_xxgga(nmea, &gngga.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        gngga.done = ~0;
-                        if (altitude != NULL)
-                        {
-                            *altitude = gngga.msg.altitude;
-                        }
-                        if (fix_info != NULL)
-                        {
-                            fix_info->quality = gngga.msg.gps_quality;
-                            fix_info->satellite_num = gngga.msg.satellite_num;
-                        }
-                    }
-                }
+                atk_mo1218_epoch_check_time(&msg.gga.utc_time);
+                fix->altitude = msg.gga.altitude;
+                fix->fix_info.quality = msg.gga.gps_quality;
+                fix->fix_info.satellite_num = msg.gga.satellite_num;
+                break;
             }
-            else
+            case ATK_MO1218_NMEA_MSG_GLL:
             {
-                gngga.done = ~0;
+                atk_mo1218_epoch_check_time(&msg.gll.utc_time);
+                break;
             }
-            
-            /* GNGSA */
-            if ((fix_info != NULL) && (gngsa.done == 0))
+            case ATK_MO1218_NMEA_MSG_GSA:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_GNGSA, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
+                /* 模块为每个星座输出一条GSA消息，历元中全部GSA消息的定位卫星合并在一起 */
+                atk_mo1218_satdb_gsa_input(talker, msg.gsa.satellite_id, 12);
+                atk_mo1218_epoch_gsa_merge(&fix->fix_info, talker, &msg.gsa);
+                
+                /* 定位类型和精度因子对各星座相同，只使用历元中的第一条GSA消息 */
+                if ((fix->mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GSA)) != 0)
                 {
-                    ret = atk_mo1218_decode_nmea_xxgsa(nmea, &gngsa.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        gngsa.done = ~0;
-                        fix_info->type = gngsa.msg.type;
-                        for (satellite_index=0; satellite_index<12; satellite_index++)
-                        {
-                            fix_info->satellite_id[satellite_index] = gngsa.msg.satellite_id[satellite_index];
-                        }
-                        fix_info->pdop = gngsa.msg.pdop;
-                        fix_info->hdop = gngsa.msg.hdop;
-                        fix_info->vdop = gngsa.msg.vdop;
-                    }
+                    break;
                 }
+                fix->fix_info.type = msg.gsa.type;
+                fix->fix_info.pdop = msg.gsa.pdop;
+                fix->fix_info.hdop = msg.gsa.hdop;
+                fix->fix_info.vdop = msg.gsa.vdop;
+                break;
             }
-            else
+            case ATK_MO1218_NMEA_MSG_RMC:
             {
-                gngsa.done = ~0;
+                atk_mo1218_epoch_check_time(&msg.rmc.utc_time);
+                fix->utc.year = msg.rmc.utc_date.year;
+                fix->utc.month = msg.rmc.utc_date.month;
+                fix->utc.day = msg.rmc.utc_date.day;
+                fix->utc.hour = msg.rmc.utc_time.hour;
+                fix->utc.minute = msg.rmc.utc_time.minute;
+                fix->utc.second = msg.rmc.utc_time.second;
+                fix->utc.millisecond = msg.rmc.utc_time.millisecond;
+                fix->status = msg.rmc.status;
+                fix->position.latitude = msg.rmc.latitude;
+                fix->position.longitude = msg.rmc.longitude;
+                break;
             }
-            
-            /* GPGSV */
-            if ((gps_satellite_info != NULL) && (gpgsv.done == 0))
+            case ATK_MO1218_NMEA_MSG_VTG:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_GPGSV, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
-                {
-                    ret = atk_mo1218_decode_nmea_xxgsv(nmea, &gpgsv.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        gpgsv.done = ~0;
-                        gps_satellite_info->satellite_num = gpgsv.msg.satellite_view;
-                        for (satellite_index=0; satellite_index<gpgsv.msg.satellite_view; satellite_index++)
-                        {
-                            gps_satellite_info->satellite_info[satellite_index].satellite_id = gpgsv.msg.satellite_info[satellite_index].satellite_id;
-                            gps_satellite_info->satellite_info[satellite_index].elevation = gpgsv.msg.satellite_info[satellite_index].elevation;
-                            gps_satellite_info->satellite_info[satellite_index].azimuth = gpgsv.msg.satellite_info[satellite_index].azimuth;
-                            gps_satellite_info->satellite_info[satellite_index].snr = gpgsv.msg.satellite_info[satellite_index].snr;
-                        }
-                    }
-                }
+                fix->speed = msg.vtg.speed_kph;
+                fix->course = msg.vtg.course_true;
+                break;
             }
-            else
+            case ATK_MO1218_NMEA_MSG_ZDA:
             {
-                gpgsv.done = ~0;
+                atk_mo1218_epoch_check_time(&msg.zda.utc_time);
+                break;
             }
-            
-            /* BDGSV */
-            if ((beidou_satellite_info != NULL) && (bdgsv.done == 0))
+            case ATK_MO1218_NMEA_MSG_GNS:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_BDGSV, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
+                /* GNS与GGA、RMC内容重叠，只在历元中尚未收到GGA、RMC时使用 */
+                atk_mo1218_epoch_check_time(&msg.gns.utc_time);
+                if ((fix->mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GGA)) == 0)
+                {
+                    fix->altitude = msg.gns.altitude;
+                    fix->fix_info.satellite_num = msg.gns.satellite_num;
+                }
+                if (((fix->mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_RMC)) == 0) &&
+                    ((msg.gns.valid & ATK_MO1218_NMEA_GNS_LATITUDE) == ATK_MO1218_NMEA_GNS_LATITUDE) && ((msg.gns.valid & ATK_MO1218_NMEA_GNS_LONGITUDE) == ATK_MO1218_NMEA_GNS_LONGITUDE))
                 {
-                    ret = atk_mo1218_decode_nmea_xxgsv(nmea, &bdgsv.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        bdgsv.done = ~0;
-                        beidou_satellite_info->satellite_num = bdgsv.msg.satellite_view;
-                        for (satellite_index=0; satellite_index<bdgsv.msg.satellite_view; satellite_index++)
-                        {
-                            beidou_satellite_info->satellite_info[satellite_index].satellite_id = bdgsv.msg.satellite_info[satellite_index].satellite_id;
-                            beidou_satellite_info->satellite_info[satellite_index].elevation = bdgsv.msg.satellite_info[satellite_index].elevation;
-                            beidou_satellite_info->satellite_info[satellite_index].azimuth = bdgsv.msg.satellite_info[satellite_index].azimuth;
-                            beidou_satellite_info->satellite_info[satellite_index].snr = bdgsv.msg.satellite_info[satellite_index].snr;
-                        }
-                    }
+                    fix->position.latitude = msg.gns.latitude;
+                    fix->position.longitude = msg.gns.longitude;
                 }
+                break;
             }
-            else
+            case ATK_MO1218_NMEA_MSG_GBS:
             {
-                bdgsv.done = ~0;
+                atk_mo1218_epoch_check_time(&msg.gbs.utc_time);
+                fix->integrity = msg.gbs;
+                break;
             }
-            
-            /* GNRMC */
-            if (((utc != NULL) || (position != NULL)) && (gnrmc.done == 0))
+            case ATK_MO1218_NMEA_MSG_GRS:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_GNRMC, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
-                {
-                    ret = atk_mo1218_decode_nmea_xxrmc(nmea, &gnrmc.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        gnrmc.done = ~0;
-                        if (utc != NULL)
-                        {
-                            utc->year = gnrmc.msg.utc_date.year;
-                            utc->month = gnrmc.msg.utc_date.month;
-                            utc->day = gnrmc.msg.utc_date.day;
-                            utc->hour = gnrmc.msg.utc_time.hour;
-                            utc->minute = gnrmc.msg.utc_time.minute;
-                            utc->second = gnrmc.msg.utc_time.second;
-                            utc->millisecond = gnrmc.msg.utc_time.millisecond;
-                        }
-                        if (position != NULL)
-                        {
-                            position->latitude.degree = gnrmc.msg.latitude.degree;
-                            position->latitude.indicator = gnrmc.msg.latitude.indicator;
-                            position->longitude.degree = gnrmc.msg.longitude.degree;
-                            position->longitude.indicator = gnrmc.msg.longitude.indicator;
-                        }
-                    }
-                }
+                atk_mo1218_epoch_check_time(&msg.grs.utc_time);
+                break;
             }
-            else
+            case ATK_MO1218_NMEA_MSG_DTM:
             {
-                gnrmc.done = ~0;
+                /* DTM不带UTC时间，属于正在组装的历元 */
+                fix->datum = msg.dtm;
+                break;
             }
-            
-            /* GNVTG */
-            if ((speed != NULL) && (gnvtg.done == 0))
+            case ATK_MO1218_NMEA_MSG_GST:
             {
-                ret = atk_mo1218_get_nmea_msg_from_buf(buf, ATK_MO1218_NMEA_MSG_GNVTG, 0, &nmea);
-                if (ret == ATK_MO1218_EOK)
-                {
-                    gnvtg.done = ~0;
-                    ret = atk_mo1218_decode_nmea_xxvtg(nmea, &gnvtg.msg);
-                    if (ret == ATK_MO1218_EOK)
-                    {
-                        *speed = gnvtg.msg.speed_kph;
-                    }
-                }
+                atk_mo1218_epoch_check_time(&msg.gst.utc_time);
+                fix->accuracy = msg.gst;
+                break;
             }
-            else
+            default:
             {
-                gnvtg.done = ~0;
+                return;
             }
         }
+    }
+    
+    fix->mask |= ATK_MO1218_NMEA_MSG_MASK(nmea);
+    
+    /* 发布后收到的消息（如ZDA、GST、GBS）在下一个历元开始时随本历元再次发布 */
+    if (g_epoch.published != 0)
+    {
+        g_epoch.updated = 1;
+        return;
+    }
+    
+    /* 收齐所需的消息后立即发布，不必等待下一个历元 */
+    required = (g_epoch.required != 0) ? g_epoch.required : ATK_MO1218_EPOCH_REQUIRED_DEFAULT;
+    if ((fix->mask & required) == required)
+    {
+        atk_mo1218_epoch_publish();
+    }
+}
+
+/**
+ * @brief       将GPS周数和周内时间转换为UTC时间
+ * @param       gps_week: GPS周数
+ *              tow     : GPS周内时间，单位：0.01秒
+ *              utc     : UTC时间
+ * @retval      无
+ */
+static void atk_mo1218_gps_time_to_utc(uint16_t gps_week, uint32_t tow, atk_mo1218_time_t *utc)
+{
+    uint32_t seconds;
+    uint32_t days;
+    uint32_t era;
+    uint32_t doe;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t mp;
+    uint32_t year;
+    uint32_t month;
+    
+    seconds = (uint32_t)gps_week * 604800 + tow / 100 - ATK_MO1218_GPS_UTC_LEAP_SECONDS;
+    utc->millisecond = (uint16_t)((tow % 100) * 10);
+    utc->hour = (uint8_t)((seconds % 86400) / 3600);
+    utc->minute = (uint8_t)((seconds % 3600) / 60);
+    utc->second = (uint8_t)(seconds % 60);
+    
+    /* 由1970-01-01起的天数计算公历日期 */
+    days = seconds / 86400 + ATK_MO1218_GPS_EPOCH_DAYS + 719468;
+    era = days / 146097;
+    doe = days - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    month = (mp < 10) ? (mp + 3) : (mp - 9);
+    year = yoe + era * 400 + ((month <= 2) ? 1 : 0);
+    
+    utc->year = (uint16_t)year;
+    utc->month = (uint8_t)month;
+    utc->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+}
+
+/**
+ * @brief       将导航数据消息加入定位历元
+ * @note        一条导航数据消息即为完整的定位历元，收到后立即发布，
+ *              地面速度和航向由ECEF速度换算得到，
+ *              由atk_mo1218_process()在收到导航数据消息时调用
+ * @param       nav_data: 导航数据
+ * @retval      无
+ */
+void atk_mo1218_nav_data_input(const atk_mo1218_nav_data_t *nav_data)
+{
+    atk_mo1218_fix_t *fix = &g_epoch.fix;
+    float sin_lat;
+    float cos_lat;
+    float sin_lon;
+    float cos_lon;
+    float ve;
+    float vn;
+    float course;
+    
+    /* 阻塞等待Binary命令期间不组装定位历元，不调用回调函数 */
+    if ((nav_data == NULL) || (g_process_state == ATK_MO1218_PROCESS_BIN))
+    {
+        return;
+    }
+    
+    atk_mo1218_epoch_start((nav_data->tow % 8640000) * 10);
+    
+    atk_mo1218_gps_time_to_utc(nav_data->gps_week, nav_data->tow, &fix->utc);
+    fix->status = (nav_data->fix_mode != ATK_MO1218_NAV_FIX_NONE) ? ATK_MO1218_NAVIGATION_VALID : ATK_MO1218_NAVIGATION_WARNING;
+    fix->position.latitude.indicator = (nav_data->latitude >= 0) ? ATK_MO1218_LATITUDE_NORTH : ATK_MO1218_LATITUDE_SOUTH;
+    fix->position.latitude.degree = (uint32_t)((nav_data->latitude >= 0) ? nav_data->latitude : -nav_data->latitude) / 100;
+    fix->position.longitude.indicator = (nav_data->longitude >= 0) ? ATK_MO1218_LONGITUDE_EAST : ATK_MO1218_LONGITUDE_WEST;
+    fix->position.longitude.degree = (uint32_t)((nav_data->longitude >= 0) ? nav_data->longitude : -nav_data->longitude) / 100;
+    fix->altitude = nav_data->msl_altitude / 10;
+    
+    switch (nav_data->fix_mode)
+    {
+        case ATK_MO1218_NAV_FIX_2D:
+        {
+            fix->fix_info.quality = ATK_MO1218_GPS_VALID_SPS;
+            fix->fix_info.type = ATK_MO1218_FIX_2D;
+            break;
+        }
+        case ATK_MO1218_NAV_FIX_3D:
+        {
+            fix->fix_info.quality = ATK_MO1218_GPS_VALID_SPS;
+            fix->fix_info.type = ATK_MO1218_FIX_3D;
+            break;
+        }
+        case ATK_MO1218_NAV_FIX_3D_DGNSS:
+        {
+            fix->fix_info.quality = ATK_MO1218_GPS_VALID_DIFFERENTIAL;
+            fix->fix_info.type = ATK_MO1218_FIX_3D;
+            break;
+        }
+        default:
+        {
+            fix->fix_info.quality = ATK_MO1218_GPS_UNAVAILABLE;
+            fix->fix_info.type = ATK_MO1218_FIX_NOT_AVAILABLE;
+            break;
+        }
+    }
+    fix->fix_info.satellite_num = nav_data->satellite_num;
+    fix->fix_info.pdop = nav_data->pdop / 10;
+    fix->fix_info.hdop = nav_data->hdop / 10;
+    fix->fix_info.vdop = nav_data->vdop / 10;
+    
+    /* ECEF速度转换为当地东向、北向速度 */
+    sin_lat = sinf((float)nav_data->latitude * (3.14159265f / 1800000000.0f));
+    cos_lat = cosf((float)nav_data->latitude * (3.14159265f / 1800000000.0f));
+    sin_lon = sinf((float)nav_data->longitude * (3.14159265f / 1800000000.0f));
+    cos_lon = cosf((float)nav_data->longitude * (3.14159265f / 1800000000.0f));
+    ve = -sin_lon * nav_data->ecef_vx + cos_lon * nav_data->ecef_vy;
+    vn = -sin_lat * cos_lon * nav_data->ecef_vx - sin_lat * sin_lon * nav_data->ecef_vy + cos_lat * nav_data->ecef_vz;
+    
+    /* 厘米/秒转换为千米/时（扩大10倍） */
+    fix->speed = (uint16_t)(sqrtf(ve * ve + vn * vn) * 0.36f + 0.5f);
+    course = atan2f(ve, vn) * (1800.0f / 3.14159265f);
+    if (course < 0)
+    {
+        course += 3600.0f;
+    }
+    fix->course = (uint16_t)(course + 0.5f) % 3600;
+    
+    fix->nav_data = *nav_data;
+    fix->mask |= ATK_MO1218_FIX_MASK_NAV_DATA;
+    
+    atk_mo1218_epoch_publish();
+}
+
+/**
+ * @brief       处理接收到的NMEA消息并组装定位历元，执行异步Binary命令
+ * @note        在主循环中调用，不阻塞；
+ *              历元完成时调用回调函数，并可通过atk_mo1218_get_fix()获取；
+ *              异步Binary命令完成时调用其回调函数；
+ *              在回调函数中调用时直接返回，不重入
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_process(void)
+{
+    uint8_t *sentence;
+    
+    if (g_process_state != ATK_MO1218_PROCESS_IDLE)
+    {
+        return;
+    }
+    g_process_state = ATK_MO1218_PROCESS_ALL;
+    
+    while ((sentence = atk_mo1218_get_nmea_sentence()) != NULL)
+    {
+        atk_mo1218_epoch_input(sentence);
+    }
+    
+    atk_mo1218_bin_cmd_poll();
+    
+    g_process_state = ATK_MO1218_PROCESS_IDLE;
+}
+
+/**
+ * @brief       只提取Binary Message并执行异步Binary命令
+ * @note        供阻塞等待Binary命令完成的函数循环调用，
+ *              期间收到的NMEA消息和导航数据消息直接丢弃，不组装定位历元，也不调用历元完成回调函数；
+ *              在atk_mo1218_process()的回调函数中调用时返回错误，不重入
+ * @param       无
+ * @retval      ATK_MO1218_EOK  : 处理成功
+ *              ATK_MO1218_ERROR: 正在处理接收数据（在回调函数中调用）
+ */
+uint8_t atk_mo1218_process_bin(void)
+{
+    if (g_process_state != ATK_MO1218_PROCESS_IDLE)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    g_process_state = ATK_MO1218_PROCESS_BIN;
+    
+    while (atk_mo1218_get_nmea_sentence() != NULL)
+    {
+        /* 丢弃NMEA消息 */
+    }
+    
+    atk_mo1218_bin_cmd_poll();
+    
+    g_process_state = ATK_MO1218_PROCESS_IDLE;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       设置定位历元的完成条件
+ * @param       required: 历元完成所需的NMEA消息类型，见ATK_MO1218_NMEA_MSG_MASK()，
+ *                        为0时使用ATK_MO1218_EPOCH_REQUIRED_DEFAULT
+ * @retval      无
+ */
+void atk_mo1218_set_epoch_required(uint32_t required)
+{
+    g_epoch.required = required;
+}
+
+/**
+ * @brief       设置定位历元完成回调函数
+ * @note        回调函数在atk_mo1218_process()中调用；
+ *              历元收齐所需的消息时回调一次，发布后收到的消息在下一个历元开始时随该历元再次回调，
+ *              再次回调时republished为1，只需处理后到的数据，避免重复处理整个历元
+ * @param       callback: 回调函数，为NULL时不回调
+ * @retval      无
+ */
+void atk_mo1218_set_fix_callback(atk_mo1218_fix_callback_t callback)
+{
+    g_epoch.callback = callback;
+}
+
+/**
+ * @brief       获取最近完成的定位历元
+ * @note        取出全部未读取的定位历元完成事件，有事件时返回最近一个已完成的历元
+ * @param       fix: 定位历元
+ * @retval      ATK_MO1218_EOK     : 获取到新的定位历元
+ *              ATK_MO1218_ERROR   : 上次获取后没有新的定位历元
+ *              ATK_MO1218_ETIMEOUT: 定位历元正在写入（在打断写入方的中断中读取），事件保留到下次获取
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ */
+uint8_t atk_mo1218_get_fix(atk_mo1218_fix_t *fix)
+{
+    uint8_t ret;
+    
+    if (fix == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (spsc_queue_count(&g_fix_event_queue) == 0)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    ret = atk_mo1218_fix_snapshot_read(fix);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ret;
+    }
+    
+    spsc_queue_flush(&g_fix_event_queue);
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       查询卫星是否用于定位
+ * @param       fix_info     : 定位信息
+ *              constellation: 星座
+ *              prn          : PRN
+ * @retval      0: 未用于定位或参数错误
+ *              1: 用于定位
+ */
+uint8_t atk_mo1218_fix_satellite_used(const atk_mo1218_fix_info_t *fix_info, atk_mo1218_satdb_constellation_t constellation, uint8_t prn)
+{
+    if ((fix_info == NULL) || (constellation >= ATK_MO1218_SATDB_CONSTELLATION_NUM) || (prn == 0) || (prn > (ATK_MO1218_FIX_PRN_WORDS * 32)))
+    {
+        return 0;
+    }
+    
+    return (uint8_t)((fix_info->satellite_used[constellation][(prn - 1) >> 5] >> ((prn - 1) & 0x1F)) & 1);
+}
+
+/**
+ * @brief       获取定位历元完成事件
+ * @note        与atk_mo1218_get_fix()共用事件队列，同一应用中只使用其中一种方式读取
+ * @param       event: 定位历元完成事件
+ * @retval      ATK_MO1218_EOK   : 获取到定位历元完成事件
+ *              ATK_MO1218_ERROR : 没有未读取的定位历元完成事件
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_fix_event(atk_mo1218_fix_event_t *event)
+{
+    if (event == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (spsc_queue_pop(&g_fix_event_queue, event) != SPSC_QUEUE_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取定位历元完成事件队列统计
+ * @param       stats: 队列统计，overflow为读取方未及时读取而丢弃的事件数
+ * @retval      ATK_MO1218_EOK   : 获取成功
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_fix_event_stats(spsc_queue_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    spsc_queue_get_stats(&g_fix_event_queue, stats);
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取最近发布的定位历元
+ * @note        与atk_mo1218_get_fix()不同，不取出定位历元完成事件，可供多个模块（包括中断）读取，
+ *              每次读到的都是同一个历元的完整数据
+ * @param       fix: 定位历元
+ * @retval      ATK_MO1218_EOK     : 获取成功
+ *              ATK_MO1218_ERROR   : 尚未发布过定位历元
+ *              ATK_MO1218_ETIMEOUT: 定位历元正在写入（在打断写入方的中断中读取），稍后重新获取
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ */
+uint8_t atk_mo1218_get_last_fix(atk_mo1218_fix_t *fix)
+{
+    uint8_t ret;
+    
+    if (fix == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    ret = atk_mo1218_fix_snapshot_read(fix);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ret;
+    }
+    
+    if (fix->mask == 0)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取最近发布的定位历元中的时间和位置
+ * @note        与atk_mo1218_get_last_fix()相同，可供多个模块（包括中断）读取，
+ *              只拷贝时间和位置，无需为整个定位历元准备缓冲
+ * @param       position: 定位历元中的时间和位置
+ * @retval      ATK_MO1218_EOK     : 获取成功
+ *              ATK_MO1218_ERROR   : 尚未发布过定位历元
+ *              ATK_MO1218_ETIMEOUT: 定位历元正在写入（在打断写入方的中断中读取），稍后重新获取
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ */
+uint8_t atk_mo1218_get_last_position(atk_mo1218_fix_position_t *position)
+{
+    uint8_t retry;
+    uint32_t seq;
+    uint32_t mask;
+    
+    if (position == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    /* 与atk_mo1218_fix_snapshot_read()相同的顺序锁读取 */
+    for (retry = 0; retry < ATK_MO1218_FIX_SNAPSHOT_RETRY; retry++)
+    {
+        seq = g_epoch.ready_seq;
+        if ((seq & 1) != 0)
+        {
+            continue;
+        }
+        
+        __DMB();
+        mask = g_epoch.ready.mask;
+        position->utc = g_epoch.ready.utc;
+        position->status = g_epoch.ready.status;
+        position->position = g_epoch.ready.position;
+        position->altitude = g_epoch.ready.altitude;
+        __DMB();
         
-        if ((gngga.done != 0) && (gngsa.done != 0) && (gpgsv.done != 0) && (bdgsv.done != 0) && (gnrmc.done != 0) && (gnvtg.done != 0))
+        if (g_epoch.ready_seq == seq)
         {
-            return ATK_MO1218_EOK;
+            return (mask != 0) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+        }
+    }
+    
+    return ATK_MO1218_ETIMEOUT;
+}
+
+/**
+ * @brief       获取RTC的当前UTC时间
+ * @note        弱定义，板上有RTC时由应用重新实现，
+ *              用于上电后尚未定位时估计当前时间
+ * @param       utc: 当前UTC时间
+ * @retval      ATK_MO1218_EOK  : 获取成功
+ *              ATK_MO1218_ERROR: 没有可用的RTC
+ */
+__weak uint8_t atk_mo1218_rtc_get_time(atk_mo1218_time_t *utc)
+{
+    (void)utc;
+    
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       获取并更新ATK-MO1218模块数据
+ * @note        阻塞等待一个包含所需数据的定位历元，
+ *              不阻塞的用法见atk_mo1218_process()和atk_mo1218_set_fix_callback()
+ * @param       utc                  : UTC时间
+ *              position             : 位置信息（经纬度扩大100000倍）
+ *              altitude             : 海拔高度（扩大10倍），单位：米
+ *              speed                : 地面速度（扩大10倍），单位：千米/时
+ *              fix_info             : 定位信息
+ *              gps_satellite_info   : 可见GPS卫星信息
+ *              beidou_satellite_info: 可见北斗卫星信息
+ *              timeout              : 等待超时时间，单位：1毫秒
+ * @retval      ATK_MO1218_EOK     : 获取并更新ATK-MO1218模块数据成功
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ *              ATK_MO1218_ETIMEOUT: 等待超时
+ */
+uint8_t atk_mo1218_update(atk_mo1218_time_t *utc, atk_mo1218_position_t *position, int16_t *altitude, uint16_t *speed, atk_mo1218_fix_info_t *fix_info, atk_mo1218_visible_satellite_info_t *gps_satellite_info, atk_mo1218_visible_satellite_info_t *beidou_satellite_info, uint32_t timeout)
+{
+    static atk_mo1218_fix_t fix;                /* 定位历元较大，不放在栈上 */
+    uint32_t mask = 0;
+    uint32_t start;
+    
+    if ((utc == NULL) && (position == NULL) && (altitude == NULL) && (speed == NULL) && (fix_info == NULL) && (gps_satellite_info == NULL) && (beidou_satellite_info == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    /* 所需的NMEA消息 */
+    if ((utc != NULL) || (position != NULL))
+    {
+        mask |= ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_RMC);
+    }
+    if ((altitude != NULL) || (fix_info != NULL))
+    {
+        mask |= ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GGA);
+    }
+    if (fix_info != NULL)
+    {
+        mask |= ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GSA);
+    }
+    if (speed != NULL)
+    {
+        mask |= ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_VTG);
+    }
+    if ((gps_satellite_info != NULL) || (beidou_satellite_info != NULL))
+    {
+        mask |= ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GSV);
+    }
+    
+    start = HAL_GetTick();
+    while ((HAL_GetTick() - start) < timeout)
+    {
+        atk_mo1218_process();
+        if (atk_mo1218_get_fix(&fix) != ATK_MO1218_EOK)
+        {
+            continue;
+        }
+        
+        /* 导航数据消息包含GGA、GSA、RMC、VTG中的数据 */
+        if ((fix.mask & ATK_MO1218_FIX_MASK_NAV_DATA) != 0)
+        {
+            fix.mask |= ATK_MO1218_EPOCH_REQUIRED_DEFAULT;
+        }
+        if ((fix.mask & mask) != mask)
+        {
+            continue;
+        }
+        
+        if (utc != NULL)
+        {
+            *utc = fix.utc;
+        }
+        if (position != NULL)
+        {
+            *position = fix.position;
+        }
+        if (altitude != NULL)
+        {
+            *altitude = (int16_t)fix.altitude;
+        }
+        if (speed != NULL)
+        {
+            *speed = fix.speed;
+        }
+        if (fix_info != NULL)
+        {
+            *fix_info = fix.fix_info;
+        }
+        if (gps_satellite_info != NULL)
+        {
+            *gps_satellite_info = fix.satellite_info[ATK_MO1218_SATDB_GPS];
+        }
+        if (beidou_satellite_info != NULL)
+        {
+            *beidou_satellite_info = fix.satellite_info[ATK_MO1218_SATDB_BEIDOU];
         }
         
-        timeout--;
-        delay_ms(1);
+        return ATK_MO1218_EOK;
     }
     
     return ATK_MO1218_ETIMEOUT;
@@ -20,7 +20,7 @@
 
 #include "atk_mo1218_bin_msg.h"
 #include "atk_mo1218.h"
-#include "delay.h"
+#include <string.h>
 
 /* ATK-MO1218模块Binary Message起始和结束序列 */
 #define ATK_MO1218_BIN_MSG_SS       (0xA0A1)    /* Start of Sequence */
@@ -132,15 +132,15 @@ typedef struct
 {
     uint8_t mid;
     uint8_t start_mode;
-    uint16_t utc_year;
+    uint8_t utc_year[2];
     uint8_t utc_month;
     uint8_t utc_day;
     uint8_t utc_hour;
     uint8_t utc_minute;
     uint8_t utc_second;
-    int16_t latitude;
-    int16_t longitude;
-    int16_t altitude;
+    uint8_t latitude[2];
+    uint8_t longitude[2];
+    uint8_t altitude[2];
 } __packed atk_mo1218_mid_01_playload_t;
 
 /* Playload结构体（Message ID = 0x02） */
@@ -609,6 +609,31 @@ typedef struct
     uint8_t rate;
 } __packed atk_mo1218_mid_86_playload_t;
 
+/* Playload结构体（Message ID = 0xA8） */
+typedef struct
+{
+    uint8_t mid;
+    uint8_t fix_mode;
+    uint8_t num_sv;
+    uint8_t gps_week[2];
+    uint8_t tow[4];
+    uint8_t latitude[4];
+    uint8_t longitude[4];
+    uint8_t ellipsoid_altitude[4];
+    uint8_t msl_altitude[4];
+    uint8_t gdop[2];
+    uint8_t pdop[2];
+    uint8_t hdop[2];
+    uint8_t vdop[2];
+    uint8_t tdop[2];
+    uint8_t ecef_x[4];
+    uint8_t ecef_y[4];
+    uint8_t ecef_z[4];
+    uint8_t ecef_vx[4];
+    uint8_t ecef_vy[4];
+    uint8_t ecef_vz[4];
+} __packed atk_mo1218_mid_a8_playload_t;
+
 /* Playload结构体（Message ID = 0xAE） */
 typedef struct
 {
@@ -671,223 +696,967 @@ typedef struct
     uint8_t cable_delay[4];
 } __packed atk_mo1218_mid_bb_playload_t;
 
-/* ACK Messsage的大小 */
-#define ATK_MO1218_BIN_MSG_ACK_LEN (            \
-    ATK_MO1218_BIN_MSG_SS_LEN   +               \
-    ATK_MO1218_BIN_MSG_PL_LEN   +               \
-    sizeof(atk_mo1218_mid_83_playload_t) +      \
-    ATK_MO1218_BIN_MSG_CS_LEN   +               \
-    ATK_MO1218_BIN_MSG_ES_LEN  )
-
-/* 带Sub-ID的ACK Messsage的大小 */
-#define ATK_MO1218_BIN_MSG_ACK_SID_LEN (        \
-    ATK_MO1218_BIN_MSG_SS_LEN   +               \
-    ATK_MO1218_BIN_MSG_PL_LEN   +               \
-    sizeof(atk_mo1218_mid_83_sid_playload_t) +  \
-    ATK_MO1218_BIN_MSG_CS_LEN   +               \
-    ATK_MO1218_BIN_MSG_ES_LEN  )
-
-/**
- * @brief       解析ATK-MO1218模块Binary Message
- * @param       msg: Binary Message
- *              mid: Binary Message解析出的Message ID
- *              mb : Binary Message解析出的Message Body
- *              len: mb的长度
- * @retval      ATK_MO1218_EOK   : 解析成功
- *              ATK_MO1218_ERROR : msg有误
- *              ATK_MO1218_EINVAL: 函数参数错误
+/* ATK-MO1218模块异步Binary命令状态枚举 */
+typedef enum
+{
+    ATK_MO1218_BIN_CMD_IDLE = 0x00,             /* 无正在执行的命令 */
+    ATK_MO1218_BIN_CMD_WAIT_ACK,                /* 已发送，等待ACK/NACK */
+    ATK_MO1218_BIN_CMD_WAIT_RES,                /* 已收到ACK，等待响应消息 */
+} atk_mo1218_bin_cmd_state_t;
+
+/* ATK-MO1218模块异步Binary命令 */
+typedef struct
+{
+    uint8_t msg[ATK_MO1218_BIN_MSG_BUF_SIZE];   /* 已组帧的Binary Message */
+    uint8_t len;                                /* Binary Message长度 */
+    uint8_t res_mid;                            /* 期望的响应Message ID，为0时仅等待ACK */
+    uint8_t res_sid;                            /* 期望的响应Sub-ID，仅命令带Sub-ID时有效 */
+    uint32_t timeout;                           /* 单次等待响应超时时间，单位：1毫秒 */
+    uint8_t retry;                              /* 剩余重发次数 */
+    atk_mo1218_bin_cmd_callback_t callback;     /* 完成回调函数 */
+    void *arg;                                  /* 回调函数用户参数 */
+} atk_mo1218_bin_cmd_t;
+
+/* 阻塞等待异步Binary命令完成的上下文 */
+typedef struct
+{
+    volatile uint8_t done;                      /* 命令已完成 */
+    uint8_t ret;                                /* 命令完成结果 */
+    uint8_t *res;                               /* 响应消息Playload的保存位置 */
+    uint16_t res_len;                           /* 响应消息Playload的保存位置大小 */
+} atk_mo1218_bin_cmd_sync_t;
+
+/* ATK-MO1218模块异步Binary命令队列
+ * 队首为正在执行的命令，同一时间只有一条命令在等待响应，仅在主循环中访问
+ */
+static struct
+{
+    atk_mo1218_bin_cmd_t queue[ATK_MO1218_BIN_CMD_QUEUE_SIZE];
+    uint8_t head;                               /* 队首（正在执行的命令） */
+    uint8_t tail;                               /* 队尾 */
+    atk_mo1218_bin_cmd_state_t state;           /* 队首命令的状态 */
+    uint32_t start;                             /* 队首命令最近一次发送的时间，单位：1毫秒 */
+} g_bin_cmd = {0};
+
+/* ATK-MO1218模块批量配置事务状态枚举 */
+typedef enum
+{
+    ATK_MO1218_BIN_BATCH_IDLE = 0x00,           /* 无事务 */
+    ATK_MO1218_BIN_BATCH_BUILD,                 /* 正在组建，atk_mo1218_send_bin_msg()的消息加入事务 */
+    ATK_MO1218_BIN_BATCH_PENDING,               /* 已提交，等待发送 */
+    ATK_MO1218_BIN_BATCH_WAIT_ACK,              /* 已连续发送，等待ACK/NACK */
+} atk_mo1218_bin_batch_state_t;
+
+/* ATK-MO1218模块批量配置事务中的结果：尚未收到ACK/NACK */
+#define ATK_MO1218_BIN_BATCH_PENDING_RET    0xFF
+
+/* ATK-MO1218模块批量配置事务
+ * 全部消息连续发送，按到达顺序将ACK/NACK关联到第一条Message ID（及Sub-ID）相同且未应答的消息，
+ * 事务提交后异步Binary命令队列暂停发送（只等待正在执行的命令完成），仅在主循环中访问
+ */
+static struct
+{
+    uint8_t buf[ATK_MO1218_BIN_BATCH_BUF_SIZE];         /* 已组帧的Binary Message，依次存放 */
+    uint16_t buf_len;                                   /* buf已使用的长度 */
+    struct
+    {
+        uint16_t offset;                                /* 在buf中的位置 */
+        uint8_t len;                                    /* Binary Message长度 */
+        uint8_t mid;                                    /* Message ID */
+        uint8_t sid;                                    /* Sub-ID，仅消息带Sub-ID时有效 */
+    } item[ATK_MO1218_BIN_BATCH_SIZE];
+    uint8_t ret[ATK_MO1218_BIN_BATCH_SIZE];             /* 每条消息的结果 */
+    uint8_t num;                                        /* 消息数量 */
+    uint8_t pending;                                    /* 未应答的消息数量 */
+    uint8_t retry;                                      /* 剩余重发次数 */
+    atk_mo1218_bin_batch_state_t state;
+    uint32_t start;                                     /* 最近一次发送的时间，单位：1毫秒 */
+    atk_mo1218_bin_batch_callback_t callback;           /* 完成回调函数 */
+    void *arg;                                          /* 回调函数用户参数 */
+} g_bin_batch = {0};
+
+/**
+ * @brief       判断ATK-MO1218模块Binary Message是否带Sub-ID
+ * @param       mid: Message ID
+ * @retval      0: 不带Sub-ID
+ *              1: 带Sub-ID
+ */
+static uint8_t atk_mo1218_bin_msg_has_sid(uint8_t mid)
+{
+    return ((mid >= ATK_MO1218_MID_62) && (mid <= ATK_MO1218_MID_65)) ? 1 : 0;
+}
+
+/**
+ * @brief       将Playload组帧为ATK-MO1218模块Binary Message
+ * @param       playload: Binary Message的Playload
+ *              pl      : Binary Message的Playload Length（playload的长度）
+ *              msg     : 组帧后的Binary Message，大小需不小于ATK_MO1218_BIN_MSG_BUF_SIZE
+ * @retval      组帧后的Binary Message长度，0表示playload过长
  */
-static uint8_t atk_mo1218_decode_bin_msg(uint8_t *msg, uint8_t *mid, uint8_t *mb, uint16_t *len)
+static uint16_t atk_mo1218_encode_bin_msg(uint8_t *playload, uint16_t pl, uint8_t *msg)
 {
-    uint16_t ss;                /* Start of Sequence */
-    uint16_t pl;                /* Playload Length */
-    uint8_t cs;                 /* Checksum */
-    uint16_t es;                /* End of Sequence */
     uint16_t playload_index;
-    uint8_t _cs = 0;
-    uint16_t mb_index;
+    uint8_t cs = 0;
     
-    if (msg == NULL)
+    if (pl > ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN)
     {
-        return ATK_MO1218_EINVAL;
+        return 0;
+    }
+    
+    /* Start of Sequence */
+    msg[0] = (uint8_t)(ATK_MO1218_BIN_MSG_SS >> 8) & 0xFF;
+    msg[1] = (uint8_t)ATK_MO1218_BIN_MSG_SS & 0xFF;
+    /* Playload Length */
+    msg[ATK_MO1218_BIN_MSG_SS_LEN + 0] = (uint8_t)(pl >> 8) & 0xFF;
+    msg[ATK_MO1218_BIN_MSG_SS_LEN + 1] = (uint8_t)pl & 0xFF;
+    /* Playload & Checksum */
+    for (playload_index=0; playload_index<pl; playload_index++)
+    {
+        msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + playload_index] = playload[playload_index];
+        cs ^= playload[playload_index];
+    }
+    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + 0] = cs;
+    /* End of Sequence */
+    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 0] = (uint8_t)(ATK_MO1218_BIN_MSG_ES >> 8) & 0xFF;
+    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 1] = (uint8_t)ATK_MO1218_BIN_MSG_ES & 0xFF;
+    
+    return ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + ATK_MO1218_BIN_MSG_ES_LEN;
+}
+
+/**
+ * @brief       结束队首的异步Binary命令
+ * @note        先出队再回调，回调函数中可以提交新的命令
+ * @param       ret     : 命令完成结果
+ *              playload: 响应消息的Playload
+ *              pl      : 响应消息的Playload Length
+ * @retval      无
+ */
+static void atk_mo1218_bin_cmd_complete(uint8_t ret, const uint8_t *playload, uint16_t pl)
+{
+    atk_mo1218_bin_cmd_callback_t callback;
+    void *arg;
+    
+    callback = g_bin_cmd.queue[g_bin_cmd.head & (ATK_MO1218_BIN_CMD_QUEUE_SIZE - 1)].callback;
+    arg = g_bin_cmd.queue[g_bin_cmd.head & (ATK_MO1218_BIN_CMD_QUEUE_SIZE - 1)].arg;
+    g_bin_cmd.head++;
+    g_bin_cmd.state = ATK_MO1218_BIN_CMD_IDLE;
+    
+    if (callback != NULL)
+    {
+        callback(ret, playload, pl, arg);
+    }
+}
+
+/**
+ * @brief       结束批量配置事务
+ * @note        先结束事务再回调，回调函数中可以组建新的事务
+ * @param       无
+ * @retval      无
+ */
+static void atk_mo1218_bin_batch_complete(void)
+{
+    uint8_t ret[ATK_MO1218_BIN_BATCH_SIZE];
+    uint8_t num;
+    
+    num = g_bin_batch.num;
+    memcpy(ret, g_bin_batch.ret, num);
+    g_bin_batch.state = ATK_MO1218_BIN_BATCH_IDLE;
+    
+    if (g_bin_batch.callback != NULL)
+    {
+        g_bin_batch.callback(ret, num, g_bin_batch.arg);
+    }
+}
+
+/**
+ * @brief       连续发送批量配置事务中未应答的消息
+ * @param       无
+ * @retval      无
+ */
+static void atk_mo1218_bin_batch_send(void)
+{
+    uint8_t item_index;
+    
+    for (item_index=0; item_index<g_bin_batch.num; item_index++)
+    {
+        if (g_bin_batch.ret[item_index] == ATK_MO1218_BIN_BATCH_PENDING_RET)
+        {
+            atk_mo1218_uart_send(&g_bin_batch.buf[g_bin_batch.item[item_index].offset], g_bin_batch.item[item_index].len);
+        }
+    }
+    
+    g_bin_batch.state = ATK_MO1218_BIN_BATCH_WAIT_ACK;
+    g_bin_batch.start = HAL_GetTick();
+}
+
+/**
+ * @brief       将ACK/NACK关联到批量配置事务中的消息
+ * @note        模块按接收顺序应答，因此关联到第一条Message ID（及Sub-ID）相同且未应答的消息
+ * @param       playload: ACK/NACK的Playload
+ *              pl      : ACK/NACK的Playload Length
+ * @retval      无
+ */
+static void atk_mo1218_bin_batch_ack(uint8_t *playload, uint16_t pl)
+{
+    uint8_t item_index;
+    uint8_t has_sid;
+    
+    if (pl < 2)
+    {
+        return;
+    }
+    
+    has_sid = atk_mo1218_bin_msg_has_sid(playload[1]);
+    if (pl < (2 + has_sid))
+    {
+        return;
+    }
+    
+    for (item_index=0; item_index<g_bin_batch.num; item_index++)
+    {
+        if ((g_bin_batch.ret[item_index] != ATK_MO1218_BIN_BATCH_PENDING_RET) || (g_bin_batch.item[item_index].mid != playload[1]))
+        {
+            continue;
+        }
+        if ((has_sid != 0) && (g_bin_batch.item[item_index].sid != playload[2]))
+        {
+            continue;
+        }
+        
+        g_bin_batch.ret[item_index] = (playload[0] == ATK_MO1218_MID_83) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+        g_bin_batch.pending--;
+        if (g_bin_batch.pending == 0)
+        {
+            atk_mo1218_bin_batch_complete();
+        }
+        return;
+    }
+}
+
+/**
+ * @brief       发送批量配置事务并处理超时重发
+ * @param       无
+ * @retval      0: 没有正在执行的事务
+ *              1: 事务正在执行，异步Binary命令队列暂停发送
+ */
+static uint8_t atk_mo1218_bin_batch_poll(void)
+{
+    uint8_t item_index;
+    
+    switch (g_bin_batch.state)
+    {
+        case ATK_MO1218_BIN_BATCH_PENDING:
+        {
+            /* 等待正在执行的命令完成，期间只处理该命令的超时重发，不发送排队中的命令 */
+            if (g_bin_cmd.state != ATK_MO1218_BIN_CMD_IDLE)
+            {
+                return 0;
+            }
+            
+            atk_mo1218_bin_batch_send();
+            return 1;
+        }
+        case ATK_MO1218_BIN_BATCH_WAIT_ACK:
+        {
+            if ((HAL_GetTick() - g_bin_batch.start) < ATK_MO1218_BIN_CMD_TIMEOUT)
+            {
+                return 1;
+            }
+            
+            if (g_bin_batch.retry != 0)
+            {
+                /* 只重发未应答的消息 */
+                g_bin_batch.retry--;
+                atk_mo1218_bin_batch_send();
+                return 1;
+            }
+            
+            for (item_index=0; item_index<g_bin_batch.num; item_index++)
+            {
+                if (g_bin_batch.ret[item_index] == ATK_MO1218_BIN_BATCH_PENDING_RET)
+                {
+                    g_bin_batch.ret[item_index] = ATK_MO1218_ETIMEOUT;
+                }
+            }
+            atk_mo1218_bin_batch_complete();
+            return (g_bin_batch.state == ATK_MO1218_BIN_BATCH_IDLE) ? 0 : 1;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief       处理一条接收到的ATK-MO1218模块Binary Message
+ * @note        导航数据消息送入定位历元组装器，
+ *              其他消息按Message ID（及Sub-ID）与队首命令关联ACK、NACK和响应消息，
+ *              无法关联的消息直接丢弃
+ * @param       playload: Binary Message的Playload
+ *              pl      : Binary Message的Playload Length
+ * @retval      无
+ */
+static void atk_mo1218_bin_msg_dispatch(uint8_t *playload, uint16_t pl)
+{
+    atk_mo1218_bin_cmd_t *cmd;
+    uint8_t mid;
+    uint8_t has_sid;
+    atk_mo1218_nav_data_t nav_data;
+    
+    /* 周期输出的导航数据消息送入定位历元组装器 */
+    if (playload[0] == ATK_MO1218_MID_A8)
+    {
+        if (atk_mo1218_decode_nav_data(playload, pl, &nav_data) == ATK_MO1218_EOK)
+        {
+            atk_mo1218_nav_data_input(&nav_data);
+        }
+        return;
+    }
+    
+    /* 批量配置事务执行期间没有正在执行的命令，ACK/NACK都属于事务 */
+    if (g_bin_batch.state == ATK_MO1218_BIN_BATCH_WAIT_ACK)
+    {
+        if ((playload[0] == ATK_MO1218_MID_83) || (playload[0] == ATK_MO1218_MID_84))
+        {
+            atk_mo1218_bin_batch_ack(playload, pl);
+        }
+        return;
+    }
+    
+    if (g_bin_cmd.state == ATK_MO1218_BIN_CMD_IDLE)
+    {
+        return;
     }
     
-    if ((mid == NULL) && (*mb == NULL) && (len == NULL))
+    cmd = &g_bin_cmd.queue[g_bin_cmd.head & (ATK_MO1218_BIN_CMD_QUEUE_SIZE - 1)];
+    mid = cmd->msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + 0];
+    has_sid = atk_mo1218_bin_msg_has_sid(mid);
+    
+    /* ACK/NACK：Playload为MID(0x83/0x84) + 被响应命令的Message ID（+ Sub-ID） */
+    if ((playload[0] == ATK_MO1218_MID_83) || (playload[0] == ATK_MO1218_MID_84))
+    {
+        if ((g_bin_cmd.state != ATK_MO1218_BIN_CMD_WAIT_ACK) || (pl < (2 + has_sid)) || (playload[1] != mid))
+        {
+            return;
+        }
+        if ((has_sid != 0) && (playload[2] != cmd->msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + 1]))
+        {
+            return;
+        }
+        
+        if (playload[0] == ATK_MO1218_MID_84)
+        {
+            atk_mo1218_bin_cmd_complete(ATK_MO1218_ERROR, NULL, 0);
+        }
+        else if (cmd->res_mid == 0)
+        {
+            atk_mo1218_bin_cmd_complete(ATK_MO1218_EOK, NULL, 0);
+        }
+        else
+        {
+            /* 响应消息紧随ACK之后，重新计时等待 */
+            g_bin_cmd.state = ATK_MO1218_BIN_CMD_WAIT_RES;
+            g_bin_cmd.start = HAL_GetTick();
+        }
+        
+        return;
+    }
+    
+    /* 响应消息 */
+    if ((g_bin_cmd.state != ATK_MO1218_BIN_CMD_WAIT_RES) || (playload[0] != cmd->res_mid))
+    {
+        return;
+    }
+    if ((has_sid != 0) && ((pl < 2) || (playload[1] != cmd->res_sid)))
+    {
+        return;
+    }
+    
+    atk_mo1218_bin_cmd_complete(ATK_MO1218_EOK, playload, pl);
+}
+
+/**
+ * @brief       读取Binary Message中大端序的16位数据
+ * @param       dat: 数据
+ * @retval      16位数据
+ */
+static uint16_t atk_mo1218_bin_msg_get_u16(const uint8_t *dat)
+{
+    return (uint16_t)((dat[0] << 8) | dat[1]);
+}
+
+/**
+ * @brief       读取Binary Message中大端序的32位数据
+ * @param       dat: 数据
+ * @retval      32位数据
+ */
+static uint32_t atk_mo1218_bin_msg_get_u32(const uint8_t *dat)
+{
+    return ((uint32_t)dat[0] << 24) | ((uint32_t)dat[1] << 16) | ((uint32_t)dat[2] << 8) | dat[3];
+}
+
+/**
+ * @brief       解析ATK-MO1218模块导航数据消息（Message ID = 0xA8）
+ * @note        模块配置为输出Binary信息时，按位置更新频率周期输出
+ * @param       playload : Binary Message的Playload
+ *              pl       : Binary Message的Playload Length
+ *              nav_data : 解析后的导航数据
+ * @retval      ATK_MO1218_EOK   : 解析成功
+ *              ATK_MO1218_ERROR : 不是导航数据消息或长度错误
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nav_data(const uint8_t *playload, uint16_t pl, atk_mo1218_nav_data_t *nav_data)
+{
+    const atk_mo1218_mid_a8_playload_t *msg = (const atk_mo1218_mid_a8_playload_t *)playload;
+    
+    if ((playload == NULL) || (nav_data == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* Start of Sequence */
-    ss = (uint16_t)(msg[0] << 8) | msg[1];
-    if (ss != ATK_MO1218_BIN_MSG_SS)
+    if ((pl < sizeof(atk_mo1218_mid_a8_playload_t)) || (msg->mid != ATK_MO1218_MID_A8))
     {
         return ATK_MO1218_ERROR;
     }
     
-    /* Playload Length & End of Sequence */
-    pl = (uint16_t)(msg[ATK_MO1218_BIN_MSG_SS_LEN + 0] << 8) | msg[ATK_MO1218_BIN_MSG_SS_LEN + 1];
-    es = (uint16_t)(msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 0] << 8) | 
-                    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 1];
-    if (es != ATK_MO1218_BIN_MSG_ES)
+    switch (msg->fix_mode)
     {
-        return ATK_MO1218_ERROR;
+        case 0:
+        {
+            nav_data->fix_mode = ATK_MO1218_NAV_FIX_NONE;
+            break;
+        }
+        case 1:
+        {
+            nav_data->fix_mode = ATK_MO1218_NAV_FIX_2D;
+            break;
+        }
+        case 2:
+        {
+            nav_data->fix_mode = ATK_MO1218_NAV_FIX_3D;
+            break;
+        }
+        case 3:
+        {
+            nav_data->fix_mode = ATK_MO1218_NAV_FIX_3D_DGNSS;
+            break;
+        }
+        default:
+        {
+            return ATK_MO1218_ERROR;
+        }
+    }
+    
+    nav_data->satellite_num = msg->num_sv;
+    nav_data->gps_week = atk_mo1218_bin_msg_get_u16(msg->gps_week);
+    nav_data->tow = atk_mo1218_bin_msg_get_u32(msg->tow);
+    nav_data->latitude = (int32_t)atk_mo1218_bin_msg_get_u32(msg->latitude);
+    nav_data->longitude = (int32_t)atk_mo1218_bin_msg_get_u32(msg->longitude);
+    nav_data->ellipsoid_altitude = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ellipsoid_altitude);
+    nav_data->msl_altitude = (int32_t)atk_mo1218_bin_msg_get_u32(msg->msl_altitude);
+    nav_data->gdop = atk_mo1218_bin_msg_get_u16(msg->gdop);
+    nav_data->pdop = atk_mo1218_bin_msg_get_u16(msg->pdop);
+    nav_data->hdop = atk_mo1218_bin_msg_get_u16(msg->hdop);
+    nav_data->vdop = atk_mo1218_bin_msg_get_u16(msg->vdop);
+    nav_data->tdop = atk_mo1218_bin_msg_get_u16(msg->tdop);
+    nav_data->ecef_x = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_x);
+    nav_data->ecef_y = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_y);
+    nav_data->ecef_z = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_z);
+    nav_data->ecef_vx = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_vx);
+    nav_data->ecef_vy = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_vy);
+    nav_data->ecef_vz = (int32_t)atk_mo1218_bin_msg_get_u32(msg->ecef_vz);
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       从UART接收数据中提取一条ATK-MO1218模块Binary Message
+ * @note        block须以Start of Sequence的第一个字节开始，依次校验Start of Sequence、
+ *              Playload Length（不超过ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN）、Checksum和End of Sequence，
+ *              任一项不符时仅跳过第一个字节，以便从其后重新同步；
+ *              帧完整地位于block中时直接在接收缓冲中处理，
+ *              仅跨越环形缓冲末尾的帧才复制到拼接缓冲
+ * @param       block    : 环形缓冲中从读位置开始可连续读取的数据块
+ *              block_len: 数据块的长度
+ * @retval      0   : 帧不完整，需等待后续数据（不释放数据）
+ *              1   : 不是有效的Binary Message，跳过第一个字节
+ *              其他: 有效的Binary Message的长度，已处理
+ */
+uint16_t atk_mo1218_bin_msg_extract(uint8_t *block, uint16_t block_len)
+{
+    static uint8_t msg_buf[ATK_MO1218_BIN_MSG_BUF_SIZE];    /* 跨越环形缓冲末尾的帧的拼接缓冲 */
+    uint8_t *msg = block;
+    uint16_t available;
+    uint16_t pl;
+    uint16_t msg_len;
+    uint16_t playload_index;
+    uint8_t cs = 0;
+    
+    available = atk_mo1218_uart_rx_ring_available();
+    
+    /* Start of Sequence & Playload Length */
+    if (available < (ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN))
+    {
+        return 0;
+    }
+    if (block_len < (ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN))
+    {
+        msg = msg_buf;
+        atk_mo1218_uart_rx_ring_peek(msg, ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN);
+    }
+    if ((((uint16_t)msg[0] << 8) | msg[1]) != ATK_MO1218_BIN_MSG_SS)
+    {
+        return 1;
+    }
+    pl = ((uint16_t)msg[ATK_MO1218_BIN_MSG_SS_LEN + 0] << 8) | msg[ATK_MO1218_BIN_MSG_SS_LEN + 1];
+    if ((pl == 0) || (pl > ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN))
+    {
+        return 1;
+    }
+    
+    /* 等待整帧接收完成 */
+    msg_len = ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + ATK_MO1218_BIN_MSG_ES_LEN;
+    if (available < msg_len)
+    {
+        return 0;
+    }
+    if (block_len < msg_len)
+    {
+        msg = msg_buf;
+        atk_mo1218_uart_rx_ring_peek(msg, msg_len);
     }
     
     /* Checksum */
-    cs = msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + 0];
     for (playload_index=0; playload_index<pl; playload_index++)
     {
-        _cs ^= msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + playload_index];
+        cs ^= msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + playload_index];
     }
-    if (cs != _cs)
+    if (cs != msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl])
+    {
+        return 1;
+    }
+    
+    /* End of Sequence */
+    if ((((uint16_t)msg[msg_len - 2] << 8) | msg[msg_len - 1]) != ATK_MO1218_BIN_MSG_ES)
+    {
+        return 1;
+    }
+    
+    atk_mo1218_bin_msg_dispatch(&msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN], pl);
+    
+    return msg_len;
+}
+
+/**
+ * @brief       提交异步Binary命令
+ * @note        命令按提交顺序逐条执行，由atk_mo1218_bin_cmd_poll()发送和处理超时，
+ *              回调函数在atk_mo1218_process()中调用
+ * @param       playload: Binary Message的Playload（提交时复制，调用后可释放）
+ *              pl      : Binary Message的Playload Length（playload的长度）
+ *              res_mid : 期望的响应Message ID，为0时收到ACK即完成
+ *              res_sid : 期望的响应Sub-ID，仅命令带Sub-ID时有效
+ *              timeout : 单次等待响应超时时间，单位：1毫秒，为0时发送后即完成
+ *              retry   : 超时重发次数
+ *              callback: 完成回调函数，可以为NULL
+ *              arg     : 回调函数用户参数
+ * @retval      ATK_MO1218_EOK   : 提交成功
+ *              ATK_MO1218_ERROR : 命令队列已满
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_bin_cmd_submit(uint8_t *playload, uint16_t pl, uint8_t res_mid, uint8_t res_sid, uint32_t timeout, uint8_t retry, atk_mo1218_bin_cmd_callback_t callback, void *arg)
+{
+    atk_mo1218_bin_cmd_t *cmd;
+    
+    if ((playload == NULL) || (pl == 0) || (pl > ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if ((uint8_t)(g_bin_cmd.tail - g_bin_cmd.head) >= ATK_MO1218_BIN_CMD_QUEUE_SIZE)
     {
         return ATK_MO1218_ERROR;
     }
     
-    /* Playload(Message ID) */
-    if (mid != NULL)
+    cmd = &g_bin_cmd.queue[g_bin_cmd.tail & (ATK_MO1218_BIN_CMD_QUEUE_SIZE - 1)];
+    cmd->len = (uint8_t)atk_mo1218_encode_bin_msg(playload, pl, cmd->msg);
+    cmd->res_mid = res_mid;
+    cmd->res_sid = res_sid;
+    cmd->timeout = timeout;
+    cmd->retry = retry;
+    cmd->callback = callback;
+    cmd->arg = arg;
+    g_bin_cmd.tail++;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       发送排队的异步Binary命令并处理超时重发
+ * @note        在主循环中调用，不阻塞（已由atk_mo1218_process()和atk_mo1218_process_bin()调用）
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_bin_cmd_poll(void)
+{
+    atk_mo1218_bin_cmd_t *cmd;
+    
+    if (atk_mo1218_bin_batch_poll() != 0)
     {
-        *mid = msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + 0];
+        return;
     }
     
-    /* Playload(Message Body) */
-    if (mb != NULL)
+    while (g_bin_cmd.head != g_bin_cmd.tail)
     {
-        for (mb_index=0; mb_index<(pl-sizeof(*mid)); mb_index++)
+        cmd = &g_bin_cmd.queue[g_bin_cmd.head & (ATK_MO1218_BIN_CMD_QUEUE_SIZE - 1)];
+        
+        if (g_bin_cmd.state == ATK_MO1218_BIN_CMD_IDLE)
         {
-            mb[mb_index] = msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + sizeof(*mid) + mb_index];
+            /* 已提交的批量配置事务优先于排队中的命令 */
+            if (g_bin_batch.state == ATK_MO1218_BIN_BATCH_PENDING)
+            {
+                atk_mo1218_bin_batch_send();
+                break;
+            }
+            
+            /* 发送队首命令 */
+            atk_mo1218_uart_send(cmd->msg, cmd->len);
+            if (cmd->timeout == 0)
+            {
+                atk_mo1218_bin_cmd_complete(ATK_MO1218_EOK, NULL, 0);
+                continue;
+            }
+            g_bin_cmd.state = ATK_MO1218_BIN_CMD_WAIT_ACK;
+            g_bin_cmd.start = HAL_GetTick();
+            break;
         }
+        
+        if ((HAL_GetTick() - g_bin_cmd.start) < cmd->timeout)
+        {
+            break;
+        }
+        
+        if (cmd->retry == 0)
+        {
+            atk_mo1218_bin_cmd_complete(ATK_MO1218_ETIMEOUT, NULL, 0);
+            continue;
+        }
+        
+        /* 超时重发 */
+        cmd->retry--;
+        atk_mo1218_uart_send(cmd->msg, cmd->len);
+        g_bin_cmd.state = ATK_MO1218_BIN_CMD_WAIT_ACK;
+        g_bin_cmd.start = HAL_GetTick();
+        break;
     }
+}
+
+/**
+ * @brief       获取未完成（排队中及正在执行）的异步Binary命令数量
+ * @param       无
+ * @retval      未完成的异步Binary命令数量
+ */
+uint8_t atk_mo1218_bin_cmd_pending(void)
+{
+    return (uint8_t)(g_bin_cmd.tail - g_bin_cmd.head);
+}
+
+/**
+ * @brief       阻塞等待异步Binary命令完成的回调函数
+ * @param       ret     : 命令完成结果
+ *              playload: 响应消息的Playload
+ *              pl      : 响应消息的Playload Length
+ *              arg     : 阻塞等待的上下文
+ * @retval      无
+ */
+static void atk_mo1218_bin_cmd_sync_callback(uint8_t ret, const uint8_t *playload, uint16_t pl, void *arg)
+{
+    atk_mo1218_bin_cmd_sync_t *sync = (atk_mo1218_bin_cmd_sync_t *)arg;
     
-    /* Message Body Length */
-    if (len != NULL)
+    if ((ret == ATK_MO1218_EOK) && (playload != NULL) && (sync->res != NULL))
     {
-        *len = pl - sizeof(*mid);
+        memcpy(sync->res, playload, (pl < sync->res_len) ? pl : sync->res_len);
     }
     
-    return ATK_MO1218_EOK;
+    sync->ret = ret;
+    sync->done = 1;
+}
+
+/**
+ * @brief       往ATK-MO1218发送Binary Message并阻塞等待响应消息
+ * @note        基于异步Binary命令队列实现，等待期间只处理Binary Message，见atk_mo1218_process_bin()；
+ *              不能在atk_mo1218_process()的回调函数中调用
+ * @param       playload: Binary Message的Playload
+ *              pl      : Binary Message的Playload Length（playload的长度）
+ *              res_mid : 期望的响应Message ID，为0时收到ACK即完成
+ *              res_sid : 期望的响应Sub-ID，仅命令带Sub-ID时有效
+ *              res     : 响应消息的Playload（包含Message ID），可以为NULL
+ *              res_len : res的大小
+ *              timeout : 等待响应超时时间，单位：100毫秒，为0时不等待响应
+ * @retval      ATK_MO1218_EOK     : Binary Message发送成功，并得到期望的响应
+ *              ATK_MO1218_ERROR   : 得到NACK、命令队列已满或在回调函数中调用
+ *              ATK_MO1218_ETIMEOUT: 等待响应超时
+ */
+static uint8_t atk_mo1218_query_bin_msg(uint8_t *playload, uint16_t pl, uint8_t res_mid, uint8_t res_sid, uint8_t *res, uint16_t res_len, uint16_t timeout)
+{
+    atk_mo1218_bin_cmd_sync_t sync = {0};
+    uint32_t total;
+    uint32_t attempt;
+    uint8_t ret;
+    
+    /* 总超时时间分为若干次等待，每次等待超时后重发 */
+    total = (uint32_t)timeout * 100;
+    attempt = (total < ATK_MO1218_BIN_CMD_TIMEOUT) ? total : ATK_MO1218_BIN_CMD_TIMEOUT;
+    
+    /* 在回调函数中无法等待命令完成 */
+    if (atk_mo1218_process_bin() != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    sync.res = res;
+    sync.res_len = res_len;
+    ret = atk_mo1218_bin_cmd_submit(playload, pl, res_mid, res_sid, attempt, (attempt == 0) ? 0 : (uint8_t)(total / attempt - 1), atk_mo1218_bin_cmd_sync_callback, &sync);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    while (sync.done == 0)
+    {
+        atk_mo1218_process_bin();
+    }
+    
+    return sync.ret;
 }
 
 /**
  * @brief       往ATK-MO1218发送Binary Message
+ * @note        阻塞等待，不阻塞的用法见atk_mo1218_bin_cmd_submit()；
+ *              组建批量配置事务期间，消息加入事务，不发送也不等待
  * @param       playload: Binary Message的Playload
  *              pl      : Binary Message的Playload Length（playload的长度）
  *              timeout : 等待响应超时时间，单位：100毫秒
  * @retval      ATK_MO1218_EOK     : Binary Message发送成功，并得到ACK响应
- *              ATK_MO1218_ERROR   : 得到NACK或其他响应
+ *              ATK_MO1218_ERROR   : 得到NACK响应
  *              ATK_MO1218_ETIMEOUT: 等待响应超时
  */
 uint8_t atk_mo1218_send_bin_msg(uint8_t *playload, uint16_t pl, uint16_t timeout)
 {
-    static uint8_t msg[ATK_MO1218_BIN_MSG_BUF_SIZE] = {0};  /* Binaray Message Buffer */
-    uint16_t playload_index;
-    uint16_t msg_len;
-    uint8_t *res;
-    uint8_t res_mid;
+    if (g_bin_batch.state == ATK_MO1218_BIN_BATCH_BUILD)
+    {
+        return atk_mo1218_bin_batch_add(playload, pl);
+    }
     
-    /* 计算Message的长度 */
-    msg_len = ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + ATK_MO1218_BIN_MSG_ES_LEN;
-    if (msg_len > ATK_MO1218_BIN_MSG_BUF_SIZE)
+    return atk_mo1218_query_bin_msg(playload, pl, 0, 0, NULL, 0, timeout);
+}
+
+/**
+ * @brief       开始组建批量配置事务
+ * @note        此后调用的atk_mo1218_config_*()等只需ACK的函数不再发送消息，而是将消息加入事务，
+ *              返回ATK_MO1218_EOK仅表示已加入，直到atk_mo1218_bin_batch_commit()或atk_mo1218_bin_batch_execute()；
+ *              上一个事务未完成时，本次组建的事务无法提交
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_bin_batch_begin(void)
+{
+    if (g_bin_batch.state != ATK_MO1218_BIN_BATCH_IDLE)
     {
-        return ATK_MO1218_ERROR;
+        return;
     }
     
-    /* Start of Sequence */
-    msg[0] = (uint8_t)(ATK_MO1218_BIN_MSG_SS >> 8) & 0xFF;
-    msg[1] = (uint8_t)ATK_MO1218_BIN_MSG_SS & 0xFF;
-    /* Playload Length */
-    msg[ATK_MO1218_BIN_MSG_SS_LEN + 0] = (uint8_t)(pl >> 8) & 0xFF;
-    msg[ATK_MO1218_BIN_MSG_SS_LEN + 1] = (uint8_t)pl & 0xFF;
-    /* Playload */
-    for (playload_index=0; playload_index<pl; playload_index++)
+    g_bin_batch.buf_len = 0;
+    g_bin_batch.num = 0;
+    g_bin_batch.state = ATK_MO1218_BIN_BATCH_BUILD;
+}
+
+/**
+ * @brief       往批量配置事务中添加一条消息
+ * @param       playload: Binary Message的Playload（添加时组帧，调用后可释放）
+ *              pl      : Binary Message的Playload Length（playload的长度）
+ * @retval      ATK_MO1218_EOK   : 添加成功
+ *              ATK_MO1218_ERROR : 未在组建事务，或事务已满
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_bin_batch_add(uint8_t *playload, uint16_t pl)
+{
+    uint8_t item_index;
+    
+    if ((playload == NULL) || (pl == 0) || (pl > ATK_MO1218_BIN_MSG_PLAYLOAD_MAX_LEN))
     {
-        msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + playload_index] = playload[playload_index];
+        return ATK_MO1218_EINVAL;
     }
-    /* Checksum */
-    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + 0] = 0;
-    for (playload_index=0; playload_index<pl; playload_index++)
+    
+    if ((g_bin_batch.state != ATK_MO1218_BIN_BATCH_BUILD) || (g_bin_batch.num >= ATK_MO1218_BIN_BATCH_SIZE) || ((g_bin_batch.buf_len + ATK_MO1218_BIN_MSG_BUF_SIZE) > ATK_MO1218_BIN_BATCH_BUF_SIZE))
     {
-        msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + 0] ^= msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + playload_index];
+        return ATK_MO1218_ERROR;
     }
-    /* End of Sequence */
-    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 0] = (uint8_t)(ATK_MO1218_BIN_MSG_ES >> 8) & 0xFF;
-    msg[ATK_MO1218_BIN_MSG_SS_LEN + ATK_MO1218_BIN_MSG_PL_LEN + pl + ATK_MO1218_BIN_MSG_CS_LEN + 1] = (uint8_t)ATK_MO1218_BIN_MSG_ES & 0xFF;
     
-    /* ATK-MO1218 UART重新开始接收数据 */
-    atk_mo1218_uart_rx_restart();
+    item_index = g_bin_batch.num;
+    g_bin_batch.item[item_index].offset = g_bin_batch.buf_len;
+    g_bin_batch.item[item_index].len = (uint8_t)atk_mo1218_encode_bin_msg(playload, pl, &g_bin_batch.buf[g_bin_batch.buf_len]);
+    g_bin_batch.item[item_index].mid = playload[0];
+    g_bin_batch.item[item_index].sid = (pl > 1) ? playload[1] : 0;
+    g_bin_batch.buf_len += g_bin_batch.item[item_index].len;
+    g_bin_batch.num++;
     
-    /* 发送Binary Message */
-    atk_mo1218_uart_send(msg, msg_len);
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取批量配置事务中的消息数量
+ * @param       无
+ * @retval      已加入事务的消息数量
+ */
+uint8_t atk_mo1218_bin_batch_count(void)
+{
+    return g_bin_batch.num;
+}
+
+/**
+ * @brief       提交批量配置事务
+ * @note        事务中的消息由atk_mo1218_bin_cmd_poll()连续发送，
+ *              超时后只重发未应答的消息，回调函数在atk_mo1218_process()中调用
+ * @param       callback: 完成回调函数，可以为NULL
+ *              arg     : 回调函数用户参数
+ * @retval      ATK_MO1218_EOK  : 提交成功（事务为空时立即回调）
+ *              ATK_MO1218_ERROR: 未在组建事务
+ */
+uint8_t atk_mo1218_bin_batch_commit(atk_mo1218_bin_batch_callback_t callback, void *arg)
+{
+    if (g_bin_batch.state != ATK_MO1218_BIN_BATCH_BUILD)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    memset(g_bin_batch.ret, ATK_MO1218_BIN_BATCH_PENDING_RET, sizeof(g_bin_batch.ret));
+    g_bin_batch.pending = g_bin_batch.num;
+    g_bin_batch.retry = ATK_MO1218_BIN_CMD_RETRY;
+    g_bin_batch.callback = callback;
+    g_bin_batch.arg = arg;
     
-    /* 等待响应 */
-    if (timeout == 0)
+    if (g_bin_batch.num == 0)
     {
+        atk_mo1218_bin_batch_complete();
         return ATK_MO1218_EOK;
     }
-    else
+    
+    g_bin_batch.state = ATK_MO1218_BIN_BATCH_PENDING;
+    
+    return ATK_MO1218_EOK;
+}
+
+/* 阻塞等待批量配置事务完成的上下文 */
+typedef struct
+{
+    volatile uint8_t done;                      /* 事务已完成 */
+    uint8_t *ret;                               /* 每条消息结果的保存位置 */
+    uint8_t error;                              /* 有消息未收到ACK */
+} atk_mo1218_bin_batch_sync_t;
+
+/**
+ * @brief       阻塞等待批量配置事务完成的回调函数
+ * @param       ret: 每条消息的结果
+ *              num: 消息数量
+ *              arg: 阻塞等待的上下文
+ * @retval      无
+ */
+static void atk_mo1218_bin_batch_sync_callback(const uint8_t *ret, uint8_t num, void *arg)
+{
+    atk_mo1218_bin_batch_sync_t *sync = (atk_mo1218_bin_batch_sync_t *)arg;
+    uint8_t item_index;
+    
+    for (item_index=0; item_index<num; item_index++)
     {
-        while (timeout > 0)
+        if (ret[item_index] != ATK_MO1218_EOK)
         {
-            /* 获取响应数据 */
-            res = atk_mo1218_uart_rx_get_frame();
-            if (res != NULL)
-            {
-                /* 解析响应数据 */
-                if (atk_mo1218_decode_bin_msg(res, &res_mid, NULL, NULL) == ATK_MO1218_EOK)
-                {
-                    if (res_mid == ATK_MO1218_MID_83)
-                    {
-                        /* 得到ACK响应 */
-                        return ATK_MO1218_EOK;
-                    }
-                    else
-                    {
-                        /* 得到NACK或其他响应 */
-                        return ATK_MO1218_ERROR;
-                    }
-                }
-                
-                /* 重发Binary Message */
-                atk_mo1218_uart_send(msg, msg_len);
-                atk_mo1218_uart_rx_restart();
-            }
-            timeout--;
-            delay_ms(100);
+            sync->error = 1;
         }
-        
-        return ATK_MO1218_ETIMEOUT;
     }
+    
+    if (sync->ret != NULL)
+    {
+        memcpy(sync->ret, ret, num);
+    }
+    
+    sync->done = 1;
 }
 
 /**
- * @brief       ATK-MO1218模块系统重启
- * @param       restart: ATK_MO1218_RESTART_HOT : 热启动
- *                       ATK_MO1218_RESTART_WARM: 温启动
- *                       ATK_MO1218_RESTART_COLD: 冷启动
- * @retval      ATK_MO1218_EOK  : ATK-MO1218模块系统重启成功
- *              ATK_MO1218_ERROR: ATK-MO1218模块系统重启失败
+ * @brief       提交批量配置事务并阻塞等待完成
+ * @note        等待期间只处理Binary Message，见atk_mo1218_process_bin()，正常情况下只需一次模块应答的时间；
+ *              在atk_mo1218_process()的回调函数中调用时放弃事务
+ * @param       ret: 每条消息的结果，大小需不小于atk_mo1218_bin_batch_count()，可以为NULL
+ * @retval      ATK_MO1218_EOK  : 全部消息都收到ACK
+ *              ATK_MO1218_ERROR: 有消息收到NACK或超时，或未在组建事务，或在回调函数中调用
+ */
+uint8_t atk_mo1218_bin_batch_execute(uint8_t *ret)
+{
+    atk_mo1218_bin_batch_sync_t sync = {0};
+    
+    /* 在回调函数中无法等待事务完成 */
+    if (atk_mo1218_process_bin() != ATK_MO1218_EOK)
+    {
+        if (g_bin_batch.state == ATK_MO1218_BIN_BATCH_BUILD)
+        {
+            g_bin_batch.state = ATK_MO1218_BIN_BATCH_IDLE;
+        }
+        return ATK_MO1218_ERROR;
+    }
+    
+    sync.ret = ret;
+    if (atk_mo1218_bin_batch_commit(atk_mo1218_bin_batch_sync_callback, &sync) != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    while (sync.done == 0)
+    {
+        atk_mo1218_process_bin();
+    }
+    
+    return (sync.error == 0) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       查询批量配置事务是否未完成
+ * @param       无
+ * @retval      0: 空闲
+ *              1: 正在组建或执行
+ */
+uint8_t atk_mo1218_bin_batch_busy(void)
+{
+    return (g_bin_batch.state != ATK_MO1218_BIN_BATCH_IDLE) ? 1 : 0;
+}
+
+/**
+ * @brief       编码系统重启的Playload
+ * @param       restart : 重启方式
+ *              hint    : 重启时提供给模块的UTC时间和概略位置，为NULL时不提供
+ *              playload: 编码后的Playload
+ * @retval      ATK_MO1218_EOK   : 编码成功
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
-uint8_t atk_mo1218_restart(atk_mo1218_restart_t restart)
+static uint8_t atk_mo1218_encode_restart(atk_mo1218_restart_t restart, const atk_mo1218_restart_hint_t *hint, atk_mo1218_mid_01_playload_t *playload)
 {
-    uint8_t ret;
-    atk_mo1218_mid_01_playload_t playload = {0};
+    memset(playload, 0, sizeof(atk_mo1218_mid_01_playload_t));
     
     switch (restart)
     {
         case ATK_MO1218_RESTART_HOT:
         {
-            playload.start_mode = 1;
+            playload->start_mode = 1;
             break;
         }
         case ATK_MO1218_RESTART_WARM:
         {
-            playload.start_mode = 2;
+            playload->start_mode = 2;
             break;
         }
         case ATK_MO1218_RESTART_COLD:
         {
-            playload.start_mode = 3;
+            playload->start_mode = 3;
             break;
         }
         default:
@@ -896,24 +1665,104 @@ uint8_t atk_mo1218_restart(atk_mo1218_restart_t restart)
         }
     }
     
-    playload.mid = ATK_MO1218_MID_01;
-    playload.utc_year = 0;
-    playload.utc_month = 0;
-    playload.utc_day = 0;
-    playload.utc_hour = 0;
-    playload.utc_minute = 0;
-    playload.utc_second = 0;
-    playload.latitude = 0;
-    playload.longitude = 0;
-    playload.altitude = 0;
+    playload->mid = ATK_MO1218_MID_01;
+    
+    if (hint != NULL)
+    {
+        if ((hint->year < 1980) || (hint->month < 1) || (hint->month > 12) || (hint->day < 1) || (hint->day > 31) ||
+            (hint->hour > 23) || (hint->minute > 59) || (hint->second > 59) ||
+            (hint->latitude < -9000) || (hint->latitude > 9000) ||
+            (hint->longitude < -18000) || (hint->longitude > 18000) ||
+            (hint->altitude < -1000) || (hint->altitude > 18300))
+        {
+            return ATK_MO1218_EINVAL;
+        }
+        
+        playload->utc_year[0] = (uint8_t)(hint->year >> 8) & 0xFF;
+        playload->utc_year[1] = (uint8_t)hint->year & 0xFF;
+        playload->utc_month = hint->month;
+        playload->utc_day = hint->day;
+        playload->utc_hour = hint->hour;
+        playload->utc_minute = hint->minute;
+        playload->utc_second = hint->second;
+        playload->latitude[0] = (uint8_t)((uint16_t)hint->latitude >> 8) & 0xFF;
+        playload->latitude[1] = (uint8_t)hint->latitude & 0xFF;
+        playload->longitude[0] = (uint8_t)((uint16_t)hint->longitude >> 8) & 0xFF;
+        playload->longitude[1] = (uint8_t)hint->longitude & 0xFF;
+        playload->altitude[0] = (uint8_t)((uint16_t)hint->altitude >> 8) & 0xFF;
+        playload->altitude[1] = (uint8_t)hint->altitude & 0xFF;
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       ATK-MO1218模块系统重启
+ * @param       restart: ATK_MO1218_RESTART_HOT : 热启动
+ *                       ATK_MO1218_RESTART_WARM: 温启动
+ *                       ATK_MO1218_RESTART_COLD: 冷启动
+ * @retval      ATK_MO1218_EOK  : ATK-MO1218模块系统重启成功
+ *              ATK_MO1218_ERROR: ATK-MO1218模块系统重启失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_restart(atk_mo1218_restart_t restart)
+{
+    return atk_mo1218_restart_with_hint(restart, NULL);
+}
+
+/**
+ * @brief       ATK-MO1218模块系统重启，并提供UTC时间和概略位置
+ * @note        热启动、温启动时，模块根据UTC时间和概略位置预测可见卫星，缩短首次定位时间
+ * @param       restart: ATK_MO1218_RESTART_HOT : 热启动
+ *                       ATK_MO1218_RESTART_WARM: 温启动
+ *                       ATK_MO1218_RESTART_COLD: 冷启动
+ *              hint   : UTC时间和概略位置，为NULL时不提供
+ * @retval      ATK_MO1218_EOK  : ATK-MO1218模块系统重启成功
+ *              ATK_MO1218_ERROR: ATK-MO1218模块系统重启失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_restart_with_hint(atk_mo1218_restart_t restart, const atk_mo1218_restart_hint_t *hint)
+{
+    uint8_t ret;
+    atk_mo1218_mid_01_playload_t playload;
+    
+    ret = atk_mo1218_encode_restart(restart, hint, &playload);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ret;
+    }
+    
+    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       异步重启ATK-MO1218模块系统，并提供UTC时间和概略位置
+ * @param       restart : 重启方式
+ *              hint    : UTC时间和概略位置，为NULL时不提供
+ *              callback: 命令完成回调函数，可为NULL
+ *              arg     : 回调函数参数
+ * @retval      ATK_MO1218_EOK   : 已加入命令队列
+ *              ATK_MO1218_ERROR : 命令队列已满
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_restart_async(atk_mo1218_restart_t restart, const atk_mo1218_restart_hint_t *hint, atk_mo1218_bin_cmd_callback_t callback, void *arg)
+{
+    uint8_t ret;
+    atk_mo1218_mid_01_playload_t playload;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
+    ret = atk_mo1218_encode_restart(restart, hint, &playload);
     if (ret != ATK_MO1218_EOK)
     {
-        return ATK_MO1218_ERROR;
+        return ret;
     }
     
-    return ATK_MO1218_EOK;
+    return atk_mo1218_bin_cmd_submit((uint8_t *)&playload, sizeof(playload), 0, 0, ATK_MO1218_BIN_CMD_TIMEOUT, ATK_MO1218_BIN_CMD_RETRY, callback, arg);
 }
 
 /**
@@ -927,7 +1776,6 @@ uint8_t atk_mo1218_get_sw_version(atk_mo1218_sw_version_t *version)
 {
     uint8_t ret;
     atk_mo1218_mid_02_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_80_playload_t playload_res = {0};
     
     if (version == NULL)
@@ -938,24 +1786,12 @@ uint8_t atk_mo1218_get_sw_version(atk_mo1218_sw_version_t *version)
     playload.mid = ATK_MO1218_MID_02;
     playload.sw_type = 1;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_80, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_80)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     version->kernel.x1 = playload_res.kernel_ver[1];
     version->kernel.y1 = playload_res.kernel_ver[2];
     version->kernel.z1 = playload_res.kernel_ver[3];
@@ -980,7 +1816,6 @@ uint8_t atk_mo1218_get_sw_crc(uint16_t *crc)
 {
     uint8_t ret;
     atk_mo1218_mid_03_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_81_playload_t playload_res = {0};
     
     if (crc == NULL)
@@ -991,24 +1826,12 @@ uint8_t atk_mo1218_get_sw_crc(uint16_t *crc)
     playload.mid = ATK_MO1218_MID_03;
     playload.sw_type = 1;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_81, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_81)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     *crc = (uint16_t)(playload_res.crc[0] << 8) | playload_res.crc[1];
     
     return ATK_MO1218_EOK;
@@ -1052,6 +1875,9 @@ uint8_t atk_mo1218_factory_reset(atk_mo1218_factory_reset_type_t type)
         return ATK_MO1218_ERROR;
     }
     
+    /* 模块配置已恢复为出厂设置，影子缓存失效 */
+    atk_mo1218_config_invalidate(ATK_MO1218_CONFIG_ALL);
+    
     return ATK_MO1218_EOK;
 }
 
@@ -1316,6 +2142,7 @@ uint8_t atk_mo1218_config_power_mode(atk_mo1218_power_mode_t mode, atk_mo1218_sa
         case ATK_MO1218_POWER_MODE_SAVE:
         {
             playload.mode = 1;
+            break;
         }
         default:
         {
@@ -1487,7 +2314,6 @@ uint8_t atk_mo1218_get_position_rate(atk_mo1218_position_rate_t *rate)
 {
     uint8_t ret;
     atk_mo1218_mid_10_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_86_playload_t playload_res = {0};
     
     if (rate == NULL)
@@ -1497,24 +2323,12 @@ uint8_t atk_mo1218_get_position_rate(atk_mo1218_position_rate_t *rate)
     
     playload.mid = ATK_MO1218_MID_10;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_86, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_86)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.rate)
     {
         case 1:
@@ -1632,7 +2446,6 @@ uint8_t atk_mo1218_get_power_mode(atk_mo1218_power_mode_t *mode)
 {
     uint8_t ret;
     atk_mo1218_mid_15_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_b9_playload_t playload_res = {0};
     
     if (mode == NULL)
@@ -1642,24 +2455,12 @@ uint8_t atk_mo1218_get_power_mode(atk_mo1218_power_mode_t *mode)
     
     playload.mid = ATK_MO1218_MID_15;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_B9, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_B9)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.mode)
     {
         case 0:
@@ -1884,7 +2685,6 @@ uint8_t atk_mo1218_get_datum(uint16_t *datum_index)
 {
     uint8_t ret;
     atk_mo1218_mid_2d_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_ae_playload_t playload_res = {0};
     
     if (datum_index == NULL)
@@ -1894,24 +2694,12 @@ uint8_t atk_mo1218_get_datum(uint16_t *datum_index)
     
     playload.mid = ATK_MO1218_MID_2D;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_AE, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_AE)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     *datum_index = (uint16_t)(playload_res.datum_index[0] << 8) | playload_res.datum_index[1];
     
     return ATK_MO1218_EOK;
@@ -1935,7 +2723,6 @@ uint8_t atk_mo1218_get_dop_mask(atk_mo1218_dop_mode_t *mode, uint16_t *pdop_val,
 {
     uint8_t ret;
     atk_mo1218_mid_2e_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_af_playload_t playload_res = {0};
     
     if ((mode == NULL) && (pdop_val == NULL) && (hdop_val == NULL) && (gdop_val == NULL))
@@ -1945,24 +2732,12 @@ uint8_t atk_mo1218_get_dop_mask(atk_mo1218_dop_mode_t *mode, uint16_t *pdop_val,
     
     playload.mid = ATK_MO1218_MID_2E;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_AF, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_AF)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     if (mode != NULL)
     {
         switch (playload_res.mode)
@@ -1979,17 +2754,17 @@ uint8_t atk_mo1218_get_dop_mask(atk_mo1218_dop_mode_t *mode, uint16_t *pdop_val,
             }
             case 2:
             {
-                *mode = ATK_MO1218_DOP_MODE_GDOP;
+                *mode = ATK_MO1218_DOP_MODE_PDOP;
                 break;
             }
             case 3:
             {
-                *mode = ATK_MO1218_DOP_MODE_PDOP;
+                *mode = ATK_MO1218_DOP_MODE_HDOP;
                 break;
             }
             case 4:
             {
-                *mode = ATK_MO1218_DOP_MODE_HDOP;
+                *mode = ATK_MO1218_DOP_MODE_GDOP;
                 break;
             }
             default:
@@ -2033,7 +2808,6 @@ uint8_t atk_mo1218_get_evelation_cnr_mask(atk_mo1218_elevation_cnr_mode_t *mode,
 {
     uint8_t ret;
     atk_mo1218_mid_2f_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_b0_playload_t playload_res = {0};
     
     if ((mode == NULL) && (elevation_mask == NULL) && (cnr_mask == NULL))
@@ -2043,24 +2817,12 @@ uint8_t atk_mo1218_get_evelation_cnr_mask(atk_mo1218_elevation_cnr_mode_t *mode,
     
     playload.mid = ATK_MO1218_MID_2F;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_B0, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_B0)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     if (mode != NULL)
     {
         switch (playload_res.mode)
@@ -2117,9 +2879,7 @@ uint8_t atk_mo1218_get_gps_ephemeris(uint8_t sv, atk_mo1218_gps_ephemeris_data_t
 {
     uint8_t ret;
     atk_mo1218_mid_30_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_b1_playload_t playload_res = {0};
-    uint8_t frame_index;
     
     if (sv > 32)
     {
@@ -2134,39 +2894,69 @@ uint8_t atk_mo1218_get_gps_ephemeris(uint8_t sv, atk_mo1218_gps_ephemeris_data_t
     playload.mid = ATK_MO1218_MID_30;
     playload.sv = sv;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_B1, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
-    if (ret != ATK_MO1218_EOK)
+    return atk_mo1218_decode_gps_ephemeris((uint8_t *)&playload_res, sizeof(playload_res), data);
+}
+
+/**
+ * @brief       解析ATK-MO1218模块GPS星历数据消息（Message ID = 0xB1）
+ * @param       playload: Binary Message的Playload
+ *              pl      : Binary Message的Playload Length
+ *              data    : 解析后的GPS星历数据
+ * @retval      ATK_MO1218_EOK   : 解析成功
+ *              ATK_MO1218_ERROR : 不是GPS星历数据消息或长度错误
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_gps_ephemeris(const uint8_t *playload, uint16_t pl, atk_mo1218_gps_ephemeris_data_t *data)
+{
+    const atk_mo1218_mid_b1_playload_t *msg = (const atk_mo1218_mid_b1_playload_t *)playload;
+    
+    if ((playload == NULL) || (data == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_B1)
+    if ((pl < sizeof(atk_mo1218_mid_b1_playload_t)) || (msg->mid != ATK_MO1218_MID_B1))
     {
         return ATK_MO1218_ERROR;
     }
     
-    data->sv_id = (uint16_t)(playload_res.sv[0] << 8) | playload_res.sv[1];
-    for (frame_index=0; frame_index<sizeof(playload_res.sub_frame0); frame_index++)
-    {
-        data->subframe0[frame_index] = playload_res.sub_frame0[frame_index];
-    }
-    for (frame_index=0; frame_index<sizeof(playload_res.sub_frame1); frame_index++)
-    {
-        data->subframe1[frame_index] = playload_res.sub_frame1[frame_index];
-    }
-    for (frame_index=0; frame_index<sizeof(playload_res.sub_frame2); frame_index++)
+    data->sv_id = atk_mo1218_bin_msg_get_u16(msg->sv);
+    memcpy(data->subframe0, msg->sub_frame0, sizeof(data->subframe0));
+    memcpy(data->subframe1, msg->sub_frame1, sizeof(data->subframe1));
+    memcpy(data->subframe2, msg->sub_frame2, sizeof(data->subframe2));
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       异步获取ATK-MO1218模块GPS星历数据
+ * @note        响应消息在回调函数中通过atk_mo1218_decode_gps_ephemeris()解析
+ * @param       sv      : 卫星编号，范围：1~32
+ *              callback: 完成回调函数
+ *              arg     : 回调函数用户参数
+ * @retval      ATK_MO1218_EOK   : 提交成功
+ *              ATK_MO1218_ERROR : 命令队列已满
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_gps_ephemeris_async(uint8_t sv, atk_mo1218_bin_cmd_callback_t callback, void *arg)
+{
+    atk_mo1218_mid_30_playload_t playload = {0};
+    
+    if ((sv == 0) || (sv > 32))
     {
-        data->subframe2[frame_index] = playload_res.sub_frame2[frame_index];
+        return ATK_MO1218_EINVAL;
     }
     
-    return ATK_MO1218_EOK;
+    playload.mid = ATK_MO1218_MID_30;
+    playload.sv = sv;
+    
+    return atk_mo1218_bin_cmd_submit((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_B1, 0, ATK_MO1218_BIN_CMD_TIMEOUT, ATK_MO1218_BIN_CMD_RETRY, callback, arg);
 }
 
 /**
@@ -2248,7 +3038,6 @@ uint8_t atk_mo1218_get_position_pinning_status(atk_mo1218_position_pinning_statu
 {
     uint8_t ret;
     atk_mo1218_mid_3a_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_b4_playload_t playload_res = {0};
     
     if (status == NULL)
@@ -2258,24 +3047,12 @@ uint8_t atk_mo1218_get_position_pinning_status(atk_mo1218_position_pinning_statu
     
     playload.mid = ATK_MO1218_MID_3A;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_B4, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_B4)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.status)
     {
         case 0:
@@ -2366,6 +3143,22 @@ uint8_t atk_mo1218_config_position_pinning_parameters(atk_mo1218_position_pinnin
     return ATK_MO1218_EOK;
 }
 
+/**
+ * @brief       将GPS星历数据填入Playload（Message ID = 0x41）
+ * @param       data    : GPS星历数据
+ *              playload: Playload
+ * @retval      无
+ */
+static void atk_mo1218_encode_gps_ephemeris(const atk_mo1218_gps_ephemeris_data_t *data, atk_mo1218_mid_41_playload_t *playload)
+{
+    playload->mid = ATK_MO1218_MID_41;
+    playload->sv[0] = (uint8_t)(data->sv_id >> 8) & 0xFF;
+    playload->sv[1] = (uint8_t)data->sv_id & 0xFF;
+    memcpy(playload->sub_frame0, data->subframe0, sizeof(playload->sub_frame0));
+    memcpy(playload->sub_frame1, data->subframe1, sizeof(playload->sub_frame1));
+    memcpy(playload->sub_frame2, data->subframe2, sizeof(playload->sub_frame2));
+}
+
 /**
  * @brief       设置ATK-MO1218模块GPS星历数据
  * @param       data: GPS星历数据
@@ -2377,28 +3170,13 @@ uint8_t atk_mo1218_set_gps_ephemeris(atk_mo1218_gps_ephemeris_data_t *data)
 {
     uint8_t ret;
     atk_mo1218_mid_41_playload_t playload = {0};
-    uint8_t frame_index;
     
     if (data == NULL)
     {
         return ATK_MO1218_EINVAL;
     }
     
-    playload.mid = ATK_MO1218_MID_41;
-    playload.sv[0] = (uint8_t)(data->sv_id >> 8) & 0xFF;
-    playload.sv[1] = (uint8_t)data->sv_id & 0xFF;
-    for (frame_index=0; frame_index<sizeof(playload.sub_frame0); frame_index++)
-    {
-        playload.sub_frame0[frame_index] = data->subframe0[frame_index];
-    }
-    for (frame_index=0; frame_index<sizeof(playload.sub_frame1); frame_index++)
-    {
-        playload.sub_frame1[frame_index] = data->subframe1[frame_index];
-    }
-    for (frame_index=0; frame_index<sizeof(playload.sub_frame2); frame_index++)
-    {
-        playload.sub_frame2[frame_index] = data->subframe2[frame_index];
-    }
+    atk_mo1218_encode_gps_ephemeris(data, &playload);
     
     ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
@@ -2409,6 +3187,29 @@ uint8_t atk_mo1218_set_gps_ephemeris(atk_mo1218_gps_ephemeris_data_t *data)
     return ATK_MO1218_EOK;
 }
 
+/**
+ * @brief       异步设置ATK-MO1218模块GPS星历数据
+ * @param       data    : GPS星历数据（提交时复制，调用后可释放）
+ *              callback: 完成回调函数，可以为NULL
+ *              arg     : 回调函数用户参数
+ * @retval      ATK_MO1218_EOK   : 提交成功
+ *              ATK_MO1218_ERROR : 命令队列已满
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_set_gps_ephemeris_async(const atk_mo1218_gps_ephemeris_data_t *data, atk_mo1218_bin_cmd_callback_t callback, void *arg)
+{
+    atk_mo1218_mid_41_playload_t playload = {0};
+    
+    if (data == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    atk_mo1218_encode_gps_ephemeris(data, &playload);
+    
+    return atk_mo1218_bin_cmd_submit((uint8_t *)&playload, sizeof(playload), 0, 0, ATK_MO1218_BIN_CMD_TIMEOUT, ATK_MO1218_BIN_CMD_RETRY, callback, arg);
+}
+
 /**
  * @brief       配置ATK-MO1218模块1PPS的电缆延时
  * @param       cable_delay: 1PPS的电缆延时，范围：-500000~500000，单位：0.01纳秒
@@ -2472,7 +3273,6 @@ uint8_t atk_mo1218_get_1pps_cable_delay(int32_t *cable_delay)
 {
     uint8_t ret;
     atk_mo1218_mid_46_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_bb_playload_t playload_res = {0};
     
     if (cable_delay == NULL)
@@ -2482,24 +3282,12 @@ uint8_t atk_mo1218_get_1pps_cable_delay(int32_t *cable_delay)
     
     playload.mid = ATK_MO1218_MID_46;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_BB, 0, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if (playload_res.mid != ATK_MO1218_MID_BB)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     *cable_delay = (int32_t)(playload_res.cable_delay[0] << 24) | (playload_res.cable_delay[1] << 16) | (playload_res.cable_delay[2] << 8) | playload_res.cable_delay[3];
     
     return ATK_MO1218_EOK;
@@ -2691,7 +3479,6 @@ uint8_t atk_mo1218_get_sbas_status(atk_mo1218_sbas_parameter_t *parameter)
 {
     uint8_t ret;
     atk_mo1218_mid_62_02_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_62_80_playload_t playload_res = {0};
     
     if (parameter == NULL)
@@ -2702,24 +3489,12 @@ uint8_t atk_mo1218_get_sbas_status(atk_mo1218_sbas_parameter_t *parameter)
     playload.mid = ATK_MO1218_MID_62;
     playload.sid = ATK_MO1218_SID_62_02;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_62, ATK_MO1218_SID_62_80, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_62) || (playload_res.sid != ATK_MO1218_SID_62_80))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.enable)
     {
         case 0:
@@ -2936,7 +3711,6 @@ uint8_t atk_mo1218_get_qzss_status(atk_mo1218_qzss_parameter_t *parameter)
 {
     uint8_t ret;
     atk_mo1218_mid_62_04_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_62_81_playload_t playload_res = {0};
     
     if (parameter == NULL)
@@ -2947,24 +3721,12 @@ uint8_t atk_mo1218_get_qzss_status(atk_mo1218_qzss_parameter_t *parameter)
     playload.mid = ATK_MO1218_MID_62;
     playload.sid = ATK_MO1218_SID_62_04;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_62, ATK_MO1218_SID_62_81, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_62) || (playload_res.sid != ATK_MO1218_SID_62_81))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.enable)
     {
         case 0:
@@ -3078,7 +3840,6 @@ uint8_t atk_mo1218_get_saee_status(atk_mo1218_saee_parameter_t *parameter)
 {
     uint8_t ret;
     atk_mo1218_mid_63_02_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_63_80_playload_t playload_res = {0};
     
     if (parameter == NULL)
@@ -3089,24 +3850,12 @@ uint8_t atk_mo1218_get_saee_status(atk_mo1218_saee_parameter_t *parameter)
     playload.mid = ATK_MO1218_MID_63;
     playload.sid = ATK_MO1218_SID_63_02;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_63, ATK_MO1218_SID_63_80, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_63) || (playload_res.sid != ATK_MO1218_SID_63_80))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.enable)
     {
         case 0:
@@ -3144,7 +3893,6 @@ uint8_t atk_mo1218_get_boot_status(atk_mo1218_boot_status_t *status)
 {
     uint8_t ret;
     atk_mo1218_mid_64_01_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_64_80_playload_t playload_res = {0};
     
     if (status == NULL)
@@ -3155,24 +3903,12 @@ uint8_t atk_mo1218_get_boot_status(atk_mo1218_boot_status_t *status)
     playload.mid = ATK_MO1218_MID_64;
     playload.sid = ATK_MO1218_SID_64_01;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_64, ATK_MO1218_SID_64_80, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_64) || (playload_res.sid != ATK_MO1218_SID_64_80))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.fail_over)
     {
         case 0:
@@ -3283,7 +4019,6 @@ uint8_t atk_mo1218_get_ext_nmea_msg(uint8_t *gga, uint8_t *gsa, uint8_t *gsv, ui
 {
     uint8_t ret;
     atk_mo1218_mid_64_03_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_64_81_playload_t playload_res = {0};
     
     if ((gga == NULL) && (gsa == NULL) && (gsv == NULL) && (gll == NULL) && (rmc == NULL) && (vtg == NULL) && (zda == NULL) && (gns == NULL) && (gbs == NULL) && (grs == NULL) && (dtm == NULL) && (gst == NULL))
@@ -3294,24 +4029,12 @@ uint8_t atk_mo1218_get_ext_nmea_msg(uint8_t *gga, uint8_t *gsa, uint8_t *gsv, ui
     playload.mid = ATK_MO1218_MID_64;
     playload.sid = ATK_MO1218_SID_64_03;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_64, ATK_MO1218_SID_64_81, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_64) || (playload_res.sid != ATK_MO1218_SID_64_81))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     if (gga != NULL)
     {
         *gga = playload_res.gga_interval;
@@ -3448,7 +4171,6 @@ uint8_t atk_mo1218_get_interence_detection_status(atk_mo1218_interence_detection
 {
     uint8_t ret;
     atk_mo1218_mid_64_07_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_64_83_playload_t playload_res = {0};
     
     if (status == NULL)
@@ -3459,24 +4181,12 @@ uint8_t atk_mo1218_get_interence_detection_status(atk_mo1218_interence_detection
     playload.mid = ATK_MO1218_MID_64;
     playload.sid = ATK_MO1218_SID_64_07;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_64, ATK_MO1218_SID_64_83, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_64) || (playload_res.sid != ATK_MO1218_SID_64_83))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.enable)
     {
         case 0:
@@ -3617,7 +4327,6 @@ uint8_t atk_mo1218_get_navigation_mode(atk_mo1218_navigation_mode_t *mode)
 {
     uint8_t ret;
     atk_mo1218_mid_64_18_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_64_8b_playload_t playload_res = {0};
     
     if (mode == NULL)
@@ -3628,24 +4337,12 @@ uint8_t atk_mo1218_get_navigation_mode(atk_mo1218_navigation_mode_t *mode)
     playload.mid = ATK_MO1218_MID_64;
     playload.sid = ATK_MO1218_SID_64_18;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_64, ATK_MO1218_SID_64_8B, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_64) || (playload_res.sid != ATK_MO1218_SID_64_8B))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     switch (playload_res.mode)
     {
         case 0:
@@ -3765,7 +4462,6 @@ uint8_t atk_mo1218_get_gnss_for_navigation(atk_mo1218_gnss_for_navigation_t *gns
 {
     uint8_t ret;
     atk_mo1218_mid_64_1a_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_64_8c_playload_t playload_res = {0};
     
     if (gnss == NULL)
@@ -3776,24 +4472,12 @@ uint8_t atk_mo1218_get_gnss_for_navigation(atk_mo1218_gnss_for_navigation_t *gns
     playload.mid = ATK_MO1218_MID_64;
     playload.sid = ATK_MO1218_SID_64_1A;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_64, ATK_MO1218_SID_64_8C, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_64) || (playload_res.sid != ATK_MO1218_SID_64_8C))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     if (((playload_res.gnss[1] & (0x01 << 0)) == (0x01 << 0)) && ((playload_res.gnss[1] & (0x01 << 3)) == (0x01 << 3)))
     {
         *gnss = ATK_MO1218_GNSS_GPS_BEIDOU;
@@ -3878,7 +4562,6 @@ uint8_t atk_mo1218_get_1pps_pulse_width(uint32_t *pulse_width)
 {
     uint8_t ret;
     atk_mo1218_mid_65_02_playload_t playload = {0};
-    uint8_t *buf;
     atk_mo1218_mid_65_80_playload_t playload_res = {0};
     
     if (pulse_width == NULL)
@@ -3889,24 +4572,12 @@ uint8_t atk_mo1218_get_1pps_pulse_width(uint32_t *pulse_width)
     playload.mid = ATK_MO1218_MID_65;
     playload.sid = ATK_MO1218_SID_65_02;
     
-    ret = atk_mo1218_send_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_BIN_MSG_TIMEOUT);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
-    buf = atk_mo1218_uart_rx_get_frame();
-    ret = atk_mo1218_decode_bin_msg(&buf[ATK_MO1218_BIN_MSG_ACK_SID_LEN], &playload_res.mid, &playload_res.mid + 1, NULL);
+    ret = atk_mo1218_query_bin_msg((uint8_t *)&playload, sizeof(playload), ATK_MO1218_MID_65, ATK_MO1218_SID_65_80, (uint8_t *)&playload_res, sizeof(playload_res), ATK_MO1218_BIN_MSG_TIMEOUT);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
     
-    if ((playload_res.mid != ATK_MO1218_MID_65) || (playload_res.sid != ATK_MO1218_SID_65_80))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    
     *pulse_width = (uint32_t)(playload_res.pulse_width[0] << 24) | (playload_res.pulse_width[1] << 16) | (playload_res.pulse_width[2] << 8) | playload_res.pulse_width[3];
     
     return ATK_MO1218_EOK;
@@ -0,0 +1,576 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_config.c
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块配置影子缓存驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#include "atk_mo1218_config.h"
+#include "atk_mo1218.h"
+#include <string.h>
+
+/* 可从模块读取的配置项 */
+#define ATK_MO1218_CONFIG_READABLE  (ATK_MO1218_CONFIG_ALL & ~(ATK_MO1218_CONFIG_OUTPUT_TYPE | ATK_MO1218_CONFIG_NAVIGATION_INTERVAL))
+
+/* 串口波特率枚举对应的波特率 */
+static const uint32_t g_config_baudrate[] = {4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
+
+/* ATK-MO1218模块配置影子缓存
+ * 记录模块当前的配置，known中的配置项才有效
+ */
+static struct
+{
+    atk_mo1218_config_t config;
+    uint32_t known;                                 /* 影子缓存中有效的配置项 */
+} g_config_shadow = {0};
+
+/**
+ * @brief       从ATK-MO1218模块读取当前配置到影子缓存
+ * @note        串口波特率取自当前UART通讯波特率；
+ *              输出类型和导航数据消息间隔无法读取，保持原状态；
+ *              读取失败的配置项在影子缓存中标记为无效
+ * @param       mask: 需要读取的配置项
+ * @retval      ATK_MO1218_EOK  : 全部配置项读取成功
+ *              ATK_MO1218_ERROR: 有配置项读取失败
+ */
+uint8_t atk_mo1218_config_read(uint32_t mask)
+{
+    atk_mo1218_config_t *shadow = &g_config_shadow.config;
+    uint32_t read = 0;
+    uint8_t baudrate_index;
+    atk_mo1218_dop_mode_t dop_mode;
+    atk_mo1218_elevation_cnr_mode_t elevation_cnr_mode;
+    
+    mask &= ATK_MO1218_CONFIG_READABLE;
+    g_config_shadow.known &= ~mask;
+    
+    if ((mask & ATK_MO1218_CONFIG_SERIAL) != 0)
+    {
+        for (baudrate_index=0; baudrate_index<sizeof(g_config_baudrate)/sizeof(g_config_baudrate[0]); baudrate_index++)
+        {
+            if (g_config_baudrate[baudrate_index] == atk_mo1218_uart_get_baudrate())
+            {
+                shadow->baudrate = (atk_mo1218_serial_baudrate_t)baudrate_index;
+                read |= ATK_MO1218_CONFIG_SERIAL;
+                break;
+            }
+        }
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_NMEA_INTERVAL) != 0) && (atk_mo1218_get_ext_nmea_msg(&shadow->nmea_interval.gga, &shadow->nmea_interval.gsa, &shadow->nmea_interval.gsv, &shadow->nmea_interval.gll, &shadow->nmea_interval.rmc, &shadow->nmea_interval.vtg, &shadow->nmea_interval.zda, &shadow->nmea_interval.gns, &shadow->nmea_interval.gbs, &shadow->nmea_interval.grs, &shadow->nmea_interval.dtm, &shadow->nmea_interval.gst) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_NMEA_INTERVAL;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_POSITION_RATE) != 0) && (atk_mo1218_get_position_rate(&shadow->position_rate) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_POSITION_RATE;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_POWER_MODE) != 0) && (atk_mo1218_get_power_mode(&shadow->power_mode) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_POWER_MODE;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_NAVIGATION_MODE) != 0) && (atk_mo1218_get_navigation_mode(&shadow->navigation_mode) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_NAVIGATION_MODE;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_GNSS) != 0) && (atk_mo1218_get_gnss_for_navigation(&shadow->gnss) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_GNSS;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_SBAS) != 0) && (atk_mo1218_get_sbas_status(&shadow->sbas) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_SBAS;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_QZSS) != 0) && (atk_mo1218_get_qzss_status(&shadow->qzss) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_QZSS;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_SAEE) != 0) && (atk_mo1218_get_saee_status(&shadow->saee) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_SAEE;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_DOP_MASK) != 0) && (atk_mo1218_get_dop_mask(&dop_mode, &shadow->dop_mask.pdop_val, &shadow->dop_mask.hdop_val, &shadow->dop_mask.gdop_val) == ATK_MO1218_EOK))
+    {
+        shadow->dop_mask.mode = dop_mode;
+        read |= ATK_MO1218_CONFIG_DOP_MASK;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_ELEVATION_CNR_MASK) != 0) && (atk_mo1218_get_evelation_cnr_mask(&elevation_cnr_mode, &shadow->elevation_cnr_mask.elevation_mask, &shadow->elevation_cnr_mask.cnr_mask) == ATK_MO1218_EOK))
+    {
+        shadow->elevation_cnr_mask.mode = elevation_cnr_mode;
+        read |= ATK_MO1218_CONFIG_ELEVATION_CNR_MASK;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_POSITION_PINNING) != 0) && (atk_mo1218_get_position_pinning_status(&shadow->position_pinning) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_POSITION_PINNING;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_INTERFERENCE_DETECTION) != 0)
+    {
+        atk_mo1218_interence_detection_status_t status;
+        
+        if (atk_mo1218_get_interence_detection_status(&status) == ATK_MO1218_EOK)
+        {
+            shadow->interference_detection = status.enable;
+            read |= ATK_MO1218_CONFIG_INTERFERENCE_DETECTION;
+        }
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_1PPS_CABLE_DELAY) != 0) && (atk_mo1218_get_1pps_cable_delay(&shadow->pps_cable_delay) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_1PPS_CABLE_DELAY;
+    }
+    
+    if (((mask & ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH) != 0) && (atk_mo1218_get_1pps_pulse_width(&shadow->pps_pulse_width) == ATK_MO1218_EOK))
+    {
+        read |= ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH;
+    }
+    
+    g_config_shadow.known |= read;
+    
+    return (read == mask) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       获取与影子缓存不同的配置项
+ * @param       config: 期望的配置，仅比较config->mask中的配置项
+ * @retval      与模块当前配置不同（或当前配置未知）的配置项
+ */
+uint32_t atk_mo1218_config_diff(const atk_mo1218_config_t *config)
+{
+    const atk_mo1218_config_t *shadow = &g_config_shadow.config;
+    uint32_t diff;
+    
+    diff = config->mask & ~g_config_shadow.known;
+    
+    if (config->baudrate != shadow->baudrate)
+    {
+        diff |= ATK_MO1218_CONFIG_SERIAL;
+    }
+    
+    if (config->output_type != shadow->output_type)
+    {
+        diff |= ATK_MO1218_CONFIG_OUTPUT_TYPE;
+    }
+    
+    if ((config->nmea_interval.gga != shadow->nmea_interval.gga) || (config->nmea_interval.gsa != shadow->nmea_interval.gsa) ||
+        (config->nmea_interval.gsv != shadow->nmea_interval.gsv) || (config->nmea_interval.gll != shadow->nmea_interval.gll) ||
+        (config->nmea_interval.rmc != shadow->nmea_interval.rmc) || (config->nmea_interval.vtg != shadow->nmea_interval.vtg) ||
+        (config->nmea_interval.zda != shadow->nmea_interval.zda) || (config->nmea_interval.gns != shadow->nmea_interval.gns) ||
+        (config->nmea_interval.gbs != shadow->nmea_interval.gbs) || (config->nmea_interval.grs != shadow->nmea_interval.grs) ||
+        (config->nmea_interval.dtm != shadow->nmea_interval.dtm) || (config->nmea_interval.gst != shadow->nmea_interval.gst))
+    {
+        diff |= ATK_MO1218_CONFIG_NMEA_INTERVAL;
+    }
+    
+    if (config->position_rate != shadow->position_rate)
+    {
+        diff |= ATK_MO1218_CONFIG_POSITION_RATE;
+    }
+    
+    if (config->navigation_interval != shadow->navigation_interval)
+    {
+        diff |= ATK_MO1218_CONFIG_NAVIGATION_INTERVAL;
+    }
+    
+    if (config->power_mode != shadow->power_mode)
+    {
+        diff |= ATK_MO1218_CONFIG_POWER_MODE;
+    }
+    
+    if (config->navigation_mode != shadow->navigation_mode)
+    {
+        diff |= ATK_MO1218_CONFIG_NAVIGATION_MODE;
+    }
+    
+    if (config->gnss != shadow->gnss)
+    {
+        diff |= ATK_MO1218_CONFIG_GNSS;
+    }
+    
+    if ((config->sbas.enable != shadow->sbas.enable) || (config->sbas.navigation != shadow->sbas.navigation) ||
+        (config->sbas.ranging_ura_mask != shadow->sbas.ranging_ura_mask) || (config->sbas.correction != shadow->sbas.correction) ||
+        (config->sbas.num_tracking_channel != shadow->sbas.num_tracking_channel) || (config->sbas.waas != shadow->sbas.waas) ||
+        (config->sbas.egnos != shadow->sbas.egnos) || (config->sbas.msas != shadow->sbas.msas))
+    {
+        diff |= ATK_MO1218_CONFIG_SBAS;
+    }
+    
+    if ((config->qzss.enable != shadow->qzss.enable) || (config->qzss.num_tracking_channel != shadow->qzss.num_tracking_channel))
+    {
+        diff |= ATK_MO1218_CONFIG_QZSS;
+    }
+    
+    if (config->saee.enable != shadow->saee.enable)
+    {
+        diff |= ATK_MO1218_CONFIG_SAEE;
+    }
+    
+    if ((config->dop_mask.mode != shadow->dop_mask.mode) || (config->dop_mask.pdop_val != shadow->dop_mask.pdop_val) ||
+        (config->dop_mask.hdop_val != shadow->dop_mask.hdop_val) || (config->dop_mask.gdop_val != shadow->dop_mask.gdop_val))
+    {
+        diff |= ATK_MO1218_CONFIG_DOP_MASK;
+    }
+    
+    if ((config->elevation_cnr_mask.mode != shadow->elevation_cnr_mask.mode) ||
+        (config->elevation_cnr_mask.elevation_mask != shadow->elevation_cnr_mask.elevation_mask) ||
+        (config->elevation_cnr_mask.cnr_mask != shadow->elevation_cnr_mask.cnr_mask))
+    {
+        diff |= ATK_MO1218_CONFIG_ELEVATION_CNR_MASK;
+    }
+    
+    if ((config->position_pinning.status != shadow->position_pinning.status) ||
+        (config->position_pinning.parameter.pinning_speed != shadow->position_pinning.parameter.pinning_speed) ||
+        (config->position_pinning.parameter.pinning_cnt != shadow->position_pinning.parameter.pinning_cnt) ||
+        (config->position_pinning.parameter.unpinning_speed != shadow->position_pinning.parameter.unpinning_speed) ||
+        (config->position_pinning.parameter.unpinning_cnt != shadow->position_pinning.parameter.unpinning_cnt) ||
+        (config->position_pinning.parameter.unpinning_distance != shadow->position_pinning.parameter.unpinning_distance))
+    {
+        diff |= ATK_MO1218_CONFIG_POSITION_PINNING;
+    }
+    
+    if (config->interference_detection != shadow->interference_detection)
+    {
+        diff |= ATK_MO1218_CONFIG_INTERFERENCE_DETECTION;
+    }
+    
+    if (config->pps_cable_delay != shadow->pps_cable_delay)
+    {
+        diff |= ATK_MO1218_CONFIG_1PPS_CABLE_DELAY;
+    }
+    
+    if (config->pps_pulse_width != shadow->pps_pulse_width)
+    {
+        diff |= ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH;
+    }
+    
+    return diff & config->mask;
+}
+
+/**
+ * @brief       将已配置成功的配置项更新到影子缓存
+ * @param       config: 期望的配置
+ *              mask  : 已配置成功的配置项
+ * @retval      无
+ */
+static void atk_mo1218_config_update_shadow(const atk_mo1218_config_t *config, uint32_t mask)
+{
+    atk_mo1218_config_t *shadow = &g_config_shadow.config;
+    
+    if ((mask & ATK_MO1218_CONFIG_SERIAL) != 0)
+    {
+        shadow->baudrate = config->baudrate;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_OUTPUT_TYPE) != 0)
+    {
+        shadow->output_type = config->output_type;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_NMEA_INTERVAL) != 0)
+    {
+        shadow->nmea_interval = config->nmea_interval;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_POSITION_RATE) != 0)
+    {
+        shadow->position_rate = config->position_rate;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_NAVIGATION_INTERVAL) != 0)
+    {
+        shadow->navigation_interval = config->navigation_interval;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_POWER_MODE) != 0)
+    {
+        shadow->power_mode = config->power_mode;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_NAVIGATION_MODE) != 0)
+    {
+        shadow->navigation_mode = config->navigation_mode;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_GNSS) != 0)
+    {
+        shadow->gnss = config->gnss;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_SBAS) != 0)
+    {
+        shadow->sbas = config->sbas;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_QZSS) != 0)
+    {
+        shadow->qzss = config->qzss;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_SAEE) != 0)
+    {
+        shadow->saee = config->saee;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_DOP_MASK) != 0)
+    {
+        shadow->dop_mask = config->dop_mask;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_ELEVATION_CNR_MASK) != 0)
+    {
+        shadow->elevation_cnr_mask = config->elevation_cnr_mask;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_POSITION_PINNING) != 0)
+    {
+        shadow->position_pinning = config->position_pinning;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_INTERFERENCE_DETECTION) != 0)
+    {
+        shadow->interference_detection = config->interference_detection;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_1PPS_CABLE_DELAY) != 0)
+    {
+        shadow->pps_cable_delay = config->pps_cable_delay;
+    }
+    
+    if ((mask & ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH) != 0)
+    {
+        shadow->pps_pulse_width = config->pps_pulse_width;
+    }
+    
+    g_config_shadow.known |= mask;
+}
+
+/**
+ * @brief       记录批量配置事务中新加入的消息所属的配置项
+ * @param       item  : 配置项
+ *              ret   : 加入事务的结果，失败时该配置项记为配置失败
+ *              owner : 事务中每条消息所属的配置项
+ *              marked: 已记录的消息数量
+ *              fail  : 配置失败的配置项
+ * @retval      无
+ */
+static void atk_mo1218_config_batch_mark(uint32_t item, uint8_t ret, uint32_t *owner, uint8_t *marked, uint32_t *fail)
+{
+    while (*marked < atk_mo1218_bin_batch_count())
+    {
+        owner[(*marked)++] = item;
+    }
+    
+    if (ret != ATK_MO1218_EOK)
+    {
+        *fail |= item;
+    }
+}
+
+/**
+ * @brief       仅发送与ATK-MO1218模块当前配置不同的配置项
+ * @note        影子缓存中未知的配置项先从模块读取一次，
+ *              不同的配置项组成一个批量配置事务连续发送，配置成功后更新影子缓存；
+ *              无法读取的配置项（输出类型和导航数据消息间隔）未知时无法判断是否不同，
+ *              只发送到SRAM，确实与影子缓存不同时才按save_type保存，避免每次上电都写模块Flash；
+ *              串口波特率在事务完成后单独配置，配置成功后同时修改UART通讯波特率
+ * @param       config   : 期望的配置，仅处理config->mask中的配置项
+ *              save_type: ATK_MO1218_SAVE_SRAM      : 保存到SRAM（配置掉电丢失）
+ *                         ATK_MO1218_SAVE_SRAM_FLASH: 保存到SRAM和Flash（配置掉电不丢失）
+ * @retval      ATK_MO1218_EOK   : 配置成功（或无需配置）
+ *              ATK_MO1218_ERROR : 有配置项配置失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_config_apply(const atk_mo1218_config_t *config, atk_mo1218_save_type_t save_type)
+{
+    uint32_t diff;
+    uint32_t unknown;
+    uint32_t fail = 0;
+    uint32_t owner[ATK_MO1218_BIN_BATCH_SIZE];
+    uint8_t marked = 0;
+    uint8_t ret[ATK_MO1218_BIN_BATCH_SIZE];
+    uint8_t item_index;
+    atk_mo1218_sbas_parameter_t sbas;
+    atk_mo1218_qzss_parameter_t qzss;
+    atk_mo1218_saee_parameter_t saee;
+    atk_mo1218_position_pinning_parameter_t pinning_parameter;
+    
+    if ((config == NULL) || ((save_type != ATK_MO1218_SAVE_SRAM) && (save_type != ATK_MO1218_SAVE_SRAM_FLASH)))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (atk_mo1218_bin_batch_busy() != 0)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    atk_mo1218_config_read(config->mask & ~g_config_shadow.known);
+    diff = atk_mo1218_config_diff(config);
+    unknown = config->mask & ~g_config_shadow.known;
+    
+    atk_mo1218_bin_batch_begin();
+    
+    if ((diff & ATK_MO1218_CONFIG_OUTPUT_TYPE) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_OUTPUT_TYPE, atk_mo1218_config_output_type(config->output_type, ((unknown & ATK_MO1218_CONFIG_OUTPUT_TYPE) != 0) ? ATK_MO1218_SAVE_SRAM : save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_NMEA_INTERVAL) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_NMEA_INTERVAL, atk_mo1218_config_ext_nmea_msg(config->nmea_interval.gga, config->nmea_interval.gsa, config->nmea_interval.gsv, config->nmea_interval.gll, config->nmea_interval.rmc, config->nmea_interval.vtg, config->nmea_interval.zda, config->nmea_interval.gns, config->nmea_interval.gbs, config->nmea_interval.grs, config->nmea_interval.dtm, config->nmea_interval.gst, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_POSITION_RATE) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_POSITION_RATE, atk_mo1218_config_position_rate(config->position_rate, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_NAVIGATION_INTERVAL) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_NAVIGATION_INTERVAL, atk_mo1218_config_navigation_interval(config->navigation_interval, ((unknown & ATK_MO1218_CONFIG_NAVIGATION_INTERVAL) != 0) ? ATK_MO1218_SAVE_SRAM : save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_POWER_MODE) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_POWER_MODE, atk_mo1218_config_power_mode(config->power_mode, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_NAVIGATION_MODE) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_NAVIGATION_MODE, atk_mo1218_config_navigation_mode(config->navigation_mode, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_GNSS) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_GNSS, atk_mo1218_config_gnss_for_navigation(config->gnss, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_SBAS) != 0)
+    {
+        sbas = config->sbas;
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_SBAS, atk_mo1218_config_sbas(&sbas, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_QZSS) != 0)
+    {
+        qzss = config->qzss;
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_QZSS, atk_mo1218_config_qzss(&qzss, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_SAEE) != 0)
+    {
+        saee = config->saee;
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_SAEE, atk_mo1218_config_saee(&saee, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_DOP_MASK) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_DOP_MASK, atk_mo1218_config_dop_mask(config->dop_mask.mode, config->dop_mask.pdop_val, config->dop_mask.hdop_val, config->dop_mask.gdop_val, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_ELEVATION_CNR_MASK) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_ELEVATION_CNR_MASK, atk_mo1218_config_evelation_cnr_mask(config->elevation_cnr_mask.mode, config->elevation_cnr_mask.elevation_mask, config->elevation_cnr_mask.cnr_mask, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_POSITION_PINNING) != 0)
+    {
+        pinning_parameter = config->position_pinning.parameter;
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_POSITION_PINNING, atk_mo1218_config_position_pinning(config->position_pinning.status, save_type), owner, &marked, &fail);
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_POSITION_PINNING, atk_mo1218_config_position_pinning_parameters(&pinning_parameter, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_INTERFERENCE_DETECTION) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_INTERFERENCE_DETECTION, atk_mo1218_config_interference_detection(config->interference_detection, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_1PPS_CABLE_DELAY) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_1PPS_CABLE_DELAY, atk_mo1218_config_1pps_cable_delay(config->pps_cable_delay, save_type), owner, &marked, &fail);
+    }
+    
+    if ((diff & ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH) != 0)
+    {
+        atk_mo1218_config_batch_mark(ATK_MO1218_CONFIG_1PPS_PULSE_WIDTH, atk_mo1218_config_1pps_pulse_width(config->pps_pulse_width, save_type), owner, &marked, &fail);
+    }
+    
+    /* 全部消息连续发送，一次模块应答的时间内完成 */
+    memset(ret, ATK_MO1218_ERROR, sizeof(ret));
+    atk_mo1218_bin_batch_execute(ret);
+    for (item_index=0; item_index<marked; item_index++)
+    {
+        if (ret[item_index] != ATK_MO1218_EOK)
+        {
+            fail |= owner[item_index];
+        }
+    }
+    
+    atk_mo1218_config_update_shadow(config, diff & ~ATK_MO1218_CONFIG_SERIAL & ~fail);
+    
+    /* 模块以原波特率回复ACK后才切换波特率 */
+    if ((diff & ATK_MO1218_CONFIG_SERIAL) != 0)
+    {
+        if ((config->baudrate < sizeof(g_config_baudrate)/sizeof(g_config_baudrate[0])) && (atk_mo1218_config_serial(config->baudrate, save_type) == ATK_MO1218_EOK))
+        {
+            atk_mo1218_uart_set_baudrate(g_config_baudrate[config->baudrate]);
+            atk_mo1218_config_update_shadow(config, ATK_MO1218_CONFIG_SERIAL);
+        }
+        else
+        {
+            fail |= ATK_MO1218_CONFIG_SERIAL;
+        }
+    }
+    
+    return (fail == 0) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       使影子缓存中的配置项失效
+ * @note        绕过本模块直接配置模块、恢复出厂设置后调用，下次应用配置时重新读取
+ * @param       mask: 失效的配置项
+ * @retval      无
+ */
+void atk_mo1218_config_invalidate(uint32_t mask)
+{
+    g_config_shadow.known &= ~mask;
+}
+
+/**
+ * @brief       获取影子缓存
+ * @param       config: 影子缓存中的配置
+ * @retval      影子缓存中有效的配置项
+ */
+uint32_t atk_mo1218_config_get_shadow(atk_mo1218_config_t *config)
+{
+    if (config != NULL)
+    {
+        memcpy(config, &g_config_shadow.config, sizeof(atk_mo1218_config_t));
+        config->mask = g_config_shadow.known;
+    }
+    
+    return g_config_shadow.known;
+}
@@ -0,0 +1,615 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_ephemeris.c
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块GPS星历保存与恢复驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#include "atk_mo1218_ephemeris.h"
+#include "atk_mo1218.h"
+#include <string.h>
+
+/* 星历存储区标识 */
+#define ATK_MO1218_EPHEMERIS_MAGIC          0x45504832
+
+/* 星历记录中表示无记录的时间（Flash擦除后的值） */
+#define ATK_MO1218_EPHEMERIS_NO_RECORD      0xFFFFFFFF
+
+/* 星历存储区大小 */
+#define ATK_MO1218_EPHEMERIS_BANK_SIZE      (ATK_MO1218_EPHEMERIS_FLASH_BANK_PAGES * FLASH_PAGE_SIZE)
+
+/* 星历记录 */
+typedef struct
+{
+    uint32_t timestamp;                             /* 下载星历时的UTC时间，1970-01-01起的秒数 */
+    atk_mo1218_gps_ephemeris_data_t data;           /* GPS星历数据 */
+} atk_mo1218_ephemeris_record_t;
+
+/* 最后定位记录 */
+typedef struct
+{
+    uint32_t timestamp;                             /* 定位的UTC时间，1970-01-01起的秒数 */
+    int32_t latitude;                               /* 纬度（扩大100000倍），北纬为正，单位：度 */
+    int32_t longitude;                              /* 经度（扩大100000倍），东经为正，单位：度 */
+    int32_t altitude;                               /* 海拔高度（扩大10倍），单位：米 */
+} atk_mo1218_ephemeris_fix_t;
+
+/* 星历存储区
+ * 先写入全部记录，最后写入commit，commit为0的存储区才是完整的
+ */
+typedef struct
+{
+    uint32_t magic;                                 /* 存储区标识 */
+    uint32_t sequence;                              /* 写入序号，序号最大的完整存储区为最新 */
+    uint32_t commit;                                /* 写入完成标志，写入完成后为0 */
+    atk_mo1218_ephemeris_fix_t fix;                 /* 最后定位记录 */
+    atk_mo1218_ephemeris_record_t record[ATK_MO1218_EPHEMERIS_SV_NUM];   /* 按SV编号排列的星历记录 */
+} atk_mo1218_ephemeris_bank_t;
+
+/* 星历管理状态枚举 */
+typedef enum
+{
+    ATK_MO1218_EPHEMERIS_IDLE = 0x00,               /* 空闲 */
+    ATK_MO1218_EPHEMERIS_HINT,                      /* 正在以最后定位位置和当前时间热启动模块 */
+    ATK_MO1218_EPHEMERIS_RESTORE,                   /* 正在将星历写入模块 */
+    ATK_MO1218_EPHEMERIS_ERASE,                     /* 正在擦除存储区 */
+    ATK_MO1218_EPHEMERIS_DOWNLOAD,                  /* 正在从模块下载星历 */
+    ATK_MO1218_EPHEMERIS_COMMIT,                    /* 正在写入完成标志 */
+} atk_mo1218_ephemeris_state_t;
+
+/* 星历管理器，仅在主循环中访问 */
+static struct
+{
+    atk_mo1218_ephemeris_state_t state;
+    const atk_mo1218_ephemeris_bank_t *bank;        /* 最新的完整存储区，NULL表示没有 */
+    uint8_t target;                                 /* 正在写入的存储区 */
+    uint8_t index;                                  /* 正在处理的页或SV编号-1 */
+    uint8_t done;                                   /* 已完成下载的SV数量 */
+    uint32_t timestamp;                             /* 本次下载的UTC时间，1970-01-01起的秒数 */
+    uint8_t fixed;                                  /* 已定位 */
+    uint8_t saved;                                  /* 已保存过星历 */
+    uint8_t flash_error;                            /* 本次保存擦除或写入Flash失败，不写入完成标志 */
+    uint32_t tick;                                  /* 首次定位或上次保存的时间，单位：1毫秒 */
+    uint32_t init_tick;                             /* 初始化的时间，单位：1毫秒 */
+    uint32_t ttff;                                  /* 首次定位时间，单位：1毫秒 */
+    atk_mo1218_ephemeris_fix_t fix;                 /* 本次保存的最后定位记录 */
+} g_ephemeris = {0};
+
+/* 最近读取的定位历元中的时间和位置，仅在需要时读取 */
+static atk_mo1218_fix_position_t g_ephemeris_last_fix;
+
+/**
+ * @brief       获取星历存储区的地址
+ * @param       bank: 存储区编号
+ * @retval      存储区的地址
+ */
+static const atk_mo1218_ephemeris_bank_t *atk_mo1218_ephemeris_bank(uint8_t bank)
+{
+    return (const atk_mo1218_ephemeris_bank_t *)(ATK_MO1218_EPHEMERIS_FLASH_ADDR + (uint32_t)bank * ATK_MO1218_EPHEMERIS_BANK_SIZE);
+}
+
+/**
+ * @brief       将UTC时间转换为1970-01-01起的秒数
+ * @param       utc: UTC时间
+ * @retval      1970-01-01起的秒数
+ */
+static uint32_t atk_mo1218_ephemeris_utc_to_seconds(const atk_mo1218_time_t *utc)
+{
+    uint32_t year;
+    uint32_t era;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t doe;
+    
+    year = utc->year - ((utc->month <= 2) ? 1 : 0);
+    era = year / 400;
+    yoe = year - era * 400;
+    doy = (153 * ((utc->month > 2) ? (utc->month - 3) : (utc->month + 9)) + 2) / 5 + utc->day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    
+    return (era * 146097 + doe - 719468) * 86400 + ((uint32_t)utc->hour * 60 + utc->minute) * 60 + utc->second;
+}
+
+/**
+ * @brief       将1970-01-01起的秒数转换为UTC时间
+ * @param       seconds: 1970-01-01起的秒数
+ *              utc    : UTC时间
+ * @retval      无
+ */
+static void atk_mo1218_ephemeris_seconds_to_utc(uint32_t seconds, atk_mo1218_time_t *utc)
+{
+    uint32_t days;
+    uint32_t era;
+    uint32_t doe;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t mp;
+    
+    days = seconds / 86400 + 719468;
+    era = days / 146097;
+    doe = days - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    
+    utc->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    utc->month = (uint8_t)((mp < 10) ? (mp + 3) : (mp - 9));
+    utc->year = (uint16_t)(yoe + era * 400 + ((utc->month <= 2) ? 1 : 0));
+    utc->hour = (uint8_t)((seconds % 86400) / 3600);
+    utc->minute = (uint8_t)((seconds % 3600) / 60);
+    utc->second = (uint8_t)(seconds % 60);
+    utc->millisecond = 0;
+}
+
+/**
+ * @brief       读取最近发布的定位历元中的时间和位置到g_ephemeris_last_fix
+ * @param       无
+ * @retval      0: 没有有效定位
+ *              1: 有效定位
+ */
+static uint8_t atk_mo1218_ephemeris_read_fix(void)
+{
+    if ((atk_mo1218_get_last_position(&g_ephemeris_last_fix) == ATK_MO1218_EOK) && (g_ephemeris_last_fix.status == ATK_MO1218_NAVIGATION_VALID))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief       获取当前UTC时间
+ * @note        优先使用最近的有效定位，其次使用RTC
+ * @param       valid: g_ephemeris_last_fix是否为有效定位
+ * @retval      0   : 当前时间未知
+ *              其他: 1970-01-01起的秒数
+ */
+static uint32_t atk_mo1218_ephemeris_now(uint8_t valid)
+{
+    atk_mo1218_time_t utc;
+    
+    if ((valid != 0) && (g_ephemeris_last_fix.utc.year >= 2000))
+    {
+        return atk_mo1218_ephemeris_utc_to_seconds(&g_ephemeris_last_fix.utc);
+    }
+    
+    if ((atk_mo1218_rtc_get_time(&utc) == ATK_MO1218_EOK) && (utc.year >= 2000))
+    {
+        return atk_mo1218_ephemeris_utc_to_seconds(&utc);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief       判断星历记录是否可用
+ * @param       record: 星历记录
+ *              now   : 当前UTC时间，为0时不检查星历时长
+ * @retval      0: 不可用
+ *              1: 可用
+ */
+static uint8_t atk_mo1218_ephemeris_record_fresh(const atk_mo1218_ephemeris_record_t *record, uint32_t now)
+{
+    if (record->timestamp == ATK_MO1218_EPHEMERIS_NO_RECORD)
+    {
+        return 0;
+    }
+    
+    if ((now != 0) && ((now < record->timestamp) || ((now - record->timestamp) > ATK_MO1218_EPHEMERIS_MAX_AGE)))
+    {
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief       往Flash写入数据
+ * @param       addr: Flash地址（已擦除）
+ *              dat : 数据
+ *              len : 数据长度（必须为偶数）
+ * @retval      ATK_MO1218_EOK  : 写入成功
+ *              ATK_MO1218_ERROR: 写入失败，失败后不再写入剩余数据
+ */
+static uint8_t atk_mo1218_ephemeris_flash_write(uint32_t addr, const void *dat, uint16_t len)
+{
+    const uint8_t *_dat = (const uint8_t *)dat;
+    uint16_t dat_index;
+    uint8_t ret = ATK_MO1218_EOK;
+    
+    HAL_FLASH_Unlock();
+    for (dat_index=0; dat_index<len; dat_index+=2)
+    {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, addr + dat_index, (uint16_t)(_dat[dat_index] | (_dat[dat_index + 1] << 8))) != HAL_OK)
+        {
+            ret = ATK_MO1218_ERROR;
+            break;
+        }
+    }
+    HAL_FLASH_Lock();
+    
+    return ret;
+}
+
+/**
+ * @brief       放弃本次星历保存
+ * @note        存储区未写入完成标志，不会被当作完整的存储区，最新的存储区保持不变，
+ *              到达下一次保存时间时重新保存
+ * @param       无
+ * @retval      无
+ */
+static void atk_mo1218_ephemeris_abort_save(void)
+{
+    g_ephemeris.tick = HAL_GetTick();
+    g_ephemeris.state = ATK_MO1218_EPHEMERIS_IDLE;
+}
+
+/**
+ * @brief       下载星历完成回调函数
+ * @note        星历有效时写入记录，否则沿用上一个存储区中仍可用的记录
+ * @param       ret     : 命令完成结果
+ *              playload: 响应消息的Playload
+ *              pl      : 响应消息的Playload Length
+ *              arg     : SV编号
+ * @retval      无
+ */
+static void atk_mo1218_ephemeris_download_callback(uint8_t ret, const uint8_t *playload, uint16_t pl, void *arg)
+{
+    uint8_t sv = (uint8_t)(uintptr_t)arg;
+    atk_mo1218_ephemeris_record_t record;
+    uint8_t data_index;
+    uint8_t valid = 0;
+    uint32_t addr;
+    
+    if ((ret == ATK_MO1218_EOK) && (atk_mo1218_decode_gps_ephemeris(playload, pl, &record.data) == ATK_MO1218_EOK) && (record.data.sv_id == sv))
+    {
+        /* 模块没有该卫星的星历时返回全0的子帧 */
+        for (data_index=0; data_index<sizeof(record.data.subframe0); data_index++)
+        {
+            if ((record.data.subframe0[data_index] | record.data.subframe1[data_index] | record.data.subframe2[data_index]) != 0)
+            {
+                valid = 1;
+                break;
+            }
+        }
+    }
+    
+    if (valid != 0)
+    {
+        record.timestamp = g_ephemeris.timestamp;
+    }
+    else if ((g_ephemeris.bank != NULL) && (atk_mo1218_ephemeris_record_fresh(&g_ephemeris.bank->record[sv - 1], g_ephemeris.timestamp) != 0))
+    {
+        memcpy(&record, &g_ephemeris.bank->record[sv - 1], sizeof(record));
+    }
+    else
+    {
+        record.timestamp = ATK_MO1218_EPHEMERIS_NO_RECORD;
+    }
+    
+    if (record.timestamp != ATK_MO1218_EPHEMERIS_NO_RECORD)
+    {
+        addr = (uint32_t)&atk_mo1218_ephemeris_bank(g_ephemeris.target)->record[sv - 1];
+        if (atk_mo1218_ephemeris_flash_write(addr, &record, sizeof(record)) != ATK_MO1218_EOK)
+        {
+            g_ephemeris.flash_error = 1;
+        }
+    }
+    
+    g_ephemeris.done++;
+}
+
+/**
+ * @brief       从Flash恢复GPS星历到ATK-MO1218模块
+ * @note        查找最新的完整存储区，在atk_mo1218_ephemeris_process()中逐条写入模块，
+ *              有当前时间（RTC）时，先以当前时间和最后定位位置热启动模块（星历已过期时温启动），
+ *              有当前时间（RTC）时跳过超过ATK_MO1218_EPHEMERIS_MAX_AGE的星历，
+ *              没有当前时间时全部写入，由模块根据星历参考时间判断是否可用
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_ephemeris_init(void)
+{
+    const atk_mo1218_ephemeris_bank_t *bank;
+    uint8_t bank_index;
+    
+    memset(&g_ephemeris, 0, sizeof(g_ephemeris));
+    
+    for (bank_index=0; bank_index<ATK_MO1218_EPHEMERIS_FLASH_BANK_NUM; bank_index++)
+    {
+        bank = atk_mo1218_ephemeris_bank(bank_index);
+        if ((bank->magic != ATK_MO1218_EPHEMERIS_MAGIC) || (bank->commit != 0))
+        {
+            continue;
+        }
+        
+        if ((g_ephemeris.bank == NULL) || ((int32_t)(bank->sequence - g_ephemeris.bank->sequence) > 0))
+        {
+            g_ephemeris.bank = bank;
+        }
+    }
+    
+    g_ephemeris.init_tick = HAL_GetTick();
+    
+    if (g_ephemeris.bank != NULL)
+    {
+        g_ephemeris.timestamp = atk_mo1218_ephemeris_now(atk_mo1218_ephemeris_read_fix());
+        g_ephemeris.state = ATK_MO1218_EPHEMERIS_RESTORE;
+        
+        /* 当前时间已知时，先以最后定位位置热启动（或温启动）模块 */
+        if ((g_ephemeris.timestamp != 0) && (g_ephemeris.bank->fix.timestamp != ATK_MO1218_EPHEMERIS_NO_RECORD) && (g_ephemeris.timestamp >= g_ephemeris.bank->fix.timestamp))
+        {
+            g_ephemeris.state = ATK_MO1218_EPHEMERIS_HINT;
+        }
+    }
+}
+
+/**
+ * @brief       开始保存GPS星历
+ * @note        写入较旧的存储区，写入完成前最新的存储区保持不变
+ * @param       valid: g_ephemeris_last_fix是否为有效定位
+ * @retval      ATK_MO1218_EOK  : 开始保存
+ *              ATK_MO1218_ERROR: 正在保存或恢复星历，或当前时间未知
+ */
+static uint8_t atk_mo1218_ephemeris_start_save(uint8_t valid)
+{
+    if (g_ephemeris.state != ATK_MO1218_EPHEMERIS_IDLE)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    g_ephemeris.timestamp = atk_mo1218_ephemeris_now(valid);
+    if (g_ephemeris.timestamp == 0)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    /* 记录最后定位位置，没有有效定位时沿用上一个存储区中的记录 */
+    if (valid != 0)
+    {
+        g_ephemeris.fix.timestamp = g_ephemeris.timestamp;
+        g_ephemeris.fix.latitude = (g_ephemeris_last_fix.position.latitude.indicator == ATK_MO1218_LATITUDE_NORTH) ? (int32_t)g_ephemeris_last_fix.position.latitude.degree : -(int32_t)g_ephemeris_last_fix.position.latitude.degree;
+        g_ephemeris.fix.longitude = (g_ephemeris_last_fix.position.longitude.indicator == ATK_MO1218_LONGITUDE_EAST) ? (int32_t)g_ephemeris_last_fix.position.longitude.degree : -(int32_t)g_ephemeris_last_fix.position.longitude.degree;
+        g_ephemeris.fix.altitude = g_ephemeris_last_fix.altitude;
+    }
+    else if (g_ephemeris.bank != NULL)
+    {
+        g_ephemeris.fix = g_ephemeris.bank->fix;
+    }
+    else
+    {
+        g_ephemeris.fix.timestamp = ATK_MO1218_EPHEMERIS_NO_RECORD;
+    }
+    
+    g_ephemeris.target = 0;
+    if (g_ephemeris.bank == atk_mo1218_ephemeris_bank(0))
+    {
+        g_ephemeris.target = 1;
+    }
+    g_ephemeris.index = 0;
+    g_ephemeris.flash_error = 0;
+    g_ephemeris.state = ATK_MO1218_EPHEMERIS_ERASE;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       后台保存和恢复GPS星历
+ * @note        在主循环中调用，不阻塞：
+ *              星历通过异步Binary命令逐颗卫星下载和写入，与NMEA消息接收同时进行；
+ *              每次调用最多擦除一页Flash；
+ *              定位后等待ATK_MO1218_EPHEMERIS_FIRST_DELAY首次保存，此后每隔ATK_MO1218_EPHEMERIS_INTERVAL保存一次
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_ephemeris_process(void)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t page_error;
+    HAL_StatusTypeDef status;
+    uint32_t header[3];
+    atk_mo1218_restart_hint_t hint;
+    atk_mo1218_time_t utc;
+    
+    /* 首次定位前每次检查，此后只在到达保存时间时读取定位历元 */
+    if ((g_ephemeris.fixed == 0) && (atk_mo1218_ephemeris_read_fix() != 0))
+    {
+        g_ephemeris.fixed = 1;
+        g_ephemeris.tick = HAL_GetTick();
+        g_ephemeris.ttff = g_ephemeris.tick - g_ephemeris.init_tick;
+    }
+    
+    switch (g_ephemeris.state)
+    {
+        case ATK_MO1218_EPHEMERIS_IDLE:
+        {
+            if (g_ephemeris.fixed == 0)
+            {
+                break;
+            }
+            
+            /* 到达保存时间时仍需有效定位，定位暂时失效时等待恢复 */
+            if ((HAL_GetTick() - g_ephemeris.tick) >= ((g_ephemeris.saved == 0) ? ATK_MO1218_EPHEMERIS_FIRST_DELAY : ATK_MO1218_EPHEMERIS_INTERVAL))
+            {
+                if (atk_mo1218_ephemeris_read_fix() != 0)
+                {
+                    atk_mo1218_ephemeris_start_save(1);
+                }
+            }
+            break;
+        }
+        case ATK_MO1218_EPHEMERIS_HINT:
+        {
+            atk_mo1218_ephemeris_seconds_to_utc(g_ephemeris.timestamp, &utc);
+            hint.year = utc.year;
+            hint.month = utc.month;
+            hint.day = utc.day;
+            hint.hour = utc.hour;
+            hint.minute = utc.minute;
+            hint.second = utc.second;
+            hint.latitude = (int16_t)(g_ephemeris.bank->fix.latitude / 1000);
+            hint.longitude = (int16_t)(g_ephemeris.bank->fix.longitude / 1000);
+            hint.altitude = (int16_t)(g_ephemeris.bank->fix.altitude / 10);
+            
+            /* 最后定位时的星历已过期时温启动，由模块重新解调星历 */
+            if (atk_mo1218_restart_async(((g_ephemeris.timestamp - g_ephemeris.bank->fix.timestamp) <= ATK_MO1218_EPHEMERIS_MAX_AGE) ? ATK_MO1218_RESTART_HOT : ATK_MO1218_RESTART_WARM, &hint, NULL, NULL) == ATK_MO1218_ERROR)
+            {
+                /* 命令队列已满，下次继续 */
+                break;
+            }
+            
+            g_ephemeris.state = ATK_MO1218_EPHEMERIS_RESTORE;
+            break;
+        }
+        case ATK_MO1218_EPHEMERIS_RESTORE:
+        {
+            while (g_ephemeris.index < ATK_MO1218_EPHEMERIS_SV_NUM)
+            {
+                if (atk_mo1218_ephemeris_record_fresh(&g_ephemeris.bank->record[g_ephemeris.index], g_ephemeris.timestamp) != 0)
+                {
+                    if (atk_mo1218_set_gps_ephemeris_async(&g_ephemeris.bank->record[g_ephemeris.index].data, NULL, NULL) != ATK_MO1218_EOK)
+                    {
+                        /* 命令队列已满，下次继续 */
+                        break;
+                    }
+                }
+                g_ephemeris.index++;
+            }
+            
+            if (g_ephemeris.index == ATK_MO1218_EPHEMERIS_SV_NUM)
+            {
+                g_ephemeris.state = ATK_MO1218_EPHEMERIS_IDLE;
+            }
+            break;
+        }
+        case ATK_MO1218_EPHEMERIS_ERASE:
+        {
+            erase.TypeErase = FLASH_TYPEERASE_PAGES;
+            erase.Banks = FLASH_BANK_1;
+            erase.PageAddress = (uint32_t)atk_mo1218_ephemeris_bank(g_ephemeris.target) + (uint32_t)g_ephemeris.index * FLASH_PAGE_SIZE;
+            erase.NbPages = 1;
+            HAL_FLASH_Unlock();
+            status = HAL_FLASHEx_Erase(&erase, &page_error);
+            HAL_FLASH_Lock();
+            if ((status != HAL_OK) || (page_error != 0xFFFFFFFF))
+            {
+                atk_mo1218_ephemeris_abort_save();
+                break;
+            }
+            
+            g_ephemeris.index++;
+            if (g_ephemeris.index == ATK_MO1218_EPHEMERIS_FLASH_BANK_PAGES)
+            {
+                g_ephemeris.index = 0;
+                g_ephemeris.done = 0;
+                g_ephemeris.state = ATK_MO1218_EPHEMERIS_DOWNLOAD;
+            }
+            break;
+        }
+        case ATK_MO1218_EPHEMERIS_DOWNLOAD:
+        {
+            while (g_ephemeris.index < ATK_MO1218_EPHEMERIS_SV_NUM)
+            {
+                if (atk_mo1218_get_gps_ephemeris_async(g_ephemeris.index + 1, atk_mo1218_ephemeris_download_callback, (void *)(uintptr_t)(g_ephemeris.index + 1)) != ATK_MO1218_EOK)
+                {
+                    break;
+                }
+                g_ephemeris.index++;
+            }
+            
+            /* 等待已提交的下载命令全部完成后再放弃，避免回调写入下一次保存的存储区 */
+            if (g_ephemeris.done == ATK_MO1218_EPHEMERIS_SV_NUM)
+            {
+                if (g_ephemeris.flash_error != 0)
+                {
+                    atk_mo1218_ephemeris_abort_save();
+                    break;
+                }
+                g_ephemeris.state = ATK_MO1218_EPHEMERIS_COMMIT;
+            }
+            break;
+        }
+        case ATK_MO1218_EPHEMERIS_COMMIT:
+        {
+            if ((g_ephemeris.fix.timestamp != ATK_MO1218_EPHEMERIS_NO_RECORD) &&
+                (atk_mo1218_ephemeris_flash_write((uint32_t)&atk_mo1218_ephemeris_bank(g_ephemeris.target)->fix, &g_ephemeris.fix, sizeof(g_ephemeris.fix)) != ATK_MO1218_EOK))
+            {
+                atk_mo1218_ephemeris_abort_save();
+                break;
+            }
+            
+            /* 依次为magic、sequence和commit，commit最后写入，写入失败时存储区保持不完整 */
+            header[0] = ATK_MO1218_EPHEMERIS_MAGIC;
+            header[1] = (g_ephemeris.bank != NULL) ? (g_ephemeris.bank->sequence + 1) : 0;
+            header[2] = 0;
+            if (atk_mo1218_ephemeris_flash_write((uint32_t)atk_mo1218_ephemeris_bank(g_ephemeris.target), header, sizeof(header)) != ATK_MO1218_EOK)
+            {
+                atk_mo1218_ephemeris_abort_save();
+                break;
+            }
+            
+            g_ephemeris.bank = atk_mo1218_ephemeris_bank(g_ephemeris.target);
+            g_ephemeris.saved = 1;
+            g_ephemeris.tick = HAL_GetTick();
+            g_ephemeris.state = ATK_MO1218_EPHEMERIS_IDLE;
+            break;
+        }
+        default:
+        {
+            g_ephemeris.state = ATK_MO1218_EPHEMERIS_IDLE;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief       立即开始保存GPS星历
+ * @note        写入较旧的存储区，写入完成前最新的存储区保持不变
+ * @param       无
+ * @retval      ATK_MO1218_EOK  : 开始保存
+ *              ATK_MO1218_ERROR: 正在保存或恢复星历，或当前时间未知
+ */
+uint8_t atk_mo1218_ephemeris_save(void)
+{
+    if (g_ephemeris.state != ATK_MO1218_EPHEMERIS_IDLE)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    return atk_mo1218_ephemeris_start_save(atk_mo1218_ephemeris_read_fix());
+}
+
+/**
+ * @brief       查询是否正在保存或恢复GPS星历
+ * @param       无
+ * @retval      0: 空闲
+ *              1: 正在保存或恢复
+ */
+uint8_t atk_mo1218_ephemeris_busy(void)
+{
+    return (g_ephemeris.state != ATK_MO1218_EPHEMERIS_IDLE) ? 1 : 0;
+}
+
+/**
+ * @brief       获取首次定位时间（TTFF）
+ * @param       无
+ * @retval      0   : 尚未定位
+ *              其他: 从atk_mo1218_ephemeris_init()到首次有效定位的时间，单位：1毫秒
+ */
+uint32_t atk_mo1218_ephemeris_get_ttff(void)
+{
+    return g_ephemeris.ttff;
+}
@@ -20,87 +20,407 @@
 
 #include "atk_mo1218_nmea_msg.h"
 #include "atk_mo1218.h"
-#include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* ATK-MO1218模块NMEA消息句首和句末 */
 #define ATK_MO1218_NMEA_MSG_SS          (0x24)                                  /* Start of sentence: $ */
 #define ATK_MO1218_NMEA_MSG_ES          (0x0D0A)                                /* Ending of sentence */
 
-/* ATK-MO1218模块NMEA消息地址段 */
-#define ATK_MO1218_NMEA_ADDRESS_GNGGA   "GNGGA"                                 /* $GNGGA */
-#define ATK_MO1218_NMEA_ADDRESS_GNGLL   "GNGLL"                                 /* $GNGLL */
-#define ATK_MO1218_NMEA_ADDRESS_GNGSA   "GNGSA"                                 /* $GNGSA */
-#define ATK_MO1218_NMEA_ADDRESS_GPGSA   "GPGSA"                                 /* $GPGSA */
-#define ATK_MO1218_NMEA_ADDRESS_BDGSA   "BDGSA"                                 /* $BDGSA */
-#define ATK_MO1218_NMEA_ADDRESS_GPGSV   "GPGSV"                                 /* $GPGSV */
-#define ATK_MO1218_NMEA_ADDRESS_BDGSV   "BDGSV"                                 /* $BDGSV */
-#define ATK_MO1218_NMEA_ADDRESS_GNRMC   "GNRMC"                                 /* $GNRMC */
-#define ATK_MO1218_NMEA_ADDRESS_GNVTG   "GNVTG"                                 /* $GNVTG */
-#define ATK_MO1218_NMEA_ADDRESS_GNZDA   "GNZDA"                                 /* $GNZDA */
-
 /* ATK-MO1218模块NMEA消息地址段长度 */
 #define ATK_MO1218_NMEA_ADDRESS_LEN     5
 
+/* ATK-MO1218模块NMEA消息解析函数类型 */
+typedef uint8_t (*atk_mo1218_nmea_decoder_t)(uint8_t *msg, atk_mo1218_nmea_decode_msg_t *decode_msg);
+
+/* 为每个解析结果类别生成统一接口的解析函数 */
+#define ATK_MO1218_NMEA_DECODER_DEFINE(kind)                                                        \
+static uint8_t atk_mo1218_decode_nmea_##kind(uint8_t *msg, atk_mo1218_nmea_decode_msg_t *decode_msg) \
+{                                                                                                   \
+    return atk_mo1218_decode_nmea_xx##kind(msg, &decode_msg->kind);                                 \
+}
+ATK_MO1218_NMEA_DECODER_TABLE(ATK_MO1218_NMEA_DECODER_DEFINE)
+#undef ATK_MO1218_NMEA_DECODER_DEFINE
+
+/* ATK-MO1218模块NMEA消息字段类型枚举 */
+typedef enum
+{
+    ATK_MO1218_NMEA_FIELD_TIME = 0x00,              /* UTC时间（atk_mo1218_utc_time_t） */
+    ATK_MO1218_NMEA_FIELD_DATE,                     /* UTC日期，格式为ddmmyy（atk_mo1218_utc_date_t） */
+    ATK_MO1218_NMEA_FIELD_LATITUDE,                 /* 纬度及后一字段的北纬南纬指示（atk_mo1218_latitude_t） */
+    ATK_MO1218_NMEA_FIELD_LONGITUDE,                /* 经度及后一字段的东经西经指示（atk_mo1218_longitude_t） */
+    ATK_MO1218_NMEA_FIELD_UINT,                     /* 非负定点数 */
+    ATK_MO1218_NMEA_FIELD_INT,                      /* 定点数 */
+    ATK_MO1218_NMEA_FIELD_ENUM,                     /* 以单个字符表示的枚举值 */
+    ATK_MO1218_NMEA_FIELD_CHAR,                     /* 单个字符 */
+    ATK_MO1218_NMEA_FIELD_STRING,                   /* 字符串（以'\0'结尾） */
+} atk_mo1218_nmea_field_type_t;
+
+/* ATK-MO1218模块NMEA消息枚举字段的取值表枚举 */
+typedef enum
+{
+    ATK_MO1218_NMEA_ENUM_GPS_QUALITY = 0x00,        /* atk_mo1218_gps_quality_indicator_t */
+    ATK_MO1218_NMEA_ENUM_XXGLL_STATUS,              /* atk_mo1218_xxgll_status_t */
+    ATK_MO1218_NMEA_ENUM_OPERATION_MODE,            /* atk_mo1218_gps_operation_mode_t */
+    ATK_MO1218_NMEA_ENUM_FIX_TYPE,                  /* atk_mo1218_fix_type_t */
+    ATK_MO1218_NMEA_ENUM_NAVIGATION_STATUS,         /* atk_mo1218_navigation_data_status_t */
+    ATK_MO1218_NMEA_ENUM_POS_SYS_MODE,              /* atk_mo1218_pos_sys_mode_t */
+} atk_mo1218_nmea_enum_t;
+
+/* ATK-MO1218模块NMEA消息枚举字段的取值表（按atk_mo1218_nmea_enum_t排列），字符在表中的位置即为枚举值 */
+static const char *const g_nmea_enum_map[] = {
+    "012",                                          /* 定位不可用、SPS模式、差分GPS模式 */
+    "AV",                                           /* 数据有效、数据不可用 */
+    "MA",                                           /* 手动、自动 */
+    "123",                                          /* 未定位、2D、3D */
+    "VA",                                           /* 导航数据无效、导航数据有效 */
+    "NADE",                                         /* 数据无效、自主定位、差分、估算 */
+};
+
+/* ATK-MO1218模块NMEA消息字段描述结构体 */
+typedef struct
+{
+    uint8_t index;                                  /* 字段索引（地址段为0） */
+    uint8_t type;                                   /* 字段类型，见atk_mo1218_nmea_field_type_t */
+    uint8_t param;                                  /* 定点数放大后的小数位数，或枚举字段的取值表，见atk_mo1218_nmea_enum_t */
+    uint8_t optional;                               /* 字段可以为空 */
+    uint8_t size;                                   /* 解析结果的大小（字符串为缓冲的大小） */
+    uint16_t offset;                                /* 解析结果在消息结构体中的偏移 */
+} atk_mo1218_nmea_field_desc_t;
+
+/* ATK-MO1218模块按字段表解析的NMEA消息描述结构体 */
+typedef struct
+{
+    atk_mo1218_nmea_msg_t nmea;                     /* NMEA消息类型 */
+    const atk_mo1218_nmea_field_desc_t *field;      /* 字段表，为NULL时不按字段表解析 */
+    uint8_t field_num;                              /* 字段表中的字段数量 */
+    uint16_t size;                                  /* 消息结构体的大小 */
+    uint16_t talker_offset;                         /* 发送者在消息结构体中的偏移 */
+    uint16_t valid_offset;                          /* 有效字段掩码在消息结构体中的偏移 */
+} atk_mo1218_nmea_layout_t;
+
+/* 定义字段表中的一行（字段索引, 字段类型, 小数位数或取值表, 可以为空, 消息结构体类型, 成员） */
+#define ATK_MO1218_NMEA_FIELD_DESC(index, type, param, optional, msg_type, member)                  \
+    {(index), ATK_MO1218_NMEA_FIELD_##type, (param), (optional), sizeof(((msg_type *)0)->member), offsetof(msg_type, member)}
+
+/* 定义解析结果类别对应的消息描述，字段表须命名为g_nmea_<类别>_field */
+#define ATK_MO1218_NMEA_LAYOUT_DEFINE(name, kind)                                                   \
+static const atk_mo1218_nmea_layout_t g_nmea_##kind##_layout = {                                    \
+    ATK_MO1218_NMEA_MSG_##name,                                                                     \
+    g_nmea_##kind##_field,                                                                          \
+    sizeof(g_nmea_##kind##_field) / sizeof(g_nmea_##kind##_field[0]),                               \
+    sizeof(atk_mo1218_nmea_##kind##_msg_t),                                                         \
+    offsetof(atk_mo1218_nmea_##kind##_msg_t, talker),                                               \
+    offsetof(atk_mo1218_nmea_##kind##_msg_t, valid),                                                \
+}
+
+/* $XXGGA消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gga_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_gga_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, LATITUDE,  0, 1, atk_mo1218_nmea_gga_msg_t, latitude),                                  /* Latitude, N/S Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, LONGITUDE, 0, 1, atk_mo1218_nmea_gga_msg_t, longitude),                                 /* Longitude, E/W Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, ENUM,      ATK_MO1218_NMEA_ENUM_GPS_QUALITY, 0, atk_mo1218_nmea_gga_msg_t, gps_quality), /* GPS quality indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, UINT,      0, 0, atk_mo1218_nmea_gga_msg_t, satellite_num),                             /* Satellites Used */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, UINT,      1, 1, atk_mo1218_nmea_gga_msg_t, hdop),                                      /* HDOP */
+    ATK_MO1218_NMEA_FIELD_DESC( 9, INT,       1, 1, atk_mo1218_nmea_gga_msg_t, altitude),                                  /* Altitude */
+    ATK_MO1218_NMEA_FIELD_DESC(11, INT,       1, 1, atk_mo1218_nmea_gga_msg_t, geoidal_separation),                        /* Geoidal Separation */
+    ATK_MO1218_NMEA_FIELD_DESC(14, UINT,      0, 1, atk_mo1218_nmea_gga_msg_t, dgps_id),                                   /* DGPS Station ID */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GGA, gga);
+
+/* $XXGLL消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gll_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, LATITUDE,  0, 1, atk_mo1218_nmea_gll_msg_t, latitude),                                  /* Latitude, N/S Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, LONGITUDE, 0, 1, atk_mo1218_nmea_gll_msg_t, longitude),                                 /* Longitude, E/W Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, TIME,      0, 0, atk_mo1218_nmea_gll_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, ENUM,      ATK_MO1218_NMEA_ENUM_XXGLL_STATUS, 0, atk_mo1218_nmea_gll_msg_t, status),    /* Status */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GLL, gll);
+
+/* $XXGSA消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gsa_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, ENUM,      ATK_MO1218_NMEA_ENUM_OPERATION_MODE, 0, atk_mo1218_nmea_gsa_msg_t, mode),    /* Mode */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, ENUM,      ATK_MO1218_NMEA_ENUM_FIX_TYPE, 0, atk_mo1218_nmea_gsa_msg_t, type),          /* Fix type */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[0]),                           /* Satellite ID */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[1]),
+    ATK_MO1218_NMEA_FIELD_DESC( 5, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[2]),
+    ATK_MO1218_NMEA_FIELD_DESC( 6, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[3]),
+    ATK_MO1218_NMEA_FIELD_DESC( 7, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[4]),
+    ATK_MO1218_NMEA_FIELD_DESC( 8, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[5]),
+    ATK_MO1218_NMEA_FIELD_DESC( 9, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[6]),
+    ATK_MO1218_NMEA_FIELD_DESC(10, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[7]),
+    ATK_MO1218_NMEA_FIELD_DESC(11, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[8]),
+    ATK_MO1218_NMEA_FIELD_DESC(12, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[9]),
+    ATK_MO1218_NMEA_FIELD_DESC(13, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[10]),
+    ATK_MO1218_NMEA_FIELD_DESC(14, UINT,      0, 1, atk_mo1218_nmea_gsa_msg_t, satellite_id[11]),
+    ATK_MO1218_NMEA_FIELD_DESC(15, UINT,      1, 1, atk_mo1218_nmea_gsa_msg_t, pdop),                                      /* PDOP */
+    ATK_MO1218_NMEA_FIELD_DESC(16, UINT,      1, 1, atk_mo1218_nmea_gsa_msg_t, hdop),                                      /* HDOP */
+    ATK_MO1218_NMEA_FIELD_DESC(17, UINT,      1, 1, atk_mo1218_nmea_gsa_msg_t, vdop),                                      /* VDOP */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GSA, gsa);
+
+/* GSV消息由多条语句组成，不按字段表解析，见atk_mo1218_decode_nmea_xxgsv_part() */
+static const atk_mo1218_nmea_layout_t g_nmea_gsv_layout = {ATK_MO1218_NMEA_MSG_GSV, NULL, 0, 0, 0, 0};
+
+/* $XXRMC消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_rmc_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_rmc_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, ENUM,      ATK_MO1218_NMEA_ENUM_NAVIGATION_STATUS, 0, atk_mo1218_nmea_rmc_msg_t, status), /* Status */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, LATITUDE,  0, 1, atk_mo1218_nmea_rmc_msg_t, latitude),                                  /* Latitude, N/S Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, LONGITUDE, 0, 1, atk_mo1218_nmea_rmc_msg_t, longitude),                                 /* Longitude, E/W Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, UINT,      1, 1, atk_mo1218_nmea_rmc_msg_t, speed_ground),                              /* Speed over ground */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, UINT,      1, 1, atk_mo1218_nmea_rmc_msg_t, course_ground),                             /* Course over ground */
+    ATK_MO1218_NMEA_FIELD_DESC( 9, DATE,      0, 1, atk_mo1218_nmea_rmc_msg_t, utc_date),                                  /* UTC Date */
+    ATK_MO1218_NMEA_FIELD_DESC(12, ENUM,      ATK_MO1218_NMEA_ENUM_POS_SYS_MODE, 1, atk_mo1218_nmea_rmc_msg_t, position_system_mode), /* Mode indicator */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(RMC, rmc);
+
+/* $XXVTG消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_vtg_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, UINT,      1, 1, atk_mo1218_nmea_vtg_msg_t, course_true),                               /* Course (true) */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, UINT,      1, 1, atk_mo1218_nmea_vtg_msg_t, course_magnetic),                           /* Course (magnetic) */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, UINT,      1, 1, atk_mo1218_nmea_vtg_msg_t, speed_knots),                               /* Speed (knots) */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, UINT,      1, 1, atk_mo1218_nmea_vtg_msg_t, speed_kph),                                 /* Speed (km/h) */
+    ATK_MO1218_NMEA_FIELD_DESC( 9, ENUM,      ATK_MO1218_NMEA_ENUM_POS_SYS_MODE, 1, atk_mo1218_nmea_vtg_msg_t, position_system_mode), /* Mode */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(VTG, vtg);
+
+/* $XXZDA消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_zda_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_zda_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, UINT,      0, 1, atk_mo1218_nmea_zda_msg_t, utc_date.day),                              /* UTC day */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, UINT,      0, 1, atk_mo1218_nmea_zda_msg_t, utc_date.month),                            /* UTC month */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, UINT,      0, 1, atk_mo1218_nmea_zda_msg_t, utc_date.year),                             /* UTC year */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, INT,       0, 1, atk_mo1218_nmea_zda_msg_t, local_zone_hour),                           /* Local zone hours */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, UINT,      0, 1, atk_mo1218_nmea_zda_msg_t, local_zone_minute),                         /* Local zone mintues */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(ZDA, zda);
+
+/* $XXGNS消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gns_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_gns_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, LATITUDE,  0, 1, atk_mo1218_nmea_gns_msg_t, latitude),                                  /* Latitude, N/S Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, LONGITUDE, 0, 1, atk_mo1218_nmea_gns_msg_t, longitude),                                 /* Longitude, E/W Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, STRING,    0, 0, atk_mo1218_nmea_gns_msg_t, mode),       /* Mode Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, UINT,      0, 0, atk_mo1218_nmea_gns_msg_t, satellite_num),                             /* Satellites Used */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, UINT,      1, 1, atk_mo1218_nmea_gns_msg_t, hdop),                                      /* HDOP */
+    ATK_MO1218_NMEA_FIELD_DESC( 9, INT,       1, 1, atk_mo1218_nmea_gns_msg_t, altitude),                                  /* Altitude */
+    ATK_MO1218_NMEA_FIELD_DESC(10, INT,       1, 1, atk_mo1218_nmea_gns_msg_t, geoidal_separation),                        /* Geoidal Separation */
+    ATK_MO1218_NMEA_FIELD_DESC(11, UINT,      1, 1, atk_mo1218_nmea_gns_msg_t, dgps_age),                                  /* Age of Differential Data */
+    ATK_MO1218_NMEA_FIELD_DESC(12, UINT,      0, 1, atk_mo1218_nmea_gns_msg_t, dgps_id),                                   /* DGPS Station ID */
+    ATK_MO1218_NMEA_FIELD_DESC(13, CHAR,      0, 1, atk_mo1218_nmea_gns_msg_t, navigation_status),                         /* Navigational Status */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GNS, gns);
+
+/* $XXGBS消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gbs_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_gbs_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, INT,       2, 1, atk_mo1218_nmea_gbs_msg_t, latitude_error),                            /* Expected Error in Latitude */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, INT,       2, 1, atk_mo1218_nmea_gbs_msg_t, longitude_error),                           /* Expected Error in Longitude */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, INT,       2, 1, atk_mo1218_nmea_gbs_msg_t, altitude_error),                            /* Expected Error in Altitude */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, UINT,      0, 1, atk_mo1218_nmea_gbs_msg_t, satellite_id),                              /* ID of Most Likely Failed Satellite */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, UINT,      3, 1, atk_mo1218_nmea_gbs_msg_t, probability),                               /* Probability of Missed Detection */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, INT,       2, 1, atk_mo1218_nmea_gbs_msg_t, bias),                                      /* Estimate of Bias */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, INT,       2, 1, atk_mo1218_nmea_gbs_msg_t, bias_deviation),                            /* Standard Deviation of Bias */
+    ATK_MO1218_NMEA_FIELD_DESC( 9, CHAR,      0, 1, atk_mo1218_nmea_gbs_msg_t, system_id),                                 /* GNSS System ID */
+    ATK_MO1218_NMEA_FIELD_DESC(10, CHAR,      0, 1, atk_mo1218_nmea_gbs_msg_t, signal_id),                                 /* Signal ID */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GBS, gbs);
+
+/* $XXGRS消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_grs_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_grs_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, UINT,      0, 0, atk_mo1218_nmea_grs_msg_t, mode),                                      /* Mode */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[0]),                               /* Range Residual */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[1]),
+    ATK_MO1218_NMEA_FIELD_DESC( 5, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[2]),
+    ATK_MO1218_NMEA_FIELD_DESC( 6, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[3]),
+    ATK_MO1218_NMEA_FIELD_DESC( 7, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[4]),
+    ATK_MO1218_NMEA_FIELD_DESC( 8, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[5]),
+    ATK_MO1218_NMEA_FIELD_DESC( 9, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[6]),
+    ATK_MO1218_NMEA_FIELD_DESC(10, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[7]),
+    ATK_MO1218_NMEA_FIELD_DESC(11, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[8]),
+    ATK_MO1218_NMEA_FIELD_DESC(12, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[9]),
+    ATK_MO1218_NMEA_FIELD_DESC(13, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[10]),
+    ATK_MO1218_NMEA_FIELD_DESC(14, INT,       2, 1, atk_mo1218_nmea_grs_msg_t, residual[11]),
+    ATK_MO1218_NMEA_FIELD_DESC(15, CHAR,      0, 1, atk_mo1218_nmea_grs_msg_t, system_id),                                 /* GNSS System ID */
+    ATK_MO1218_NMEA_FIELD_DESC(16, CHAR,      0, 1, atk_mo1218_nmea_grs_msg_t, signal_id),                                 /* Signal ID */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GRS, grs);
+
+/* $XXDTM消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_dtm_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, STRING,    0, 0, atk_mo1218_nmea_dtm_msg_t, datum),         /* Local Datum Code */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, STRING,    0, 1, atk_mo1218_nmea_dtm_msg_t, sub_datum),     /* Local Datum Subdivision Code */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, INT,       4, 1, atk_mo1218_nmea_dtm_msg_t, latitude_offset),                           /* Latitude Offset */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, CHAR,      0, 1, atk_mo1218_nmea_dtm_msg_t, latitude_indicator),                        /* N/S Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, INT,       4, 1, atk_mo1218_nmea_dtm_msg_t, longitude_offset),                          /* Longitude Offset */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, CHAR,      0, 1, atk_mo1218_nmea_dtm_msg_t, longitude_indicator),                       /* E/W Indicator */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, INT,       2, 1, atk_mo1218_nmea_dtm_msg_t, altitude_offset),                           /* Altitude Offset */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, STRING,    0, 1, atk_mo1218_nmea_dtm_msg_t, reference_datum), /* Reference Datum Code */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(DTM, dtm);
+
+/* $XXGST消息字段表 */
+static const atk_mo1218_nmea_field_desc_t g_nmea_gst_field[] = {
+    ATK_MO1218_NMEA_FIELD_DESC( 1, TIME,      0, 0, atk_mo1218_nmea_gst_msg_t, utc_time),                                  /* UTC Time */
+    ATK_MO1218_NMEA_FIELD_DESC( 2, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, rms),                                       /* RMS Value of Pseudorange Residuals */
+    ATK_MO1218_NMEA_FIELD_DESC( 3, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, semi_major_deviation),                      /* Error Ellipse Semi-major Axis */
+    ATK_MO1218_NMEA_FIELD_DESC( 4, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, semi_minor_deviation),                      /* Error Ellipse Semi-minor Axis */
+    ATK_MO1218_NMEA_FIELD_DESC( 5, UINT,      1, 1, atk_mo1218_nmea_gst_msg_t, orientation),                               /* Error Ellipse Orientation */
+    ATK_MO1218_NMEA_FIELD_DESC( 6, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, latitude_deviation),                        /* Latitude Error */
+    ATK_MO1218_NMEA_FIELD_DESC( 7, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, longitude_deviation),                       /* Longitude Error */
+    ATK_MO1218_NMEA_FIELD_DESC( 8, INT,       2, 1, atk_mo1218_nmea_gst_msg_t, altitude_deviation),                        /* Altitude Error */
+};
+ATK_MO1218_NMEA_LAYOUT_DEFINE(GST, gst);
+
+/* ATK-MO1218模块NMEA消息注册信息（按atk_mo1218_nmea_msg_t排列） */
+static const struct
+{
+    const char *address;                            /* 语句ID */
+    atk_mo1218_nmea_decoder_t decode;               /* 解析函数 */
+    const atk_mo1218_nmea_layout_t *layout;         /* 按字段解析使用的消息描述 */
+} g_nmea_msg_registry[ATK_MO1218_NMEA_MSG_NUM] = {
+#define ATK_MO1218_NMEA_MSG_REGISTRY(name, s0, s1, s2, kind)    {#name, atk_mo1218_decode_nmea_##kind, &g_nmea_##kind##_layout},
+    ATK_MO1218_NMEA_MSG_TABLE(ATK_MO1218_NMEA_MSG_REGISTRY)
+#undef ATK_MO1218_NMEA_MSG_REGISTRY
+};
+
 /**
- * @brief       获取NMEA消息中指定索引的数据参数
- * @param       nmea           : NMEA消息
- *              parameter_index: 参数的索引
- *              parameter      : 返回的参数（指向NMEA消息中的数据）
- *              parameter_len  : 参数的长度
- * @retval      ATK_MO1218_EOK   : 成功获取NMEA消息中指定索引的数据参数
- *              ATK_MO1218_ERROR : NMEA消息中找不到指定索引的数据参数
- *              ATK_MO1218_EINVAL: 函数参数错误
+ * @brief       将十六进制字符转换为数值
+ * @param       ch : 十六进制字符
+ *              num: 转换后的数值
+ * @retval      ATK_MO1218_EOK  : 转换成功
+ *              ATK_MO1218_ERROR: 不是十六进制字符
  */
-static uint8_t atk_mo1218_decode_nmea_parameter(uint8_t *nmea, uint8_t parameter_index, uint8_t **parameter, uint16_t *parameter_len)
+static uint8_t atk_mo1218_nmea_hex2num(uint8_t ch, uint8_t *num)
 {
-    uint8_t *nmea_point;
-    uint16_t parameter_counter = 0;
-    
-    if (nmea == NULL)
+    if ((ch >= '0') && (ch <= '9'))
     {
-        return ATK_MO1218_EINVAL;
+        *num = ch - '0';
+    }
+    else if ((ch >= 'A') && (ch <= 'F'))
+    {
+        *num = ch - 'A' + 10;
+    }
+    else if ((ch >= 'a') && (ch <= 'f'))
+    {
+        *num = ch - 'a' + 10;
+    }
+    else
+    {
+        *num = 0;
+        return ATK_MO1218_ERROR;
     }
     
-    if (*parameter == NULL)
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       扫描一次NMEA消息，建立字段表
+ * @note        扫描的同时计算校验和，消息必须带有校验和（*hh）并校验通过
+ * @param       nmea  : NMEA消息（以'$'开头）
+ *              fields: 字段表，记录每个字段相对于'$'的偏移和长度
+ * @retval      ATK_MO1218_EOK   : 建立字段表成功
+ *              ATK_MO1218_ERROR : NMEA消息不完整、字段过多、没有校验和或校验和错误
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_nmea_tokenize(uint8_t *nmea, atk_mo1218_nmea_fields_t *fields)
+{
+    uint8_t nmea_index;
+    uint8_t field_start = 1;
+    uint8_t checksum = 0;
+    uint8_t checksum_h;
+    uint8_t checksum_l;
+    
+    if ((nmea == NULL) || (fields == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    for (nmea_point=(nmea+1);(*nmea_point!=0x0D)&&(*(nmea_point+1)!=0x0A); nmea_point++)
+    fields->num = 0;
+    
+    for (nmea_index=1; nmea_index!=0; nmea_index++)
     {
-        if (parameter_index == 0)
+        switch (nmea[nmea_index])
         {
-            *parameter = nmea_point - parameter_counter;
-            
-            if (parameter_len == NULL)
+            case ',':
+            case '*':
+            case '\r':
             {
-                break;
+                if (fields->num == ATK_MO1218_NMEA_FIELD_MAX)
+                {
+                    return ATK_MO1218_ERROR;
+                }
+                fields->field[fields->num].offset = field_start;
+                fields->field[fields->num].len = nmea_index - field_start;
+                fields->num++;
+                field_start = nmea_index + 1;
+                
+                if (nmea[nmea_index] == ',')
+                {
+                    checksum ^= ',';
+                    break;
+                }
+                
+                /* 校验和，与atk_mo1218_nmea_stream_input()一致，没有校验和的消息视为不完整 */
+                if ((nmea[nmea_index] != '*') ||
+                    (atk_mo1218_nmea_hex2num(nmea[nmea_index + 1], &checksum_h) != ATK_MO1218_EOK) ||
+                    (atk_mo1218_nmea_hex2num(nmea[nmea_index + 2], &checksum_l) != ATK_MO1218_EOK) ||
+                    (((checksum_h << 4) | checksum_l) != checksum))
+                {
+                    return ATK_MO1218_ERROR;
+                }
+                
+                return ATK_MO1218_EOK;
             }
-            
-            if ((*nmea_point != ',') && (*nmea_point != '*'))
+            case '\0':
+            case '\n':
+            case '$':
             {
-                parameter_counter++;
-                continue;
+                return ATK_MO1218_ERROR;
             }
-            else
+            default:
             {
-                *parameter_len = parameter_counter;
+                checksum ^= nmea[nmea_index];
                 break;
             }
         }
-        
-        if ((*nmea_point == ',') || (*nmea_point == '*'))
-        {
-            parameter_index--;
-        }
     }
     
-    if (parameter_index != 0)
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       从字段表中获取NMEA消息中指定索引的数据参数
+ * @param       nmea           : NMEA消息
+ *              fields         : atk_mo1218_nmea_tokenize()建立的字段表
+ *              parameter_index: 参数的索引
+ *              parameter      : 返回的参数（指向NMEA消息中的数据）
+ *              parameter_len  : 参数的长度
+ * @retval      ATK_MO1218_EOK   : 成功获取NMEA消息中指定索引的数据参数
+ *              ATK_MO1218_ERROR : NMEA消息中找不到指定索引的数据参数
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+static uint8_t atk_mo1218_decode_nmea_parameter(uint8_t *nmea, atk_mo1218_nmea_fields_t *fields, uint8_t parameter_index, uint8_t **parameter, uint16_t *parameter_len)
+{
+    if ((nmea == NULL) || (fields == NULL) || (parameter == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (parameter_index >= fields->num)
     {
         return ATK_MO1218_ERROR;
     }
     
+    *parameter = nmea + fields->field[parameter_index].offset;
+    if (parameter_len != NULL)
+    {
+        *parameter_len = fields->field[parameter_index].len;
+    }
+    
     return ATK_MO1218_EOK;
 }
 
@@ -196,421 +516,616 @@ static uint8_t atk_mo1218_nmea_str2num(uint8_t *str, int32_t *num, uint8_t *floa
 }
 
 /**
- * @brief       从数据缓冲中获取指定类型和索引的NMEA消息
- * @param       buf      : 数据缓冲
- *              nmea     : 指定获取的NMEA消息类型
- *              msg_index: 指定获取的NMEA消息类型在数据缓冲中的指定索引
- *                              0: 获取数据缓冲中第一个指定NMEA消息类型的消息
- *                              1: 获取数据缓冲中第一个指定NMEA消息类型的消息
- *                              2: 获取数据缓冲中第二个指定NMEA消息类型的消息
- *                              3: 获取数据缓冲中第三个指定NMEA消息类型的消息
- *                              以此类推......
- *              msg      : 获取到的NMEA消息（指向数据缓冲中的数据）
- * @retval      ATK_MO1218_EOK   : 成功从数据缓冲中获取到指定类型和索引的NMEA消息
- *              ATK_MO1218_ERROR : 数据缓冲中找不到指定类型或索引的NMEA消息
- *              ATK_MO1218_EINVAL: 函数参数错误
+ * @brief       计算NMEA消息地址段的整数键
+ * @param       address: 地址段（不含'$'）
+ *              key    : 地址段整数键
+ * @retval      ATK_MO1218_EOK  : 计算成功
+ *              ATK_MO1218_ERROR: 地址段包含无效字符或不完整
  */
-uint8_t atk_mo1218_get_nmea_msg_from_buf(uint8_t *buf, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg)
+static uint8_t atk_mo1218_nmea_address2key(uint8_t *address, uint32_t *key)
 {
-    char address[ATK_MO1218_NMEA_ADDRESS_LEN + 1];
-    uint8_t *buf_point;
     uint8_t address_index;
     
-    if ((buf == NULL) || (msg == NULL))
+    *key = 0;
+    for (address_index=0; address_index<ATK_MO1218_NMEA_ADDRESS_LEN; address_index++)
+    {
+        if ((address[address_index] < 0x20) || (address[address_index] > 0x5F))
+        {
+            return ATK_MO1218_ERROR;
+        }
+        *key = (*key << 6) | ATK_MO1218_NMEA_KEY_CHAR(address[address_index]);
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       根据地址段获取NMEA消息类型和发送者
+ * @note        地址段压缩为整数键后直接分支，无需字符串比较，
+ *              发送者ID与语句ID分别查找，未知的发送者ID不影响语句类型的识别
+ * @param       address: 地址段（不含'$'）
+ *              talker : 发送者（星座），可为NULL
+ *              nmea   : NMEA消息类型
+ * @retval      ATK_MO1218_EOK   : 获取成功
+ *              ATK_MO1218_ERROR : 未知的NMEA消息类型
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_nmea_msg_type(uint8_t *address, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea)
+{
+    uint32_t key;
+    
+    if ((address == NULL) || (nmea == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    if (msg_index == 0)
+    if (atk_mo1218_nmea_address2key(address, &key) != ATK_MO1218_EOK)
     {
-        msg_index = 1;
+        return ATK_MO1218_ERROR;
     }
     
-    switch (nmea)
+    switch (ATK_MO1218_NMEA_KEY_SENTENCE(key))
     {
-        case ATK_MO1218_NMEA_MSG_GNGGA:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNGGA);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GNGLL:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNGLL);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GNGSA:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNGSA);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GPGSA:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GPGSA);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_BDGSA:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_BDGSA);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GPGSV:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GPGSV);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_BDGSV:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_BDGSV);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GNRMC:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNRMC);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GNVTG:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNVTG);
-            break;
-        }
-        case ATK_MO1218_NMEA_MSG_GNZDA:
-        {
-            sprintf(address, ATK_MO1218_NMEA_ADDRESS_GNZDA);
-            break;
-        }
+#define ATK_MO1218_NMEA_MSG_CASE(name, s0, s1, s2, kind)    case ATK_MO1218_NMEA_SENTENCE_KEY(s0, s1, s2): *nmea = ATK_MO1218_NMEA_MSG_##name; break;
+        ATK_MO1218_NMEA_MSG_TABLE(ATK_MO1218_NMEA_MSG_CASE)
+#undef ATK_MO1218_NMEA_MSG_CASE
         default:
         {
-            return ATK_MO1218_EINVAL;
+            return ATK_MO1218_ERROR;
         }
     }
     
-    /* 遍历数据缓冲 */
-    for (buf_point=buf; *buf_point!='\0'; buf_point++)
+    if (talker != NULL)
     {
-        /* 找到句首（'$'：0x24） */
-        if (*buf_point == ATK_MO1218_NMEA_MSG_SS)
+        switch (ATK_MO1218_NMEA_KEY_TALKER(key))
         {
-            /* 判断是否为指定类型的NMEA消息 */
-            for (address_index=0; address_index<ATK_MO1218_NMEA_ADDRESS_LEN; address_index++)
-            {
-                /* 若不是指定类型的NMEA消息，则退出去寻找下一个句首 */
-                if (*(buf_point+1+address_index) != address[address_index])
-                {
-                    break;
-                }
-            }
-            
-            if (address_index == ATK_MO1218_NMEA_ADDRESS_LEN)
+#define ATK_MO1218_NMEA_TALKER_CASE(t0, t1, constellation)  case ATK_MO1218_NMEA_TALKER_KEY(t0, t1): *talker = constellation; break;
+            ATK_MO1218_NMEA_TALKER_TABLE(ATK_MO1218_NMEA_TALKER_CASE)
+#undef ATK_MO1218_NMEA_TALKER_CASE
+            default:
             {
-                if (--msg_index == 0)
-                {
-                    *msg = buf_point;
-                    return ATK_MO1218_EOK;
-                }
+                *talker = ATK_MO1218_NMEA_TALKER_UNKNOWN;
+                break;
             }
         }
     }
     
-    return ATK_MO1218_ERROR;
+    return ATK_MO1218_EOK;
 }
 
 /**
- * @brief       解析$XXGGA类型的NMEA消息
- * @param       xxgga_msg : 待解析的$XXGGA类型NMEA消息
- *              decode_msg: 解析后的数据
- * @retval      ATK_MO1218_EOK   : 解析$XXGGA类型的NMEA消息成功
- *              ATK_MO1218_ERROR : 解析$XXGGA类型的NMEA消息失败
- *              ATK_MO1218_EINVAL: 函数参数错误
+ * @brief       获取NMEA消息类型对应的语句ID
+ * @param       nmea: NMEA消息类型
+ * @retval      NULL: 函数参数错误
+ *              其他: 语句ID字符串（如"GGA"）
  */
-uint8_t atk_mo1218_decode_nmea_xxgga(uint8_t *xxgga_msg, atk_mo1218_nmea_gga_msg_t *decode_msg)
+const char *atk_mo1218_get_nmea_msg_address(atk_mo1218_nmea_msg_t nmea)
 {
-    uint8_t ret;
-    uint8_t *parameter;
-    int32_t _num;
-    uint8_t float_len;
-    
-    if ((xxgga_msg == NULL) || (decode_msg == NULL))
+    if (nmea >= ATK_MO1218_NMEA_MSG_NUM)
     {
-        return ATK_MO1218_EINVAL;
+        return NULL;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxgga_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'G') || (parameter[3] != 'G') || (parameter[4] != 'A')))
-    {
-        return ATK_MO1218_EINVAL;
-    }
+    return g_nmea_msg_registry[nmea].address;
+}
+
+/**
+ * @brief       识别并解析一条NMEA消息
+ * @note        根据地址段查找注册表，调用对应的解析函数，任意发送者的消息使用同一解析函数
+ * @param       msg       : 待解析的NMEA消息（以'$'开头）
+ *              talker    : 识别出的发送者（星座），可为NULL
+ *              nmea      : 识别出的NMEA消息类型
+ *              decode_msg: 解析后的数据，按消息类型使用对应的成员
+ * @retval      ATK_MO1218_EOK   : 解析NMEA消息成功
+ *              ATK_MO1218_ERROR : 未知的NMEA消息类型或解析失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_msg(uint8_t *msg, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea, atk_mo1218_nmea_decode_msg_t *decode_msg)
+{
+    uint8_t ret;
     
-    /* UTC Time */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 3))
+    if ((msg == NULL) || (nmea == NULL) || (decode_msg == NULL) || (msg[0] != ATK_MO1218_NMEA_MSG_SS))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->utc_time.hour = (_num / 10000000) % 100;
-    decode_msg->utc_time.minute = (_num / 100000) % 100;
-    decode_msg->utc_time.second = (_num / 1000) % 100;
-    decode_msg->utc_time.millisecond = (_num / 1) % 1000;
     
-    /* Latitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 2, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
+    ret = atk_mo1218_get_nmea_msg_type(&msg[1], talker, nmea);
     if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->latitude.degree = (_num / 10000000) * 100000;
-    decode_msg->latitude.degree += ((_num % 10000000) / 60);
     
-    /* N/S Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxgga_msg, 3, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'N') && (parameter[0] != 'S')))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->latitude.indicator = (parameter[0] == 'N') ? ATK_MO1218_LATITUDE_NORTH : ATK_MO1218_LATITUDE_SOUTH;
+    return g_nmea_msg_registry[*nmea].decode(msg, decode_msg);
+}
+
+/**
+ * @brief       获取流式解析器中当前消息对应的接收计数
+ * @param       stream: NMEA消息流式解析器
+ * @retval      当前消息类型的接收计数，地址段不完整或类型未知时为unknown
+ */
+static atk_mo1218_nmea_counter_t *atk_mo1218_nmea_stream_counter(atk_mo1218_nmea_stream_t *stream)
+{
+    atk_mo1218_nmea_msg_t nmea;
     
-    /* Longitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 4, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if ((stream->len > ATK_MO1218_NMEA_ADDRESS_LEN) && (atk_mo1218_get_nmea_msg_type(&stream->buf[1], NULL, &nmea) == ATK_MO1218_EOK))
     {
-        return ATK_MO1218_ERROR;
+        return &stream->stats.msg[nmea];
     }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->longitude.degree = (_num / 10000000) * 100000;
-    decode_msg->longitude.degree += ((_num % 10000000) / 60);
     
-    /* E/W Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxgga_msg, 5, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'E') && (parameter[0] != 'W')))
+    return &stream->stats.unknown;
+}
+
+/**
+ * @brief       初始化NMEA消息流式解析器
+ * @param       stream: NMEA消息流式解析器
+ * @retval      无
+ */
+void atk_mo1218_nmea_stream_init(atk_mo1218_nmea_stream_t *stream)
+{
+    if (stream == NULL)
     {
-        return ATK_MO1218_ERROR;
+        return;
     }
-    decode_msg->longitude.indicator = (parameter[0] == 'E') ? ATK_MO1218_LONGITUDE_EAST : ATK_MO1218_LONGITUDE_WEST;
     
-    /* GPS quality indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxgga_msg, 6, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    stream->state = ATK_MO1218_NMEA_STREAM_WAIT_SS;
+    stream->len = 0;
+    stream->buf[0] = '\0';
+    memset(&stream->stats, 0, sizeof(stream->stats));
+}
+
+/**
+ * @brief       向NMEA消息流式解析器输入数据
+ * @note        数据可以任意长度分块输入，解析器在两次调用之间保存状态，
+ *              因此跨越两个接收块的消息也能被完整提取。
+ *              接收的同时计算校验和，校验失败的消息不会输出。
+ *              每提取到一条完整的消息（收到CR、LF）即返回，剩余数据需再次输入
+ * @param       stream  : NMEA消息流式解析器
+ *              dat     : 输入的数据
+ *              len     : 输入数据的长度
+ *              sentence: 提取到的完整NMEA消息（以'\0'结尾，下次调用前有效），
+ *                        未提取到时为NULL
+ * @retval      已处理的数据长度
+ */
+uint16_t atk_mo1218_nmea_stream_input(atk_mo1218_nmea_stream_t *stream, uint8_t *dat, uint16_t len, uint8_t **sentence)
+{
+    uint16_t dat_index;
+    uint8_t ch;
+    uint8_t num;
+    uint8_t valid;
+    
+    if ((stream == NULL) || (dat == NULL) || (sentence == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return 0;
     }
-    switch (_num)
+    
+    *sentence = NULL;
+    
+    for (dat_index=0; dat_index<len; dat_index++)
     {
-        case 0:
+        ch = dat[dat_index];
+        
+        /* 任何状态下收到句首都重新开始，未完成的消息被丢弃 */
+        if (ch == ATK_MO1218_NMEA_MSG_SS)
         {
-            decode_msg->gps_quality = ATK_MO1218_GPS_UNAVAILABLE;
-            break;
+            if (stream->state != ATK_MO1218_NMEA_STREAM_WAIT_SS)
+            {
+                atk_mo1218_nmea_stream_counter(stream)->truncated++;
+            }
+            stream->buf[0] = ch;
+            stream->len = 1;
+            stream->checksum = 0;
+            stream->state = ATK_MO1218_NMEA_STREAM_BODY;
+            continue;
         }
-        case 1:
+        
+        switch (stream->state)
         {
-            decode_msg->gps_quality = ATK_MO1218_GPS_VALID_SPS;
-            break;
+            case ATK_MO1218_NMEA_STREAM_BODY:
+            {
+                valid = ((ch >= 0x20) && (ch <= 0x7E));
+                if (ch == '*')
+                {
+                    stream->state = ATK_MO1218_NMEA_STREAM_CHECKSUM_H;
+                }
+                else
+                {
+                    stream->checksum ^= ch;
+                }
+                break;
+            }
+            case ATK_MO1218_NMEA_STREAM_CHECKSUM_H:
+            {
+                valid = (atk_mo1218_nmea_hex2num(ch, &num) == ATK_MO1218_EOK);
+                stream->checksum_recv = num << 4;
+                stream->state = ATK_MO1218_NMEA_STREAM_CHECKSUM_L;
+                break;
+            }
+            case ATK_MO1218_NMEA_STREAM_CHECKSUM_L:
+            {
+                valid = (atk_mo1218_nmea_hex2num(ch, &num) == ATK_MO1218_EOK);
+                stream->checksum_recv |= num;
+                stream->state = ATK_MO1218_NMEA_STREAM_CR;
+                break;
+            }
+            case ATK_MO1218_NMEA_STREAM_CR:
+            {
+                valid = (ch == '\r');
+                stream->state = ATK_MO1218_NMEA_STREAM_LF;
+                break;
+            }
+            case ATK_MO1218_NMEA_STREAM_LF:
+            {
+                valid = (ch == '\n');
+                break;
+            }
+            case ATK_MO1218_NMEA_STREAM_WAIT_SS:
+            default:
+            {
+                /* 句首之前的数据（如二进制消息）直接忽略 */
+                continue;
+            }
         }
-        case 2:
+        
+        /* 消息格式错误或超长，丢弃后重新等待句首 */
+        if ((valid == 0) || (stream->len >= ATK_MO1218_NMEA_SENTENCE_MAX_LEN))
         {
-            decode_msg->gps_quality = ATK_MO1218_GPS_VALID_DIFFERENTIAL;
-            break;
+            atk_mo1218_nmea_stream_counter(stream)->truncated++;
+            stream->state = ATK_MO1218_NMEA_STREAM_WAIT_SS;
+            continue;
         }
-        default:
-        {
-            return ATK_MO1218_ERROR;
+        
+        stream->buf[stream->len++] = ch;
+        
+        if (ch == '\n')
+        {
+            stream->buf[stream->len] = '\0';
+            stream->state = ATK_MO1218_NMEA_STREAM_WAIT_SS;
+            
+            /* 校验和错误，丢弃 */
+            if (stream->checksum != stream->checksum_recv)
+            {
+                atk_mo1218_nmea_stream_counter(stream)->bad_checksum++;
+                continue;
+            }
+            
+            atk_mo1218_nmea_stream_counter(stream)->ok++;
+            *sentence = stream->buf;
+            return dat_index + 1;
         }
     }
     
-    /* Satellites Used */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 7, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->satellite_num = _num;
+    return len;
+}
+
+/**
+ * @brief       检查NMEA消息地址段的类型，并获取发送者
+ * @param       address: 地址段（不含'$'）
+ *              nmea   : 期望的NMEA消息类型
+ *              talker : 发送者（星座）
+ * @retval      ATK_MO1218_EOK  : 地址段为期望的NMEA消息类型
+ *              ATK_MO1218_ERROR: 地址段不是期望的NMEA消息类型
+ */
+static uint8_t atk_mo1218_decode_nmea_address(uint8_t *address, atk_mo1218_nmea_msg_t nmea, atk_mo1218_nmea_talker_t *talker)
+{
+    atk_mo1218_nmea_msg_t _nmea;
     
-    /* HDOP */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 8, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if ((atk_mo1218_get_nmea_msg_type(address, talker, &_nmea) != ATK_MO1218_EOK) || (_nmea != nmea))
     {
         return ATK_MO1218_ERROR;
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->hdop = _num;
     
-    /* Altitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 9, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       遍历一次数据缓冲，建立NMEA消息目录
+ * @note        目录记录每种类型的每条消息相对于数据缓冲的偏移，
+ *              建立后通过atk_mo1218_nmea_dir_get()获取消息无需再扫描数据缓冲
+ * @param       buf: 数据缓冲（以'\0'结尾）
+ *              dir: NMEA消息目录
+ * @retval      ATK_MO1218_EOK   : 建立NMEA消息目录成功
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_nmea_dir_build(uint8_t *buf, atk_mo1218_nmea_dir_t *dir)
+{
+    uint8_t *buf_point;
+    atk_mo1218_nmea_talker_t talker;
+    atk_mo1218_nmea_msg_t nmea;
+    
+    if ((buf == NULL) || (dir == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->altitude = _num;
     
-    /* Geoidal Separation */
+    dir->buf = buf;
+    memset(dir->num, 0, sizeof(dir->num));
     
-    /* DGPS Station ID */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgga_msg, 14, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    /* 遍历数据缓冲 */
+    for (buf_point=buf; *buf_point!='\0'; buf_point++)
     {
-        return ATK_MO1218_ERROR;
+        /* 找到句首（'$'：0x24），记录其发送者、类型和偏移 */
+        if ((*buf_point == ATK_MO1218_NMEA_MSG_SS) && (atk_mo1218_get_nmea_msg_type(buf_point + 1, &talker, &nmea) == ATK_MO1218_EOK))
+        {
+            if (dir->num[nmea] < ATK_MO1218_NMEA_DIR_MSG_MAX)
+            {
+                dir->offset[nmea][dir->num[nmea]] = buf_point - buf;
+                dir->talker[nmea][dir->num[nmea]] = talker;
+                dir->num[nmea]++;
+            }
+            buf_point += ATK_MO1218_NMEA_ADDRESS_LEN;
+        }
     }
-    decode_msg->dgps_id = _num;
     
     return ATK_MO1218_EOK;
 }
 
 /**
- * @brief       解析$XXGLL类型的NMEA消息
- * @param       xxgll_msg : 待解析的$XXGLL类型NMEA消息
- *              decode_msg: 解析后的数据
- * @retval      ATK_MO1218_EOK   : 解析$XXGLL类型的NMEA消息成功
- *              ATK_MO1218_ERROR : 解析$XXGLL类型的NMEA消息失败
+ * @brief       从NMEA消息目录中获取指定发送者、类型和索引的NMEA消息
+ * @param       dir      : atk_mo1218_nmea_dir_build()建立的NMEA消息目录
+ *              talker   : 指定获取的发送者，ATK_MO1218_NMEA_TALKER_ANY表示任意发送者
+ *              nmea     : 指定获取的NMEA消息类型
+ *              msg_index: 指定获取的NMEA消息在该发送者、类型的消息中的索引
+ *                              0: 获取数据缓冲中第一个指定NMEA消息类型的消息
+ *                              1: 获取数据缓冲中第一个指定NMEA消息类型的消息
+ *                              2: 获取数据缓冲中第二个指定NMEA消息类型的消息
+ *                              以此类推......
+ *              msg      : 获取到的NMEA消息（指向数据缓冲中的数据）
+ * @retval      ATK_MO1218_EOK   : 成功获取到指定类型和索引的NMEA消息
+ *              ATK_MO1218_ERROR : 数据缓冲中找不到指定类型或索引的NMEA消息
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
-uint8_t atk_mo1218_decode_nmea_xxgll(uint8_t *xxgll_msg, atk_mo1218_nmea_gll_msg_t *decode_msg)
+uint8_t atk_mo1218_nmea_dir_get(atk_mo1218_nmea_dir_t *dir, atk_mo1218_nmea_talker_t talker, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg)
 {
-    uint8_t ret;
-    uint8_t *parameter;
-    int32_t _num;
-    uint8_t float_len;
+    uint8_t dir_index;
     
-    if ((xxgll_msg == NULL) || (decode_msg == NULL))
+    if ((dir == NULL) || (msg == NULL) || (nmea >= ATK_MO1218_NMEA_MSG_NUM))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxgll_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'G') || (parameter[3] != 'L') || (parameter[4] != 'L')))
+    if (msg_index == 0)
     {
-        return ATK_MO1218_EINVAL;
+        msg_index = 1;
     }
     
-    /* Latitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgll_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    /* 每种类型最多ATK_MO1218_NMEA_DIR_MSG_MAX条，只需比较发送者 */
+    for (dir_index=0; dir_index<dir->num[nmea]; dir_index++)
     {
-        return ATK_MO1218_ERROR;
+        if ((talker == ATK_MO1218_NMEA_TALKER_ANY) || (dir->talker[nmea][dir_index] == talker))
+        {
+            if (--msg_index == 0)
+            {
+                *msg = dir->buf + dir->offset[nmea][dir_index];
+                return ATK_MO1218_EOK;
+            }
+        }
     }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->latitude.degree = (_num / 10000000) * 100000;
-    decode_msg->latitude.degree += ((_num % 10000000) / 60);
     
-    /* N/S Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxgll_msg, 2, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'N') && (parameter[0] != 'S')))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->latitude.indicator = (parameter[0] == 'N') ? ATK_MO1218_LATITUDE_NORTH : ATK_MO1218_LATITUDE_SOUTH;
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       从数据缓冲中获取指定类型和索引的NMEA消息
+ * @note        每次调用都会扫描数据缓冲，需获取多条消息时应使用atk_mo1218_nmea_dir_build()
+ * @param       buf      : 数据缓冲
+ *              talker   : 指定获取的发送者，ATK_MO1218_NMEA_TALKER_ANY表示任意发送者
+ *              nmea     : 指定获取的NMEA消息类型
+ *              msg_index: 指定获取的NMEA消息在该发送者、类型的消息中的索引
+ *                              0: 获取数据缓冲中第一个指定NMEA消息类型的消息
+ *                              1: 获取数据缓冲中第一个指定NMEA消息类型的消息
+ *                              2: 获取数据缓冲中第二个指定NMEA消息类型的消息
+ *                              3: 获取数据缓冲中第三个指定NMEA消息类型的消息
+ *                              以此类推......
+ *              msg      : 获取到的NMEA消息（指向数据缓冲中的数据）
+ * @retval      ATK_MO1218_EOK   : 成功从数据缓冲中获取到指定类型和索引的NMEA消息
+ *              ATK_MO1218_ERROR : 数据缓冲中找不到指定类型或索引的NMEA消息
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_get_nmea_msg_from_buf(uint8_t *buf, atk_mo1218_nmea_talker_t talker, atk_mo1218_nmea_msg_t nmea, uint8_t msg_index, uint8_t **msg)
+{
+    uint8_t *buf_point;
+    atk_mo1218_nmea_talker_t _talker;
+    atk_mo1218_nmea_msg_t _nmea;
     
-    /* Longitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgll_msg, 3, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if ((buf == NULL) || (msg == NULL) || (nmea >= ATK_MO1218_NMEA_MSG_NUM))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->longitude.degree = (_num / 10000000) * 100000;
-    decode_msg->longitude.degree += ((_num % 10000000) / 60);
     
-    /* E/W Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxgll_msg, 4, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'E') && (parameter[0] != 'W')))
+    if (msg_index == 0)
     {
-        return ATK_MO1218_ERROR;
+        msg_index = 1;
     }
-    decode_msg->longitude.indicator = (parameter[0] == 'E') ? ATK_MO1218_LONGITUDE_EAST : ATK_MO1218_LONGITUDE_WEST;
     
-    /* UTC Time */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgll_msg, 5, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 3))
+    /* 遍历数据缓冲 */
+    for (buf_point=buf; *buf_point!='\0'; buf_point++)
     {
-        return ATK_MO1218_ERROR;
+        /* 找到句首（'$'：0x24），并判断是否为指定类型的NMEA消息 */
+        if ((*buf_point == ATK_MO1218_NMEA_MSG_SS) &&
+            (atk_mo1218_get_nmea_msg_type(buf_point + 1, &_talker, &_nmea) == ATK_MO1218_EOK) &&
+            (_nmea == nmea) && ((talker == ATK_MO1218_NMEA_TALKER_ANY) || (_talker == talker)))
+        {
+            if (--msg_index == 0)
+            {
+                *msg = buf_point;
+                return ATK_MO1218_EOK;
+            }
+        }
     }
-    decode_msg->utc_time.hour = (_num / 10000000) % 100;
-    decode_msg->utc_time.minute = (_num / 100000) % 100;
-    decode_msg->utc_time.second = (_num / 1000) % 100;
-    decode_msg->utc_time.millisecond = (_num / 1) % 1000;
     
-    /* Status */
-    ret = atk_mo1218_decode_nmea_parameter(xxgll_msg, 6, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'A') && (parameter[0] != 'V')))
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       按解析结果的大小保存整数
+ * @param       dest: 解析结果在消息结构体中的位置
+ *              size: 解析结果的大小，单位：字节
+ *              num : 待保存的整数
+ * @retval      无
+ */
+static void atk_mo1218_nmea_field_store(uint8_t *dest, uint8_t size, int32_t num)
+{
+    switch (size)
     {
-        return ATK_MO1218_ERROR;
+        case 1:
+        {
+            *dest = (uint8_t)num;
+            break;
+        }
+        case 2:
+        {
+            *(uint16_t *)dest = (uint16_t)num;
+            break;
+        }
+        default:
+        {
+            *(uint32_t *)dest = (uint32_t)num;
+            break;
+        }
     }
-    decode_msg->status = (parameter[0] == 'A') ? ATK_MO1218_XXGLL_DATA_VALID : ATK_MO1218_XXGLL_DATA_NO_VALID;
-    
-    return ATK_MO1218_EOK;
 }
 
 /**
- * @brief       解析$XXGSA类型的NMEA消息
- * @param       xxgsa_msg : 待解析的$XXGSA类型NMEA消息
- *              decode_msg: 解析后的数据
- * @retval      ATK_MO1218_EOK   : 解析$XXGSA类型的NMEA消息成功
- *              ATK_MO1218_ERROR : 解析$XXGSA类型的NMEA消息失败
- *              ATK_MO1218_EINVAL: 函数参数错误
+ * @brief       按字段描述解析NMEA消息中的一个非空字段
+ * @note        只在解析成功时写入解析结果
+ * @param       nmea  : NMEA消息
+ *              fields: atk_mo1218_nmea_tokenize()建立的字段表
+ *              desc  : 字段描述
+ *              dest  : 解析结果在消息结构体中的位置
+ * @retval      ATK_MO1218_EOK  : 解析字段成功
+ *              ATK_MO1218_ERROR: 字段格式错误或超出范围
  */
-uint8_t atk_mo1218_decode_nmea_xxgsa(uint8_t *xxgsa_msg, atk_mo1218_nmea_gsa_msg_t *decode_msg)
+static uint8_t atk_mo1218_decode_nmea_field(uint8_t *nmea, atk_mo1218_nmea_fields_t *fields, const atk_mo1218_nmea_field_desc_t *desc, uint8_t *dest)
 {
     uint8_t ret;
     uint8_t *parameter;
-    uint16_t parameter_len = 0;
+    uint16_t parameter_len;
+    uint8_t *indicator;
+    uint16_t indicator_len;
+    const char *map;
     int32_t _num;
     uint8_t float_len;
-    uint8_t satellite_index;
+    atk_mo1218_utc_time_t *utc_time;
+    atk_mo1218_utc_date_t *utc_date;
+    atk_mo1218_latitude_t *latitude;
+    atk_mo1218_longitude_t *longitude;
     
-    if ((xxgsa_msg == NULL) || (decode_msg == NULL))
+    ret = atk_mo1218_decode_nmea_parameter(nmea, fields, desc->index, &parameter, &parameter_len);
+    if (ret != ATK_MO1218_EOK)
     {
-        return ATK_MO1218_EINVAL;
+        return ATK_MO1218_ERROR;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'G') || (parameter[3] != 'S') || (parameter[4] != 'A')))
+    /* 字符、字符串和枚举字段不需要数字转换 */
+    switch (desc->type)
     {
-        return ATK_MO1218_EINVAL;
+        case ATK_MO1218_NMEA_FIELD_CHAR:
+        {
+            *dest = parameter[0];
+            return ATK_MO1218_EOK;
+        }
+        case ATK_MO1218_NMEA_FIELD_STRING:
+        {
+            if (parameter_len >= desc->size)
+            {
+                return ATK_MO1218_ERROR;
+            }
+            memcpy(dest, parameter, parameter_len);
+            dest[parameter_len] = '\0';
+            return ATK_MO1218_EOK;
+        }
+        case ATK_MO1218_NMEA_FIELD_ENUM:
+        {
+            map = strchr(g_nmea_enum_map[desc->param], parameter[0]);
+            if ((parameter_len != 1) || (map == NULL))
+            {
+                return ATK_MO1218_ERROR;
+            }
+            atk_mo1218_nmea_field_store(dest, desc->size, map - g_nmea_enum_map[desc->param]);
+            return ATK_MO1218_EOK;
+        }
+        default:
+        {
+            break;
+        }
     }
     
-    /* Mode */
-    ret = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 1, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'M') && (parameter[0] != 'A')))
+    ret = atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
+    if (ret != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
-    decode_msg->mode = (parameter[0] == 'M') ? ATK_MO1218_GPS_OPERATING_MANUAL : ATK_MO1218_GPS_OPERATING_AUTOMATIC;
     
-    /* Fix type */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 2, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    switch (desc->type)
     {
-        return ATK_MO1218_ERROR;
-    }
-    switch (_num)
-    {
-        case 1:
+        case ATK_MO1218_NMEA_FIELD_TIME:
         {
-            decode_msg->type = ATK_MO1218_FIX_NOT_AVAILABLE;
+            atk_mo1218_fit_num(&_num, float_len, 3);
+            utc_time = (atk_mo1218_utc_time_t *)dest;
+            utc_time->hour = (_num / 10000000) % 100;
+            utc_time->minute = (_num / 100000) % 100;
+            utc_time->second = (_num / 1000) % 100;
+            utc_time->millisecond = (_num / 1) % 1000;
             break;
         }
-        case 2:
+        case ATK_MO1218_NMEA_FIELD_DATE:
+        {
+            if (float_len != 0)
+            {
+                return ATK_MO1218_ERROR;
+            }
+            utc_date = (atk_mo1218_utc_date_t *)dest;
+            utc_date->year = (_num / 1) % 100 + 2000;
+            utc_date->month = (_num / 100) % 100;
+            utc_date->day = (_num / 10000) % 100;
+            break;
+        }
+        case ATK_MO1218_NMEA_FIELD_LATITUDE:
+        {
+            ret = atk_mo1218_decode_nmea_parameter(nmea, fields, desc->index + 1, &indicator, &indicator_len);
+            if ((ret != ATK_MO1218_EOK) || (indicator_len == 0) || ((indicator[0] != 'N') && (indicator[0] != 'S')))
+            {
+                return ATK_MO1218_ERROR;
+            }
+            atk_mo1218_fit_num(&_num, float_len, 5);
+            latitude = (atk_mo1218_latitude_t *)dest;
+            latitude->degree = (_num / 10000000) * 100000;
+            latitude->degree += ((_num % 10000000) / 60);
+            latitude->indicator = (indicator[0] == 'N') ? ATK_MO1218_LATITUDE_NORTH : ATK_MO1218_LATITUDE_SOUTH;
+            break;
+        }
+        case ATK_MO1218_NMEA_FIELD_LONGITUDE:
         {
-            decode_msg->type = ATK_MO1218_FIX_2D;
+            ret = atk_mo1218_decode_nmea_parameter(nmea, fields, desc->index + 1, &indicator, &indicator_len);
+            if ((ret != ATK_MO1218_EOK) || (indicator_len == 0) || ((indicator[0] != 'E') && (indicator[0] != 'W')))
+            {
+                return ATK_MO1218_ERROR;
+            }
+            atk_mo1218_fit_num(&_num, float_len, 5);
+            longitude = (atk_mo1218_longitude_t *)dest;
+            longitude->degree = (_num / 10000000) * 100000;
+            longitude->degree += ((_num % 10000000) / 60);
+            longitude->indicator = (indicator[0] == 'E') ? ATK_MO1218_LONGITUDE_EAST : ATK_MO1218_LONGITUDE_WEST;
+            break;
+        }
+        case ATK_MO1218_NMEA_FIELD_UINT:
+        {
+            atk_mo1218_fit_num(&_num, float_len, desc->param);
+            if ((_num < 0) || ((desc->size < 4) && (_num >= (1L << (desc->size * 8)))))
+            {
+                return ATK_MO1218_ERROR;
+            }
+            atk_mo1218_nmea_field_store(dest, desc->size, _num);
             break;
         }
-        case 3:
+        case ATK_MO1218_NMEA_FIELD_INT:
         {
-            decode_msg->type = ATK_MO1218_FIX_3D;
+            atk_mo1218_fit_num(&_num, float_len, desc->param);
+            if ((desc->size < 4) && ((_num < -(1L << (desc->size * 8 - 1))) || (_num >= (1L << (desc->size * 8 - 1)))))
+            {
+                return ATK_MO1218_ERROR;
+            }
+            atk_mo1218_nmea_field_store(dest, desc->size, _num);
             break;
         }
         default:
@@ -619,523 +1134,537 @@ uint8_t atk_mo1218_decode_nmea_xxgsa(uint8_t *xxgsa_msg, atk_mo1218_nmea_gsa_msg
         }
     }
     
-    /* Sstellite ID */
-    for (satellite_index=0; satellite_index<12; satellite_index++)
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       按字段表解析NMEA消息中请求的字段
+ * @note        未请求的字段不做转换，其值为0；
+ *              请求的字段中，可以为空的字段为空、缺失或格式错误时不影响其他字段，只在有效字段掩码中清除对应的位，
+ *              不可为空的字段为空、缺失或格式错误时解析失败
+ * @param       msg       : 待解析的NMEA消息
+ *              layout    : 消息描述
+ *              request   : 请求的字段掩码，见ATK_MO1218_NMEA_FIELD_MASK()
+ *              decode_msg: 解析后的数据（消息结构体）
+ * @retval      ATK_MO1218_EOK   : 解析NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析NMEA消息失败
+ *              ATK_MO1218_EINVAL: 消息类型与消息描述不符
+ */
+static uint8_t atk_mo1218_decode_nmea_fields(uint8_t *msg, const atk_mo1218_nmea_layout_t *layout, uint32_t request, void *decode_msg)
+{
+    uint8_t ret;
+    atk_mo1218_nmea_fields_t fields;
+    uint8_t *parameter;
+    uint16_t parameter_len;
+    uint8_t field_index;
+    const atk_mo1218_nmea_field_desc_t *desc;
+    uint32_t valid = 0;
+    
+    /* 扫描一次消息，建立字段表 */
+    ret = atk_mo1218_nmea_tokenize(msg, &fields);
+    if (ret != ATK_MO1218_EOK)
     {
-        ret = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 3 + satellite_index, &parameter, &parameter_len);
-        if (ret != ATK_MO1218_EOK)
+        return ATK_MO1218_ERROR;
+    }
+    
+    /* 未请求和无效字段的值为0 */
+    memset(decode_msg, 0, layout->size);
+    
+    /* Address */
+    ret = atk_mo1218_decode_nmea_parameter(msg, &fields, 0, &parameter, NULL);
+    if ((ret != ATK_MO1218_EOK) || (atk_mo1218_decode_nmea_address(parameter, layout->nmea, (atk_mo1218_nmea_talker_t *)((uint8_t *)decode_msg + layout->talker_offset)) != ATK_MO1218_EOK))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    for (field_index=0; field_index<layout->field_num; field_index++)
+    {
+        desc = &layout->field[field_index];
+        if ((request & ATK_MO1218_NMEA_FIELD_MASK(desc->index)) == 0)
         {
-            return ATK_MO1218_ERROR;
+            continue;
         }
-        if (parameter_len == 0)
+        
+        /* 较早版本的协议没有末尾的字段，视为空字段 */
+        ret = atk_mo1218_decode_nmea_parameter(msg, &fields, desc->index, &parameter, &parameter_len);
+        if ((ret == ATK_MO1218_EOK) && (parameter_len != 0))
+        {
+            ret = atk_mo1218_decode_nmea_field(msg, &fields, desc, (uint8_t *)decode_msg + desc->offset);
+        }
+        else
         {
-            decode_msg->satellite_id[satellite_index] = 0;
+            ret = ATK_MO1218_ERROR;
+        }
+        
+        if (ret != ATK_MO1218_EOK)
+        {
+            if (desc->optional == 0)
+            {
+                return ATK_MO1218_ERROR;
+            }
             continue;
         }
         
-        ret = atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-        if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+        valid |= ATK_MO1218_NMEA_FIELD_MASK(desc->index);
+        if ((desc->type == ATK_MO1218_NMEA_FIELD_LATITUDE) || (desc->type == ATK_MO1218_NMEA_FIELD_LONGITUDE))
         {
-            return ATK_MO1218_ERROR;
+            valid |= ATK_MO1218_NMEA_FIELD_MASK(desc->index + 1);
         }
-        decode_msg->satellite_id[satellite_index] = _num;
     }
     
-    /* PDOP */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 15, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    *(uint32_t *)((uint8_t *)decode_msg + layout->valid_offset) = valid;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       识别一条NMEA消息并只解析请求的字段
+ * @note        只需要部分字段时使用，未请求的字段不做数字转换，其值为0；
+ *              可以为空的字段是否有效见解析结果中的valid成员；
+ *              GSV消息由多条语句组成，不按字段解析，忽略request
+ * @param       msg       : 待解析的NMEA消息（以'$'开头）
+ *              request   : 请求的字段掩码，见各类型消息的字段掩码，ATK_MO1218_NMEA_FIELD_ALL表示全部字段
+ *              talker    : 识别出的发送者（星座），可为NULL
+ *              nmea      : 识别出的NMEA消息类型
+ *              decode_msg: 解析后的数据，按消息类型使用对应的成员
+ * @retval      ATK_MO1218_EOK   : 解析NMEA消息成功
+ *              ATK_MO1218_ERROR : 未知的NMEA消息类型或请求的字段解析失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_msg_fields(uint8_t *msg, uint32_t request, atk_mo1218_nmea_talker_t *talker, atk_mo1218_nmea_msg_t *nmea, atk_mo1218_nmea_decode_msg_t *decode_msg)
+{
+    uint8_t ret;
+    const atk_mo1218_nmea_layout_t *layout;
+    
+    if ((msg == NULL) || (nmea == NULL) || (decode_msg == NULL) || (msg[0] != ATK_MO1218_NMEA_MSG_SS))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    ret = atk_mo1218_get_nmea_msg_type(&msg[1], talker, nmea);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    layout = g_nmea_msg_registry[*nmea].layout;
+    if (layout->field == NULL)
+    {
+        return g_nmea_msg_registry[*nmea].decode(msg, decode_msg);
+    }
+    
+    return atk_mo1218_decode_nmea_fields(msg, layout, request, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGGA类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgga_msg : 待解析的$XXGGA类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGGA类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGGA类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgga(uint8_t *xxgga_msg, atk_mo1218_nmea_gga_msg_t *decode_msg)
+{
+    if ((xxgga_msg == NULL) || (decode_msg == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    return atk_mo1218_decode_nmea_fields(xxgga_msg, &g_nmea_gga_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGLL类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgll_msg : 待解析的$XXGLL类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGLL类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGLL类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgll(uint8_t *xxgll_msg, atk_mo1218_nmea_gll_msg_t *decode_msg)
+{
+    if ((xxgll_msg == NULL) || (decode_msg == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    return atk_mo1218_decode_nmea_fields(xxgll_msg, &g_nmea_gll_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGSA类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgsa_msg : 待解析的$XXGSA类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGSA类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGSA类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgsa(uint8_t *xxgsa_msg, atk_mo1218_nmea_gsa_msg_t *decode_msg)
+{
+    if ((xxgsa_msg == NULL) || (decode_msg == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    return atk_mo1218_decode_nmea_fields(xxgsa_msg, &g_nmea_gsa_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析GSV语句中的一个整数字段
+ * @param       xxgsv_msg: $XXGSV类型的NMEA消息
+ *              fields   : 消息的字段表
+ *              index    : 字段索引
+ *              optional : 字段是否可以为空，为空时解析为0
+ *              num      : 解析后的数字
+ * @retval      ATK_MO1218_EOK  : 解析成功
+ *              ATK_MO1218_ERROR: 字段不存在、不可以为空的字段为空或字段不是非负整数
+ */
+static uint8_t atk_mo1218_decode_nmea_gsv_num(uint8_t *xxgsv_msg, atk_mo1218_nmea_fields_t *fields, uint8_t index, uint8_t optional, int32_t *num)
+{
+    uint8_t *parameter;
+    uint16_t parameter_len;
+    uint8_t float_len;
+    
+    if (atk_mo1218_decode_nmea_parameter(xxgsv_msg, fields, index, &parameter, &parameter_len) != ATK_MO1218_EOK)
     {
         return ATK_MO1218_ERROR;
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->pdop = _num;
     
-    /* HDOP */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 16, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if (parameter_len == 0)
     {
-        return ATK_MO1218_ERROR;
+        *num = 0;
+        return (optional != 0) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->hdop = _num;
     
-    /* VDOP */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsa_msg, 17, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if ((atk_mo1218_nmea_str2num(parameter, num, &float_len) != ATK_MO1218_EOK) || (float_len != 0) || (*num < 0))
     {
         return ATK_MO1218_ERROR;
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->vdop = _num;
     
     return ATK_MO1218_EOK;
 }
 
 /**
- * @brief       解析$XXGSV类型的NMEA消息
- * @param       xxgsv_msg : 待解析的$XXGSV类型NMEA消息
- *              decode_msg: 解析后的数据
- * @retval      ATK_MO1218_EOK   : 解析$XXGSV类型的NMEA消息成功
- *              ATK_MO1218_ERROR : 解析$XXGSV类型的NMEA消息失败
+ * @brief       解析一条$XXGSV语句
+ * @note        GSV消息由多条语句组成，每条语句最多包含4颗卫星的信息，
+ *              逐条解析后由调用者按Sequence number拼接，无需缓存整组语句；
+ *              只有卫星编号不可以为空，仰角、方位角和信噪比为空时解析为0
+ * @param       xxgsv_msg: 待解析的$XXGSV语句
+ *              part     : 解析后的数据
+ * @retval      ATK_MO1218_EOK   : 解析$XXGSV语句成功
+ *              ATK_MO1218_ERROR : 解析$XXGSV语句失败
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
-uint8_t atk_mo1218_decode_nmea_xxgsv(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_msg_t *decode_msg)
+uint8_t atk_mo1218_decode_nmea_xxgsv_part(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_part_t *part)
 {
     uint8_t ret;
+    atk_mo1218_nmea_fields_t fields;
     uint8_t *parameter;
-    uint16_t parameter_len;
     int32_t _num;
-    uint8_t float_len;
-    uint8_t msg_num;
-    uint8_t msg_index;
-    uint8_t *_xxgsv_msg;
-    atk_mo1218_nmea_msg_t nmea_type;
     uint8_t satellite_index;
+    uint8_t field_index;
     
-    if ((xxgsv_msg == NULL) || (decode_msg == NULL))
+    if ((xxgsv_msg == NULL) || (part == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxgsv_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'G') || (parameter[3] != 'S') || (parameter[4] != 'V')))
-    {
-        return ATK_MO1218_EINVAL;
-    }
-    if ((parameter[0] == 'G') && (parameter[1] == 'P'))
+    /* 扫描一次消息，建立字段表 */
+    ret = atk_mo1218_nmea_tokenize(xxgsv_msg, &fields);
+    if (ret != ATK_MO1218_EOK)
     {
-        nmea_type = ATK_MO1218_NMEA_MSG_GPGSV;
+        return ATK_MO1218_ERROR;
     }
-    else if ((parameter[0] == 'B') && (parameter[1] == 'D'))
+    
+    /* Address */
+    ret = atk_mo1218_decode_nmea_parameter(xxgsv_msg, &fields, 0, &parameter, NULL);
+    if ((ret != ATK_MO1218_EOK) || (atk_mo1218_decode_nmea_address(parameter, ATK_MO1218_NMEA_MSG_GSV, &part->talker) != ATK_MO1218_EOK))
     {
-        nmea_type = ATK_MO1218_NMEA_MSG_BDGSV;
+        return ATK_MO1218_EINVAL;
     }
-    else
+    
+    /* Number of message */
+    if ((atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, 1, 0, &_num) != ATK_MO1218_EOK) || (_num < 1) || (_num > 9))
     {
         return ATK_MO1218_ERROR;
     }
+    part->msg_num = _num;
     
-    /* Number of message */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsv_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    /* Sequence number */
+    if ((atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, 2, 0, &_num) != ATK_MO1218_EOK) || (_num < 1) || (_num > part->msg_num))
     {
         return ATK_MO1218_ERROR;
     }
-    msg_num = _num;
+    part->msg_index = _num;
     
     /* Satellite in view */
-    ret  = atk_mo1218_decode_nmea_parameter(xxgsv_msg, 3, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0) || (_num < (msg_num - 1) * 4) || (_num > msg_num * 4))
+    if ((atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, 3, 0, &_num) != ATK_MO1218_EOK) || (_num < (part->msg_num - 1) * 4) || (_num > part->msg_num * 4))
     {
         return ATK_MO1218_ERROR;
     }
-    decode_msg->satellite_view = _num;
+    part->satellite_view = _num;
     
-    if (decode_msg->satellite_view > 12)
+    /* 本条语句包含的卫星数量，最后一条语句为剩余的卫星数量 */
+    part->satellite_num = part->satellite_view - (part->msg_index - 1) * 4;
+    if (part->satellite_num > 4)
     {
-        decode_msg->satellite_view = 12;
-        msg_num = (12 / 4) + (((12 % 4) == 0) ? 0 : 1);
+        part->satellite_num = 4;
     }
     
-    for (msg_index=0; msg_index<msg_num; msg_index++)
+    for (satellite_index=0; satellite_index<part->satellite_num; satellite_index++)
     {
-        ret = atk_mo1218_get_nmea_msg_from_buf(xxgsv_msg, nmea_type, msg_index + 1, &_xxgsv_msg);
-        if (ret != ATK_MO1218_EOK)
-        {
-            return ATK_MO1218_ERROR;
-        }
+        field_index = 4 + 4 * satellite_index;
         
-        /* Number of message */
-        ret  = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 1, &parameter, NULL);
-        ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-        if ((ret != ATK_MO1218_EOK) || (float_len != 0) || (_num < msg_num))
+        /* Satellite ID，不可以为空 */
+        if (atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, field_index + 0, 0, &_num) != ATK_MO1218_EOK)
         {
             return ATK_MO1218_ERROR;
         }
+        part->satellite_info[satellite_index].satellite_id = _num;
         
-        /* Sequence number */
-        ret  = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 2, &parameter, NULL);
-        ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-        if ((ret != ATK_MO1218_EOK) || (float_len != 0) || (_num != msg_index + 1))
+        /* Elevation，尚未算出卫星位置时为空 */
+        if (atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, field_index + 1, 1, &_num) != ATK_MO1218_EOK)
         {
             return ATK_MO1218_ERROR;
         }
+        part->satellite_info[satellite_index].elevation = _num;
         
-        /* Satellite in view */
-        ret  = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 3, &parameter, NULL);
-        ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-        if ((ret != ATK_MO1218_EOK) || (float_len != 0) || (_num < decode_msg->satellite_view))
+        /* Azimuth，尚未算出卫星位置时为空 */
+        if (atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, field_index + 2, 1, &_num) != ATK_MO1218_EOK)
         {
             return ATK_MO1218_ERROR;
         }
+        part->satellite_info[satellite_index].azimuth = _num;
         
-        
-        for (satellite_index=0; satellite_index<4; satellite_index++)
+        /* SNR，未跟踪的卫星为空 */
+        if (atk_mo1218_decode_nmea_gsv_num(xxgsv_msg, &fields, field_index + 3, 1, &_num) != ATK_MO1218_EOK)
         {
-            /* Satellite ID */
-            ret = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 4 + 4 * satellite_index + 0, &parameter, NULL);
-            ret = atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-            if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-            {
-                return ATK_MO1218_ERROR;
-            }
-            decode_msg->satellite_info[msg_index * 4 + satellite_index].satellite_id = _num;
-            
-            /* Elevation */
-            ret  = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 4 + 4 * satellite_index + 1, &parameter, NULL);
-            ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-            if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-            {
-                return ATK_MO1218_ERROR;
-            }
-            decode_msg->satellite_info[msg_index * 4 + satellite_index].elevation = _num;
-            
-            /* Azimuth */
-            ret  = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 4 + 4 * satellite_index + 2, &parameter, NULL);
-            ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-            if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-            {
-                return ATK_MO1218_ERROR;
-            }
-            decode_msg->satellite_info[msg_index * 4 + satellite_index].azimuth = _num;
-            
-            /* SNR */
-            ret = atk_mo1218_decode_nmea_parameter(_xxgsv_msg, 4 + 4 * satellite_index + 3, &parameter, &parameter_len);
-            if (ret != ATK_MO1218_EOK)
-            {
-                return ATK_MO1218_ERROR;
-            }
-            if (parameter_len == 0)
-            {
-                decode_msg->satellite_info[msg_index * 4 + satellite_index].snr = 0;
-                if ((msg_index == msg_num - 1) && (satellite_index == (4 - (decode_msg->satellite_view % 4)) - 1))
-                {
-                    break;
-                }
-                else
-                {
-                    continue;
-                }
-            }
-            ret = atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-            if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-            {
-                return ATK_MO1218_ERROR;
-            }
-            decode_msg->satellite_info[msg_index * 4 + satellite_index].snr = _num;
-            
-            if ((msg_index == msg_num - 1) && (satellite_index == (4 - (decode_msg->satellite_view % 4)) - 1))
-            {
-                break;
-            }
+            return ATK_MO1218_ERROR;
         }
+        part->satellite_info[satellite_index].snr = _num;
     }
     
     return ATK_MO1218_EOK;
 }
 
 /**
- * @brief       解析$XXRMC类型的NMEA消息
- * @param       xxrmc_msg : 待解析的$XXRMC类型NMEA消息
+ * @brief       解析$XXGSV类型的NMEA消息
+ * @note        从数据缓冲中查找同一组的各条GSV语句，最多解析前ATK_MO1218_NMEA_GSV_SATELLITE_MAX颗卫星，
+ *              与逐条接收GSV语句的可见卫星表容量一致
+ * @param       xxgsv_msg : 待解析的$XXGSV类型NMEA消息
  *              decode_msg: 解析后的数据
- * @retval      ATK_MO1218_EOK   : 解析$XXRMC类型的NMEA消息成功
- *              ATK_MO1218_ERROR : 解析$XXRMC类型的NMEA消息失败
+ * @retval      ATK_MO1218_EOK   : 解析$XXGSV类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGSV类型的NMEA消息失败
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
-uint8_t atk_mo1218_decode_nmea_xxrmc(uint8_t *xxrmc_msg, atk_mo1218_nmea_rmc_msg_t *decode_msg)
+uint8_t atk_mo1218_decode_nmea_xxgsv(uint8_t *xxgsv_msg, atk_mo1218_nmea_gsv_msg_t *decode_msg)
 {
     uint8_t ret;
-    uint8_t *parameter;
-    int32_t _num;
-    uint8_t float_len;
-    
-    if ((xxrmc_msg == NULL) || (decode_msg == NULL))
-    {
-        return ATK_MO1218_EINVAL;
-    }
+    atk_mo1218_nmea_gsv_part_t part;
+    uint8_t msg_num;
+    uint8_t msg_index;
+    uint8_t *_xxgsv_msg;
+    atk_mo1218_nmea_dir_t dir;
+    uint8_t satellite_index;
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'R') || (parameter[3] != 'M') || (parameter[4] != 'C')))
+    if ((xxgsv_msg == NULL) || (decode_msg == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* UTC Time */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 3))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->utc_time.hour = (_num / 10000000) % 100;
-    decode_msg->utc_time.minute = (_num / 100000) % 100;
-    decode_msg->utc_time.second = (_num / 1000) % 100;
-    decode_msg->utc_time.millisecond = (_num / 1) % 1000;
-    
-    /* Status */
-    ret = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 2, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'V') && (parameter[0] != 'A')))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->status = (parameter[0] == 'V') ? ATK_MO1218_NAVIGATION_WARNING : ATK_MO1218_NAVIGATION_VALID;
-    
-    /* Latitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 3, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->latitude.degree = (_num / 10000000) * 100000;
-    decode_msg->latitude.degree += ((_num % 10000000) / 60);
-    
-    /* N/S Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 4, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'N') && (parameter[0] != 'S')))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->latitude.indicator = (parameter[0] == 'N') ? ATK_MO1218_LATITUDE_NORTH : ATK_MO1218_LATITUDE_SOUTH;
-    
-    /* Longitude */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 5, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
+    ret = atk_mo1218_decode_nmea_xxgsv_part(xxgsv_msg, &part);
     if (ret != ATK_MO1218_EOK)
     {
-        return ATK_MO1218_ERROR;
-    }
-    atk_mo1218_fit_num(&_num, float_len, 5);
-    decode_msg->longitude.degree = (_num / 10000000) * 100000;
-    decode_msg->longitude.degree += ((_num % 10000000) / 60);
-    
-    /* E/W Indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 6, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'E') && (parameter[0] != 'W')))
-    {
-        return ATK_MO1218_ERROR;
+        return ret;
     }
-    decode_msg->longitude.indicator = (parameter[0] == 'E') ? ATK_MO1218_LONGITUDE_EAST : ATK_MO1218_LONGITUDE_WEST;
+    decode_msg->talker = part.talker;
+    decode_msg->satellite_view = part.satellite_view;
+    msg_num = part.msg_num;
     
-    /* Speed over ground */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 7, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
+    if (decode_msg->satellite_view > ATK_MO1218_NMEA_GSV_SATELLITE_MAX)
     {
-        return ATK_MO1218_ERROR;
+        decode_msg->satellite_view = ATK_MO1218_NMEA_GSV_SATELLITE_MAX;
+        msg_num = (ATK_MO1218_NMEA_GSV_SATELLITE_MAX / 4) + (((ATK_MO1218_NMEA_GSV_SATELLITE_MAX % 4) == 0) ? 0 : 1);
     }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->speed_ground = _num;
     
-    /* Course over ground */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 8, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    atk_mo1218_fit_num(&_num, float_len, 1);
-    decode_msg->course_ground = _num;
+    /* 遍历一次后续数据，建立消息目录，用于查找各条GSV语句 */
+    atk_mo1218_nmea_dir_build(xxgsv_msg, &dir);
     
-    /* UTC Date */
-    ret  = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 9, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    for (msg_index=0; msg_index<msg_num; msg_index++)
     {
-        return ATK_MO1218_ERROR;
+        ret = atk_mo1218_nmea_dir_get(&dir, decode_msg->talker, ATK_MO1218_NMEA_MSG_GSV, msg_index + 1, &_xxgsv_msg);
+        if (ret != ATK_MO1218_EOK)
+        {
+            return ATK_MO1218_ERROR;
+        }
+        
+        ret = atk_mo1218_decode_nmea_xxgsv_part(_xxgsv_msg, &part);
+        if ((ret != ATK_MO1218_EOK) || (part.msg_index != msg_index + 1) || (part.satellite_view < decode_msg->satellite_view))
+        {
+            return ATK_MO1218_ERROR;
+        }
+        
+        for (satellite_index=0; (satellite_index<part.satellite_num) && ((msg_index * 4 + satellite_index) < decode_msg->satellite_view); satellite_index++)
+        {
+            decode_msg->satellite_info[msg_index * 4 + satellite_index] = part.satellite_info[satellite_index];
+        }
     }
-    decode_msg->utc_date.year = (_num / 1) % 100 + 2000;
-    decode_msg->utc_date.month = (_num / 100) % 100;
-    decode_msg->utc_date.day = (_num / 10000) % 100;
     
-    /* Mode indicator */
-    ret = atk_mo1218_decode_nmea_parameter(xxrmc_msg, 12, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'N') && (parameter[0] != 'A') && (parameter[0] != 'D') && (parameter[0] != 'E')))
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       解析$XXRMC类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxrmc_msg : 待解析的$XXRMC类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXRMC类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXRMC类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxrmc(uint8_t *xxrmc_msg, atk_mo1218_nmea_rmc_msg_t *decode_msg)
+{
+    if ((xxrmc_msg == NULL) || (decode_msg == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->position_system_mode = (parameter[0] == 'N') ? ATK_MO1218_POS_SYS_DATA_NOT_VALID : ((parameter[0] == 'A') ? ATK_MO1218_POS_SYS_AUTONOMOUS : ((parameter[0] == 'D') ? ATK_MO1218_POS_SYS_DIFFERENTIAL : ATK_MO1218_POS_SYS_ESTIMATED));
     
-    return ATK_MO1218_EOK;
+    return atk_mo1218_decode_nmea_fields(xxrmc_msg, &g_nmea_rmc_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
 }
 
 /**
  * @brief       解析$XXVTG类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
  * @param       xxvtg_msg : 待解析的$XXVTG类型NMEA消息
- *              decode_msg: 解析后的数据
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
  * @retval      ATK_MO1218_EOK   : 解析$XXVTG类型的NMEA消息成功
  *              ATK_MO1218_ERROR : 解析$XXVTG类型的NMEA消息失败
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
 uint8_t atk_mo1218_decode_nmea_xxvtg(uint8_t *xxvtg_msg, atk_mo1218_nmea_vtg_msg_t *decode_msg)
 {
-    uint8_t ret;
-    uint8_t *parameter;
-    uint16_t parameter_len;
-    int32_t _num;
-    uint8_t float_len;
-    
     if ((xxvtg_msg == NULL) || (decode_msg == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'V') || (parameter[3] != 'T') || (parameter[4] != 'G')))
-    {
-        return ATK_MO1218_EINVAL;
-    }
-    
-    /* Course */
-    ret  = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 1))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->course_true = _num;
-    
-    /* Course */
-    ret = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 3, &parameter, &parameter_len);
-    if (ret != ATK_MO1218_EOK)
-    {
-        return ATK_MO1218_ERROR;
-    }
-    if (parameter_len == 0)
-    {
-        decode_msg->course_magnetic = 0;
-    }
-    else
-    {
-        ret = atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-        if (ret != ATK_MO1218_EOK)
-        {
-            return ATK_MO1218_ERROR;
-        }
-        decode_msg->course_magnetic = _num;
-    }
-    
-    /* Speed */
-    ret  = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 5, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 1))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->speed_knots = _num;
-    
-    /* Speed */
-    ret  = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 7, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 1))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->speed_kph = _num;
-    
-    /* Mode */
-    ret = atk_mo1218_decode_nmea_parameter(xxvtg_msg, 9, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[0] != 'N') && (parameter[0] != 'A') && (parameter[0] != 'D') && (parameter[0] != 'E')))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->position_system_mode = (parameter[0] == 'N') ? ATK_MO1218_POS_SYS_DATA_NOT_VALID : ((parameter[0] == 'A') ? ATK_MO1218_POS_SYS_AUTONOMOUS : ((parameter[0] == 'D') ? ATK_MO1218_POS_SYS_DIFFERENTIAL : ATK_MO1218_POS_SYS_ESTIMATED));
-    
-    return ATK_MO1218_EOK;
+    return atk_mo1218_decode_nmea_fields(xxvtg_msg, &g_nmea_vtg_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
 }
 
 /**
  * @brief       解析$XXZDA类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
  * @param       xxzda_msg : 待解析的$XXZDA类型NMEA消息
- *              decode_msg: 解析后的数据
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
  * @retval      ATK_MO1218_EOK   : 解析$XXZDA类型的NMEA消息成功
  *              ATK_MO1218_ERROR : 解析$XXZDA类型的NMEA消息失败
  *              ATK_MO1218_EINVAL: 函数参数错误
  */
 uint8_t atk_mo1218_decode_nmea_xxzda(uint8_t *xxzda_msg, atk_mo1218_nmea_zda_msg_t *decode_msg)
 {
-    uint8_t ret;
-    uint8_t *parameter;
-    int32_t _num;
-    uint8_t float_len;
-    
     if ((xxzda_msg == NULL) || (decode_msg == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* Address */
-    ret = atk_mo1218_decode_nmea_parameter(xxzda_msg, 0, &parameter, NULL);
-    if ((ret != ATK_MO1218_EOK) || ((parameter[2] != 'Z') || (parameter[3] != 'D') || (parameter[4] != 'A')))
+    return atk_mo1218_decode_nmea_fields(xxzda_msg, &g_nmea_zda_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGNS类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgns_msg : 待解析的$XXGNS类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGNS类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGNS类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgns(uint8_t *xxgns_msg, atk_mo1218_nmea_gns_msg_t *decode_msg)
+{
+    if ((xxgns_msg == NULL) || (decode_msg == NULL))
     {
         return ATK_MO1218_EINVAL;
     }
     
-    /* UTC Time */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 1, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 3))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->utc_time.hour = (_num / 10000000) % 100;
-    decode_msg->utc_time.minute = (_num / 100000) % 100;
-    decode_msg->utc_time.second = (_num / 1000) % 100;
-    decode_msg->utc_time.millisecond = (_num / 1) % 1000;
-    
-    /* UTC day */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 2, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
-    {
-        return ATK_MO1218_ERROR;
-    }
-    decode_msg->utc_date.day = _num;
-    
-    /* UTC month */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 3, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    return atk_mo1218_decode_nmea_fields(xxgns_msg, &g_nmea_gns_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGBS类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgbs_msg : 待解析的$XXGBS类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGBS类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGBS类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgbs(uint8_t *xxgbs_msg, atk_mo1218_nmea_gbs_msg_t *decode_msg)
+{
+    if ((xxgbs_msg == NULL) || (decode_msg == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->utc_date.month = _num;
     
-    /* UTC year */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 4, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    return atk_mo1218_decode_nmea_fields(xxgbs_msg, &g_nmea_gbs_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGRS类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgrs_msg : 待解析的$XXGRS类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGRS类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGRS类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgrs(uint8_t *xxgrs_msg, atk_mo1218_nmea_grs_msg_t *decode_msg)
+{
+    if ((xxgrs_msg == NULL) || (decode_msg == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->utc_date.year = _num;
     
-    /* Local zone hours */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 5, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    return atk_mo1218_decode_nmea_fields(xxgrs_msg, &g_nmea_grs_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXDTM类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxdtm_msg : 待解析的$XXDTM类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXDTM类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXDTM类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxdtm(uint8_t *xxdtm_msg, atk_mo1218_nmea_dtm_msg_t *decode_msg)
+{
+    if ((xxdtm_msg == NULL) || (decode_msg == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->local_zone_hour = _num;
     
-    /* Local zone mintues */
-    ret  = atk_mo1218_decode_nmea_parameter(xxzda_msg, 6, &parameter, NULL);
-    ret += atk_mo1218_nmea_str2num(parameter, &_num, &float_len);
-    if ((ret != ATK_MO1218_EOK) || (float_len != 0))
+    return atk_mo1218_decode_nmea_fields(xxdtm_msg, &g_nmea_dtm_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
+}
+
+/**
+ * @brief       解析$XXGST类型的NMEA消息
+ * @note        只需要部分字段时使用atk_mo1218_decode_nmea_msg_fields()
+ * @param       xxgst_msg : 待解析的$XXGST类型NMEA消息
+ *              decode_msg: 解析后的数据，可以为空的字段是否有效见decode_msg->valid
+ * @retval      ATK_MO1218_EOK   : 解析$XXGST类型的NMEA消息成功
+ *              ATK_MO1218_ERROR : 解析$XXGST类型的NMEA消息失败
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_decode_nmea_xxgst(uint8_t *xxgst_msg, atk_mo1218_nmea_gst_msg_t *decode_msg)
+{
+    if ((xxgst_msg == NULL) || (decode_msg == NULL))
     {
-        return ATK_MO1218_ERROR;
+        return ATK_MO1218_EINVAL;
     }
-    decode_msg->local_zone_minute = _num;
     
-    return ATK_MO1218_EOK;
+    return atk_mo1218_decode_nmea_fields(xxgst_msg, &g_nmea_gst_layout, ATK_MO1218_NMEA_FIELD_ALL, decode_msg);
 }
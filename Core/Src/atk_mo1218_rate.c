@@ -0,0 +1,454 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_rate.c
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块波特率与位置更新频率协商驱动代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#include "atk_mo1218_rate.h"
+#include "atk_mo1218.h"
+#include <string.h>
+
+/* 串口波特率枚举对应的波特率 */
+static const uint32_t g_rate_baudrate[] = {4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
+
+/* 探测波特率的顺序（当前UART波特率总是最先探测），出厂默认的38400bps优先 */
+static const atk_mo1218_serial_baudrate_t g_rate_probe_order[] = {
+    ATK_MO1218_SERIAL_BAUDRATE_38400,
+    ATK_MO1218_SERIAL_BAUDRATE_115200,
+    ATK_MO1218_SERIAL_BAUDRATE_9600,
+    ATK_MO1218_SERIAL_BAUDRATE_921600,
+    ATK_MO1218_SERIAL_BAUDRATE_460800,
+    ATK_MO1218_SERIAL_BAUDRATE_230400,
+    ATK_MO1218_SERIAL_BAUDRATE_57600,
+    ATK_MO1218_SERIAL_BAUDRATE_19200,
+    ATK_MO1218_SERIAL_BAUDRATE_4800,
+};
+
+/* 位置更新频率枚举对应的频率，单位：Hz */
+static const uint8_t g_rate_hz[] = {1, 2, 4, 5, 8, 10, 20, 25, 40, 50};
+
+/* 位置更新频率枚举要求的最低串口波特率 */
+static const atk_mo1218_serial_baudrate_t g_rate_min_baudrate[] = {
+    ATK_MO1218_SERIAL_BAUDRATE_4800,                /* 1Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_4800,                /* 2Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_57600,               /* 4Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_57600,               /* 5Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_57600,               /* 8Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_57600,               /* 10Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_230400,              /* 20Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_230400,              /* 25Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_921600,              /* 40Hz */
+    ATK_MO1218_SERIAL_BAUDRATE_921600,              /* 50Hz */
+};
+
+/**
+ * @brief       获取UART通讯波特率对应的串口波特率枚举
+ * @param       baudrate: 串口波特率枚举
+ * @retval      ATK_MO1218_EOK  : 获取成功
+ *              ATK_MO1218_ERROR: UART通讯波特率不是模块支持的波特率
+ */
+static uint8_t atk_mo1218_rate_uart_baudrate(atk_mo1218_serial_baudrate_t *baudrate)
+{
+    uint8_t baudrate_index;
+    
+    for (baudrate_index=0; baudrate_index<sizeof(g_rate_baudrate)/sizeof(g_rate_baudrate[0]); baudrate_index++)
+    {
+        if (g_rate_baudrate[baudrate_index] == atk_mo1218_uart_get_baudrate())
+        {
+            *baudrate = (atk_mo1218_serial_baudrate_t)baudrate_index;
+            return ATK_MO1218_EOK;
+        }
+    }
+    
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       统计NMEA消息接收计数
+ * @param       ok : 校验通过的消息总数
+ *              err: 校验和错误和不完整的消息总数
+ * @retval      无
+ */
+static void atk_mo1218_rate_nmea_count(uint32_t *ok, uint32_t *err)
+{
+    atk_mo1218_nmea_stats_t stats;
+    uint8_t msg_index;
+    
+    atk_mo1218_get_nmea_stats(&stats);
+    *ok = stats.unknown.ok;
+    *err = stats.unknown.bad_checksum + stats.unknown.truncated;
+    for (msg_index=0; msg_index<ATK_MO1218_NMEA_MSG_NUM; msg_index++)
+    {
+        *ok += stats.msg[msg_index].ok;
+        *err += stats.msg[msg_index].bad_checksum + stats.msg[msg_index].truncated;
+    }
+}
+
+/**
+ * @brief       在当前UART通讯波特率下监听一段时间，检查链路是否健康
+ * @note        监听期间继续处理NMEA消息；
+ *              收到校验通过的NMEA消息、错误消息足够少且环形缓冲没有溢出时认为链路健康，
+ *              允许切换波特率时被截断的1条消息
+ * @param       time: 监听时间，单位：1毫秒
+ * @retval      ATK_MO1218_EOK     : 链路健康
+ *              ATK_MO1218_ERROR   : 错误过多或环形缓冲溢出
+ *              ATK_MO1218_ETIMEOUT: 没有收到NMEA消息
+ */
+static uint8_t atk_mo1218_rate_listen(uint32_t time)
+{
+    uint32_t start;
+    uint32_t ok_start;
+    uint32_t err_start;
+    uint32_t overflow_start;
+    uint32_t ok;
+    uint32_t err;
+    
+    atk_mo1218_rate_nmea_count(&ok_start, &err_start);
+    overflow_start = atk_mo1218_uart_rx_ring_get_overflow();
+    start = HAL_GetTick();
+    while ((HAL_GetTick() - start) < time)
+    {
+        atk_mo1218_process();
+    }
+    
+    atk_mo1218_rate_nmea_count(&ok, &err);
+    ok -= ok_start;
+    err -= err_start;
+    if ((ok == 0) && (err == 0))
+    {
+        return ATK_MO1218_ETIMEOUT;
+    }
+    
+    if ((ok == 0) || (err > (ok / ATK_MO1218_RATE_ERROR_RATIO + 1)) || (atk_mo1218_uart_rx_ring_get_overflow() != overflow_start))
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       检查当前UART通讯波特率下与模块的链路
+ * @note        先监听NMEA消息，完全没有NMEA输出（如输出类型为Binary）时才查询位置更新频率
+ * @param       无
+ * @retval      ATK_MO1218_EOK  : 链路健康
+ *              ATK_MO1218_ERROR: 链路不可用
+ */
+static uint8_t atk_mo1218_rate_check(void)
+{
+    atk_mo1218_position_rate_t rate;
+    uint8_t ret;
+    
+    ret = atk_mo1218_rate_listen(ATK_MO1218_RATE_PROBE_TIME);
+    if (ret != ATK_MO1218_ETIMEOUT)
+    {
+        return (ret == ATK_MO1218_EOK) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+    }
+    
+    return (atk_mo1218_get_position_rate(&rate) == ATK_MO1218_EOK) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       修改UART通讯波特率
+ * @param       baudrate: 串口波特率枚举
+ * @retval      无
+ */
+static void atk_mo1218_rate_set_uart(atk_mo1218_serial_baudrate_t baudrate)
+{
+    if (atk_mo1218_uart_get_baudrate() != g_rate_baudrate[baudrate])
+    {
+        atk_mo1218_uart_set_baudrate(g_rate_baudrate[baudrate]);
+    }
+}
+
+/**
+ * @brief       探测ATK-MO1218模块当前的串口波特率
+ * @note        依次切换UART通讯波特率并监听NMEA消息，都没有收到时再依次以Binary Message查询；
+ *              探测成功后UART保持在探测到的波特率，失败时恢复原波特率；
+ *              影子缓存中的串口波特率失效，下次应用配置时按探测到的波特率重新读取
+ * @param       baudrate: 探测到的串口波特率，可以为NULL
+ * @retval      ATK_MO1218_EOK  : 探测成功
+ *              ATK_MO1218_ERROR: 所有波特率下均无法与模块通讯
+ */
+uint8_t atk_mo1218_rate_probe(atk_mo1218_serial_baudrate_t *baudrate)
+{
+    atk_mo1218_serial_baudrate_t current;
+    atk_mo1218_serial_baudrate_t candidate;
+    atk_mo1218_position_rate_t rate;
+    uint8_t has_current;
+    uint8_t pass;
+    uint8_t order_index;
+    uint8_t ret;
+    
+    has_current = (atk_mo1218_rate_uart_baudrate(&current) == ATK_MO1218_EOK) ? 1 : 0;
+    
+    /* 第1轮监听NMEA消息（耗时短），第2轮查询位置更新频率（适用于没有NMEA输出的情况） */
+    for (pass=0; pass<2; pass++)
+    {
+        for (order_index=0; order_index<=sizeof(g_rate_probe_order)/sizeof(g_rate_probe_order[0]); order_index++)
+        {
+            if (order_index == 0)
+            {
+                if (has_current == 0)
+                {
+                    continue;
+                }
+                candidate = current;
+            }
+            else
+            {
+                candidate = g_rate_probe_order[order_index - 1];
+                if ((has_current != 0) && (candidate == current))
+                {
+                    continue;
+                }
+            }
+
+            atk_mo1218_rate_set_uart(candidate);
+            if (pass == 0)
+            {
+                ret = atk_mo1218_rate_listen(ATK_MO1218_RATE_PROBE_TIME);
+            }
+            else
+            {
+                ret = atk_mo1218_get_position_rate(&rate);
+            }
+
+            if (ret == ATK_MO1218_EOK)
+            {
+                atk_mo1218_config_invalidate(ATK_MO1218_CONFIG_SERIAL);
+                if (baudrate != NULL)
+                {
+                    *baudrate = candidate;
+                }
+                return ATK_MO1218_EOK;
+            }
+        }
+    }
+    
+    if (has_current != 0)
+    {
+        atk_mo1218_rate_set_uart(current);
+    }
+    
+    return ATK_MO1218_ERROR;
+}
+
+/**
+ * @brief       测量每个历元的字节数
+ * @note        从历元开始的时刻起统计ATK_MO1218_RATE_MEASURE_EPOCHS个历元接收的字节数（NMEA和Binary Message），
+ *              未定位前没有带UTC时间的消息时，按单位时间的字节数和当前位置更新频率折算
+ * @param       bytes_per_epoch: 每个历元的字节数
+ * @retval      ATK_MO1218_EOK     : 测量成功
+ *              ATK_MO1218_ETIMEOUT: 超时时间内没有收到数据
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ */
+uint8_t atk_mo1218_rate_measure(uint32_t *bytes_per_epoch)
+{
+    atk_mo1218_rx_stats_t stats;
+    atk_mo1218_rx_stats_t stats_first;
+    atk_mo1218_rx_stats_t stats_last;
+    atk_mo1218_rx_stats_t stats_start;
+    atk_mo1218_position_rate_t rate;
+    uint32_t start;
+    uint32_t elapsed;
+    uint32_t epochs;
+    
+    if (bytes_per_epoch == NULL)
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    atk_mo1218_get_rx_stats(&stats_start);
+    stats_first = stats_start;
+    stats_last = stats_start;
+    start = HAL_GetTick();
+    do
+    {
+        atk_mo1218_process();
+        atk_mo1218_get_rx_stats(&stats);
+        if (stats.epochs != stats_last.epochs)
+        {
+            /* 以历元开始的时刻为边界，第1个历元可能不完整，不计入 */
+            if (stats_first.epochs == stats_start.epochs)
+            {
+                stats_first = stats;
+            }
+            stats_last = stats;
+        }
+        epochs = stats_last.epochs - stats_first.epochs;
+        elapsed = HAL_GetTick() - start;
+    } while ((epochs < ATK_MO1218_RATE_MEASURE_EPOCHS) && (elapsed < ATK_MO1218_RATE_MEASURE_TIMEOUT));
+    
+    if (epochs != 0)
+    {
+        *bytes_per_epoch = (stats_last.bytes - stats_first.bytes) / epochs;
+        return ATK_MO1218_EOK;
+    }
+    
+    if ((stats.bytes == stats_start.bytes) || (atk_mo1218_get_position_rate(&rate) != ATK_MO1218_EOK))
+    {
+        return ATK_MO1218_ETIMEOUT;
+    }
+    
+    *bytes_per_epoch = (uint32_t)((uint64_t)(stats.bytes - stats_start.bytes) * 1000 / elapsed / g_rate_hz[rate]);
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       选择链路带宽允许的最高位置更新频率
+ * @note        每个字节占10位（8个数据位、起始位和停止位），链路负载不超过ATK_MO1218_RATE_LOAD_PERCENT
+ * @param       bytes_per_epoch: 每个历元的字节数
+ *              baudrate       : 串口波特率枚举
+ *              max_rate       : 允许的最高位置更新频率
+ * @retval      位置更新频率
+ */
+static atk_mo1218_position_rate_t atk_mo1218_rate_fit(uint32_t bytes_per_epoch, atk_mo1218_serial_baudrate_t baudrate, atk_mo1218_position_rate_t max_rate)
+{
+    uint32_t budget;
+    uint8_t rate;
+    
+    budget = g_rate_baudrate[baudrate] / 10 * ATK_MO1218_RATE_LOAD_PERCENT / 100;
+    for (rate=max_rate; rate>ATK_MO1218_POSITION_RATE_1HZ; rate--)
+    {
+        if ((baudrate >= g_rate_min_baudrate[rate]) && ((bytes_per_epoch * g_rate_hz[rate]) <= budget))
+        {
+            break;
+        }
+    }
+    
+    return (atk_mo1218_position_rate_t)rate;
+}
+
+/**
+ * @brief       提升ATK-MO1218模块波特率并选择链路带宽允许的最高位置更新频率
+ * @note        1. 探测模块当前的波特率
+ *              2. 从max_baudrate起逐级尝试提升波特率，UART同步切换，链路不健康时重新探测并降一级
+ *              3. 测量当前输出消息下每个历元的字节数，选择链路带宽允许的最高位置更新频率
+ *              4. 以新的位置更新频率再测量一次，带宽不足（如可见卫星增多）时逐级降低
+ *              配置经影子缓存发送，不需要改变的配置项不发送；
+ *              阻塞执行，耗时数秒，期间继续处理NMEA消息
+ * @param       max_baudrate: 允许的最高串口波特率
+ *              max_rate    : 允许的最高位置更新频率
+ *              save_type   : ATK_MO1218_SAVE_SRAM      : 保存到SRAM（配置掉电丢失）
+ *                            ATK_MO1218_SAVE_SRAM_FLASH: 保存到SRAM和Flash（配置掉电不丢失）
+ *              result      : 协商结果，可以为NULL
+ * @retval      ATK_MO1218_EOK     : 协商成功
+ *              ATK_MO1218_ERROR   : 无法与模块通讯或配置失败
+ *              ATK_MO1218_ETIMEOUT: 没有收到模块输出的数据，无法测量
+ *              ATK_MO1218_EINVAL  : 函数参数错误
+ */
+uint8_t atk_mo1218_rate_negotiate(atk_mo1218_serial_baudrate_t max_baudrate, atk_mo1218_position_rate_t max_rate, atk_mo1218_save_type_t save_type, atk_mo1218_rate_result_t *result)
+{
+    atk_mo1218_config_t config;
+    atk_mo1218_serial_baudrate_t original;
+    atk_mo1218_serial_baudrate_t current;
+    uint8_t target;
+    uint8_t raised;
+    atk_mo1218_position_rate_t rate;
+    uint32_t bytes_per_epoch;
+    uint32_t budget;
+    uint8_t ret;
+    
+    if ((max_baudrate > ATK_MO1218_SERIAL_BAUDRATE_921600) || (max_rate > ATK_MO1218_POSITION_RATE_50HZ) || ((save_type != ATK_MO1218_SAVE_SRAM) && (save_type != ATK_MO1218_SAVE_SRAM_FLASH)))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (atk_mo1218_rate_probe(&original) != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    current = original;
+    raised = 0;
+    
+    /* 逐级提升波特率，模块以原波特率回复ACK后UART同步切换 */
+    memset(&config, 0, sizeof(config));
+    config.mask = ATK_MO1218_CONFIG_SERIAL;
+    for (target=max_baudrate; target>original; target--)
+    {
+        config.baudrate = (atk_mo1218_serial_baudrate_t)target;
+        if ((atk_mo1218_config_apply(&config, save_type) == ATK_MO1218_EOK) && (atk_mo1218_rate_check() == ATK_MO1218_EOK))
+        {
+            current = (atk_mo1218_serial_baudrate_t)target;
+            raised = 1;
+            break;
+        }
+
+        /* 切换失败或新波特率下链路不健康，重新找到模块后尝试低一级的波特率 */
+        if (atk_mo1218_rate_probe(&current) != ATK_MO1218_EOK)
+        {
+            return ATK_MO1218_ERROR;
+        }
+    }
+    
+    /* 没有可用的更高波特率（或max_baudrate不高于原波特率），回到原波特率 */
+    if (raised == 0)
+    {
+        if (current != original)
+        {
+            config.baudrate = original;
+            if (atk_mo1218_config_apply(&config, save_type) != ATK_MO1218_EOK)
+            {
+                return ATK_MO1218_ERROR;
+            }
+        }
+        current = original;
+    }
+    
+    /* 每个历元的字节数与位置更新频率无关，在当前频率下测量即可 */
+    ret = atk_mo1218_rate_measure(&bytes_per_epoch);
+    if (ret != ATK_MO1218_EOK)
+    {
+        return ret;
+    }
+    
+    rate = atk_mo1218_rate_fit(bytes_per_epoch, current, max_rate);
+    budget = g_rate_baudrate[current] / 10 * ATK_MO1218_RATE_LOAD_PERCENT / 100;
+    config.mask = ATK_MO1218_CONFIG_POSITION_RATE;
+    while (1)
+    {
+        config.position_rate = rate;
+        if (atk_mo1218_config_apply(&config, save_type) != ATK_MO1218_EOK)
+        {
+            return ATK_MO1218_ERROR;
+        }
+
+        if (rate == ATK_MO1218_POSITION_RATE_1HZ)
+        {
+            break;
+        }
+
+        /* 以新的位置更新频率复测，带宽不足或链路不健康时降一级 */
+        if ((atk_mo1218_rate_measure(&bytes_per_epoch) == ATK_MO1218_EOK) && ((bytes_per_epoch * g_rate_hz[rate]) <= budget) && (atk_mo1218_rate_listen(ATK_MO1218_RATE_PROBE_TIME) == ATK_MO1218_EOK))
+        {
+            break;
+        }
+
+        rate--;
+    }
+    
+    if (result != NULL)
+    {
+        result->baudrate = current;
+        result->position_rate = rate;
+        result->bytes_per_epoch = bytes_per_epoch;
+    }
+    
+    return ATK_MO1218_EOK;
+}
@@ -0,0 +1,535 @@
+/**
+ ****************************************************************************************************
+ * @file        atk_mo1218_satdb.c
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       ATK-MO1218模块卫星数据库代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#include "atk_mo1218_satdb.h"
+#include "atk_mo1218.h"
+#include <string.h>
+
+/* 数据库总容量，各星座依次占用一段连续的槽位 */
+#define ATK_MO1218_SATDB_GPS_BASE       0
+#define ATK_MO1218_SATDB_GLONASS_BASE   (ATK_MO1218_SATDB_GPS_BASE + ATK_MO1218_SATDB_GPS_CAPACITY)
+#define ATK_MO1218_SATDB_GALILEO_BASE   (ATK_MO1218_SATDB_GLONASS_BASE + ATK_MO1218_SATDB_GLONASS_CAPACITY)
+#define ATK_MO1218_SATDB_BEIDOU_BASE    (ATK_MO1218_SATDB_GALILEO_BASE + ATK_MO1218_SATDB_GALILEO_CAPACITY)
+#define ATK_MO1218_SATDB_QZSS_BASE      (ATK_MO1218_SATDB_BEIDOU_BASE + ATK_MO1218_SATDB_BEIDOU_CAPACITY)
+#define ATK_MO1218_SATDB_SIZE           (ATK_MO1218_SATDB_QZSS_BASE + ATK_MO1218_SATDB_QZSS_CAPACITY)
+
+/* PRN到槽位映射表中表示没有该卫星 */
+#define ATK_MO1218_SATDB_NO_SLOT    0xFF
+
+/* 各星座的卫星在GSA、GSV中的编号可能加上了该偏移（NMEA 4.x的编号范围） */
+#define ATK_MO1218_SATDB_GLONASS_ID_OFFSET  64
+#define ATK_MO1218_SATDB_GALILEO_ID_OFFSET  300
+#define ATK_MO1218_SATDB_BEIDOU_ID_OFFSET   200
+#define ATK_MO1218_SATDB_QZSS_ID_OFFSET     192
+
+/* ATK-MO1218模块卫星数据库
+ * 按字段分别存储，遍历某一字段（如查找过期卫星时的seen_tick）时访问的是连续的内存；
+ * 仅在主循环中修改
+ */
+static struct
+{
+    uint8_t prn[ATK_MO1218_SATDB_SIZE];             /* PRN，为0时槽位空闲 */
+    uint8_t elevation[ATK_MO1218_SATDB_SIZE];       /* 卫星仰角 */
+    uint16_t azimuth[ATK_MO1218_SATDB_SIZE];        /* 卫星方位角 */
+    uint8_t snr[ATK_MO1218_SATDB_SIZE];             /* 信噪比 */
+    uint8_t used[ATK_MO1218_SATDB_SIZE];            /* 用于定位 */
+    uint32_t seen_tick[ATK_MO1218_SATDB_SIZE];      /* 最近出现在GSV中的时间 */
+    uint32_t used_tick[ATK_MO1218_SATDB_SIZE];      /* 最近出现在GSA中的时间 */
+    uint32_t revision[ATK_MO1218_SATDB_SIZE];       /* 最近修改时的修订号 */
+    uint8_t gps_slot[ATK_MO1218_SATDB_GPS_PRN_MAX + 1];         /* GPS PRN到槽位的映射 */
+    uint8_t glonass_slot[ATK_MO1218_SATDB_GLONASS_PRN_MAX + 1]; /* GLONASS PRN到槽位的映射 */
+    uint8_t galileo_slot[ATK_MO1218_SATDB_GALILEO_PRN_MAX + 1]; /* Galileo PRN到槽位的映射 */
+    uint8_t beidou_slot[ATK_MO1218_SATDB_BEIDOU_PRN_MAX + 1];   /* 北斗PRN到槽位的映射 */
+    uint8_t qzss_slot[ATK_MO1218_SATDB_QZSS_PRN_MAX + 1];       /* QZSS PRN到槽位的映射 */
+    uint32_t current_revision;                      /* 当前修订号 */
+    uint32_t removed_revision;                      /* 最近移除卫星时的修订号 */
+    uint32_t epoch_tick;                            /* 当前历元开始的时间 */
+    uint8_t init;                                   /* 映射表已初始化 */
+} g_satdb = {0};
+
+/* ATK-MO1218模块卫星数据库各星座的槽位范围和PRN映射表 */
+static const struct
+{
+    uint8_t base;                                   /* 第一个槽位 */
+    uint8_t capacity;                               /* 槽位数量 */
+    uint8_t prn_max;                                /* 最大PRN */
+    uint16_t id_offset;                             /* 卫星编号的偏移 */
+    uint8_t *slot;                                  /* PRN到槽位的映射 */
+} g_satdb_constellation[ATK_MO1218_SATDB_CONSTELLATION_NUM] = {
+    {ATK_MO1218_SATDB_GPS_BASE,         ATK_MO1218_SATDB_GPS_CAPACITY,      ATK_MO1218_SATDB_GPS_PRN_MAX,       0,                                  g_satdb.gps_slot},      /* ATK_MO1218_SATDB_GPS */
+    {ATK_MO1218_SATDB_GLONASS_BASE,     ATK_MO1218_SATDB_GLONASS_CAPACITY,  ATK_MO1218_SATDB_GLONASS_PRN_MAX,   ATK_MO1218_SATDB_GLONASS_ID_OFFSET, g_satdb.glonass_slot},  /* ATK_MO1218_SATDB_GLONASS */
+    {ATK_MO1218_SATDB_GALILEO_BASE,     ATK_MO1218_SATDB_GALILEO_CAPACITY,  ATK_MO1218_SATDB_GALILEO_PRN_MAX,   ATK_MO1218_SATDB_GALILEO_ID_OFFSET, g_satdb.galileo_slot},  /* ATK_MO1218_SATDB_GALILEO */
+    {ATK_MO1218_SATDB_BEIDOU_BASE,      ATK_MO1218_SATDB_BEIDOU_CAPACITY,   ATK_MO1218_SATDB_BEIDOU_PRN_MAX,    ATK_MO1218_SATDB_BEIDOU_ID_OFFSET,  g_satdb.beidou_slot},   /* ATK_MO1218_SATDB_BEIDOU */
+    {ATK_MO1218_SATDB_QZSS_BASE,        ATK_MO1218_SATDB_QZSS_CAPACITY,     ATK_MO1218_SATDB_QZSS_PRN_MAX,      ATK_MO1218_SATDB_QZSS_ID_OFFSET,    g_satdb.qzss_slot},     /* ATK_MO1218_SATDB_QZSS */
+};
+
+/**
+ * @brief       初始化PRN到槽位的映射表
+ * @param       无
+ * @retval      无
+ */
+static void atk_mo1218_satdb_init(void)
+{
+    uint8_t constellation;
+    
+    if (g_satdb.init != 0)
+    {
+        return;
+    }
+    
+    for (constellation=0; constellation<ATK_MO1218_SATDB_CONSTELLATION_NUM; constellation++)
+    {
+        memset(g_satdb_constellation[constellation].slot, ATK_MO1218_SATDB_NO_SLOT, g_satdb_constellation[constellation].prn_max + 1);
+    }
+    g_satdb.init = 1;
+}
+
+/**
+ * @brief       根据发送者确定星座
+ * @param       talker       : 发送者
+ *              constellation: 星座
+ * @retval      ATK_MO1218_EOK  : 成功
+ *              ATK_MO1218_ERROR: 多星座联合定位（GN）或未知的发送者
+ */
+uint8_t atk_mo1218_satdb_get_constellation(atk_mo1218_nmea_talker_t talker, atk_mo1218_satdb_constellation_t *constellation)
+{
+    switch (talker)
+    {
+        case ATK_MO1218_NMEA_TALKER_GP:
+        {
+            *constellation = ATK_MO1218_SATDB_GPS;
+            break;
+        }
+        case ATK_MO1218_NMEA_TALKER_GL:
+        {
+            *constellation = ATK_MO1218_SATDB_GLONASS;
+            break;
+        }
+        case ATK_MO1218_NMEA_TALKER_GA:
+        {
+            *constellation = ATK_MO1218_SATDB_GALILEO;
+            break;
+        }
+        case ATK_MO1218_NMEA_TALKER_BD:
+        {
+            *constellation = ATK_MO1218_SATDB_BEIDOU;
+            break;
+        }
+        case ATK_MO1218_NMEA_TALKER_GQ:
+        {
+            *constellation = ATK_MO1218_SATDB_QZSS;
+            break;
+        }
+        default:
+        {
+            return ATK_MO1218_ERROR;
+        }
+    }
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取槽位所属的星座
+ * @param       slot: 槽位
+ * @retval      星座
+ */
+static atk_mo1218_satdb_constellation_t atk_mo1218_satdb_slot_constellation(uint8_t slot)
+{
+    uint8_t constellation;
+    
+    for (constellation=ATK_MO1218_SATDB_CONSTELLATION_NUM-1; constellation>0; constellation--)
+    {
+        if (slot >= g_satdb_constellation[constellation].base)
+        {
+            break;
+        }
+    }
+    
+    return (atk_mo1218_satdb_constellation_t)constellation;
+}
+
+/**
+ * @brief       根据发送者和卫星编号确定星座和PRN
+ * @note        $GNGSA中的星座由卫星编号的范围确定（北斗卫星的编号加上了ATK_MO1218_SATDB_BEIDOU_ID_OFFSET，其余星座类似）
+ * @param       talker       : 发送者
+ *              satellite_id : 卫星编号
+ *              constellation: 星座
+ *              prn          : PRN
+ * @retval      ATK_MO1218_EOK  : 成功
+ *              ATK_MO1218_ERROR: 不支持的星座或PRN超出范围
+ */
+uint8_t atk_mo1218_satdb_get_prn(atk_mo1218_nmea_talker_t talker, uint16_t satellite_id, atk_mo1218_satdb_constellation_t *constellation, uint8_t *prn)
+{
+    if (talker == ATK_MO1218_NMEA_TALKER_GN)
+    {
+        if (satellite_id > ATK_MO1218_SATDB_GALILEO_ID_OFFSET)
+        {
+            *constellation = ATK_MO1218_SATDB_GALILEO;
+        }
+        else if (satellite_id > ATK_MO1218_SATDB_BEIDOU_ID_OFFSET)
+        {
+            *constellation = ATK_MO1218_SATDB_BEIDOU;
+        }
+        else if (satellite_id > ATK_MO1218_SATDB_QZSS_ID_OFFSET)
+        {
+            *constellation = ATK_MO1218_SATDB_QZSS;
+        }
+        else if ((satellite_id > ATK_MO1218_SATDB_GLONASS_ID_OFFSET) && (satellite_id <= ATK_MO1218_SATDB_GLONASS_ID_OFFSET + ATK_MO1218_SATDB_GLONASS_PRN_MAX))
+        {
+            *constellation = ATK_MO1218_SATDB_GLONASS;
+        }
+        else
+        {
+            *constellation = ATK_MO1218_SATDB_GPS;
+        }
+    }
+    else if (atk_mo1218_satdb_get_constellation(talker, constellation) != ATK_MO1218_EOK)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    if (satellite_id > g_satdb_constellation[*constellation].id_offset)
+    {
+        satellite_id -= g_satdb_constellation[*constellation].id_offset;
+    }
+    
+    if ((satellite_id == 0) || (satellite_id > g_satdb_constellation[*constellation].prn_max))
+    {
+        return ATK_MO1218_ERROR;
+    }
+    *prn = satellite_id;
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       获取卫星的槽位，数据库中没有该卫星时分配新的槽位
+ * @param       constellation: 星座
+ *              prn          : PRN
+ * @retval      ATK_MO1218_SATDB_NO_SLOT: 星座的槽位已用完
+ *              其他                    : 槽位
+ */
+static uint8_t atk_mo1218_satdb_slot(atk_mo1218_satdb_constellation_t constellation, uint8_t prn)
+{
+    uint8_t slot;
+    uint8_t end;
+    
+    atk_mo1218_satdb_init();
+    
+    slot = g_satdb_constellation[constellation].slot[prn];
+    if (slot != ATK_MO1218_SATDB_NO_SLOT)
+    {
+        return slot;
+    }
+    
+    end = g_satdb_constellation[constellation].base + g_satdb_constellation[constellation].capacity;
+    for (slot=g_satdb_constellation[constellation].base; slot<end; slot++)
+    {
+        if (g_satdb.prn[slot] == 0)
+        {
+            g_satdb.prn[slot] = prn;
+            g_satdb.elevation[slot] = 0;
+            g_satdb.azimuth[slot] = 0;
+            g_satdb.snr[slot] = 0;
+            g_satdb.used[slot] = 0;
+            g_satdb.seen_tick[slot] = HAL_GetTick();
+            g_satdb.used_tick[slot] = 0;
+            g_satdb.revision[slot] = ++g_satdb.current_revision;
+            g_satdb_constellation[constellation].slot[prn] = slot;
+            return slot;
+        }
+    }
+    
+    return ATK_MO1218_SATDB_NO_SLOT;
+}
+
+/**
+ * @brief       将一组GSV语句的卫星信息加入数据库
+ * @note        在一组GSV语句收齐后调用
+ * @param       talker        : 发送者
+ *              satellite_info: 卫星信息
+ *              satellite_num : 卫星数量
+ * @retval      无
+ */
+void atk_mo1218_satdb_gsv_input(atk_mo1218_nmea_talker_t talker, const atk_mo1218_satellite_info_t *satellite_info, uint8_t satellite_num)
+{
+    uint8_t satellite_index;
+    atk_mo1218_satdb_constellation_t constellation;
+    uint8_t prn;
+    uint8_t slot;
+    
+    for (satellite_index=0; satellite_index<satellite_num; satellite_index++)
+    {
+        if (atk_mo1218_satdb_get_prn(talker, satellite_info[satellite_index].satellite_id, &constellation, &prn) != ATK_MO1218_EOK)
+        {
+            continue;
+        }
+        
+        slot = atk_mo1218_satdb_slot(constellation, prn);
+        if (slot == ATK_MO1218_SATDB_NO_SLOT)
+        {
+            continue;
+        }
+        
+        g_satdb.seen_tick[slot] = HAL_GetTick();
+        if ((g_satdb.elevation[slot] != satellite_info[satellite_index].elevation) ||
+            (g_satdb.azimuth[slot] != satellite_info[satellite_index].azimuth) ||
+            (g_satdb.snr[slot] != satellite_info[satellite_index].snr))
+        {
+            g_satdb.elevation[slot] = satellite_info[satellite_index].elevation;
+            g_satdb.azimuth[slot] = satellite_info[satellite_index].azimuth;
+            g_satdb.snr[slot] = satellite_info[satellite_index].snr;
+            g_satdb.revision[slot] = ++g_satdb.current_revision;
+        }
+    }
+}
+
+/**
+ * @brief       将一条GSA语句的定位卫星加入数据库
+ * @note        一个历元可能有多条GSA语句，未出现在本历元任何GSA语句中的卫星在atk_mo1218_satdb_epoch_end()中清除定位标志
+ * @param       talker       : 发送者
+ *              satellite_id : 卫星编号，为0的项被忽略
+ *              satellite_num: 卫星编号数量
+ * @retval      无
+ */
+void atk_mo1218_satdb_gsa_input(atk_mo1218_nmea_talker_t talker, const uint16_t *satellite_id, uint8_t satellite_num)
+{
+    uint8_t satellite_index;
+    atk_mo1218_satdb_constellation_t constellation;
+    uint8_t prn;
+    uint8_t slot;
+    
+    for (satellite_index=0; satellite_index<satellite_num; satellite_index++)
+    {
+        if (atk_mo1218_satdb_get_prn(talker, satellite_id[satellite_index], &constellation, &prn) != ATK_MO1218_EOK)
+        {
+            continue;
+        }
+        
+        slot = atk_mo1218_satdb_slot(constellation, prn);
+        if (slot == ATK_MO1218_SATDB_NO_SLOT)
+        {
+            continue;
+        }
+        
+        g_satdb.used_tick[slot] = HAL_GetTick();
+        if (g_satdb.used[slot] == 0)
+        {
+            g_satdb.used[slot] = 1;
+            g_satdb.revision[slot] = ++g_satdb.current_revision;
+        }
+    }
+}
+
+/**
+ * @brief       开始一个历元
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_satdb_epoch_begin(void)
+{
+    g_satdb.epoch_tick = HAL_GetTick();
+}
+
+/**
+ * @brief       结束一个历元，更新定位卫星并移除过期卫星
+ * @param       gsa_received: 本历元收到了GSA消息，为0时保持卫星的定位标志
+ * @retval      无
+ */
+void atk_mo1218_satdb_epoch_end(uint8_t gsa_received)
+{
+    uint32_t tick;
+    uint32_t last_tick;
+    uint8_t slot;
+    uint8_t constellation;
+    
+    tick = HAL_GetTick();
+    
+    for (slot=0; slot<ATK_MO1218_SATDB_SIZE; slot++)
+    {
+        if (g_satdb.prn[slot] == 0)
+        {
+            continue;
+        }
+        
+        /* 本历元的GSA语句中没有该卫星 */
+        if ((gsa_received != 0) && (g_satdb.used[slot] != 0) && ((int32_t)(g_satdb.used_tick[slot] - g_satdb.epoch_tick) < 0))
+        {
+            g_satdb.used[slot] = 0;
+            g_satdb.revision[slot] = ++g_satdb.current_revision;
+        }
+        
+        /* 长时间未出现在GSV和GSA中 */
+        last_tick = ((int32_t)(g_satdb.used_tick[slot] - g_satdb.seen_tick[slot]) > 0) ? g_satdb.used_tick[slot] : g_satdb.seen_tick[slot];
+        if ((tick - last_tick) > ATK_MO1218_SATDB_MAX_AGE)
+        {
+            constellation = atk_mo1218_satdb_slot_constellation(slot);
+            g_satdb_constellation[constellation].slot[g_satdb.prn[slot]] = ATK_MO1218_SATDB_NO_SLOT;
+            g_satdb.prn[slot] = 0;
+            g_satdb.removed_revision = ++g_satdb.current_revision;
+        }
+    }
+}
+
+/**
+ * @brief       获取数据库当前的修订号
+ * @param       无
+ * @retval      修订号
+ */
+uint32_t atk_mo1218_satdb_get_revision(void)
+{
+    return g_satdb.current_revision;
+}
+
+/**
+ * @brief       获取最近移除卫星时的修订号
+ * @note        大于读取方上次读取时的修订号时，读取方应丢弃已保存的卫星后重新读取全部卫星
+ * @param       无
+ * @retval      修订号
+ */
+uint32_t atk_mo1218_satdb_get_removed_revision(void)
+{
+    return g_satdb.removed_revision;
+}
+
+/**
+ * @brief       获取星座的卫星数量和定位卫星数量
+ * @param       constellation: 星座
+ *              used_num     : 定位卫星数量，为NULL时不获取
+ * @retval      卫星数量
+ */
+uint8_t atk_mo1218_satdb_get_num(atk_mo1218_satdb_constellation_t constellation, uint8_t *used_num)
+{
+    uint8_t slot;
+    uint8_t end;
+    uint8_t num = 0;
+    uint8_t _used_num = 0;
+    
+    if (constellation >= ATK_MO1218_SATDB_CONSTELLATION_NUM)
+    {
+        return 0;
+    }
+    
+    end = g_satdb_constellation[constellation].base + g_satdb_constellation[constellation].capacity;
+    for (slot=g_satdb_constellation[constellation].base; slot<end; slot++)
+    {
+        if (g_satdb.prn[slot] != 0)
+        {
+            num++;
+            _used_num += g_satdb.used[slot];
+        }
+    }
+    
+    if (used_num != NULL)
+    {
+        *used_num = _used_num;
+    }
+    
+    return num;
+}
+
+/**
+ * @brief       读取一个槽位的数据
+ * @param       slot : 槽位
+ *              entry: 卫星数据
+ * @retval      无
+ */
+static void atk_mo1218_satdb_read(uint8_t slot, atk_mo1218_satdb_entry_t *entry)
+{
+    entry->constellation = atk_mo1218_satdb_slot_constellation(slot);
+    entry->prn = g_satdb.prn[slot];
+    entry->elevation = g_satdb.elevation[slot];
+    entry->azimuth = g_satdb.azimuth[slot];
+    entry->snr = g_satdb.snr[slot];
+    entry->used = g_satdb.used[slot];
+    entry->seen_tick = g_satdb.seen_tick[slot];
+    entry->used_tick = g_satdb.used_tick[slot];
+    entry->revision = g_satdb.revision[slot];
+}
+
+/**
+ * @brief       获取指定卫星的数据
+ * @param       constellation: 星座
+ *              prn          : PRN
+ *              entry        : 卫星数据
+ * @retval      ATK_MO1218_EOK   : 获取成功
+ *              ATK_MO1218_ERROR : 数据库中没有该卫星
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_satdb_get(atk_mo1218_satdb_constellation_t constellation, uint8_t prn, atk_mo1218_satdb_entry_t *entry)
+{
+    uint8_t slot;
+    
+    if ((constellation >= ATK_MO1218_SATDB_CONSTELLATION_NUM) || (prn == 0) || (prn > g_satdb_constellation[constellation].prn_max) || (entry == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    if (g_satdb.init == 0)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    slot = g_satdb_constellation[constellation].slot[prn];
+    if (slot == ATK_MO1218_SATDB_NO_SLOT)
+    {
+        return ATK_MO1218_ERROR;
+    }
+    
+    atk_mo1218_satdb_read(slot, entry);
+    
+    return ATK_MO1218_EOK;
+}
+
+/**
+ * @brief       遍历指定修订号之后修改过的卫星
+ * @note        首次调用时*index置为0，每次调用返回一颗卫星，直到返回ATK_MO1218_ERROR；
+ *              读取全部卫星时revision为0
+ * @param       revision: 上次读取时的修订号（见atk_mo1218_satdb_get_revision()）
+ *              index   : 遍历位置
+ *              entry   : 卫星数据
+ * @retval      ATK_MO1218_EOK   : 获取到一颗卫星
+ *              ATK_MO1218_ERROR : 遍历结束
+ *              ATK_MO1218_EINVAL: 函数参数错误
+ */
+uint8_t atk_mo1218_satdb_get_changed(uint32_t revision, uint8_t *index, atk_mo1218_satdb_entry_t *entry)
+{
+    uint8_t slot;
+    
+    if ((index == NULL) || (entry == NULL))
+    {
+        return ATK_MO1218_EINVAL;
+    }
+    
+    for (slot=*index; slot<ATK_MO1218_SATDB_SIZE; slot++)
+    {
+        if ((g_satdb.prn[slot] != 0) && ((int32_t)(g_satdb.revision[slot] - revision) > 0))
+        {
+            atk_mo1218_satdb_read(slot, entry);
+            *index = slot + 1;
+            return ATK_MO1218_EOK;
+        }
+    }
+    
+    *index = ATK_MO1218_SATDB_SIZE;
+    
+    return ATK_MO1218_ERROR;
+}
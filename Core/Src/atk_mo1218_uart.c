@@ -25,7 +25,13 @@
 #include <string.h>
 
 static UART_HandleTypeDef g_uart_handle;                   /* ATK-MO1218 UART */
-g_uart_rx_frame_t g_uart_rx_frame = {0};                   /* ATK-MO1218 UART接收帧缓冲信息结构体 */
+static g_uart_rx_ring_t g_uart_rx_ring = {0};              /* ATK-MO1218 UART DMA循环接收缓冲 */
+
+/* ATK-MO1218 UART接收事件中断的状态，仅由中断修改 */
+static struct
+{
+    volatile uint32_t isr_max_cycles;                       /* 中断处理的最大耗时，单位：CPU周期 */
+} g_uart_rx_isr = {0};
 static uint8_t g_uart_tx_buf[ATK_MO1218_UART_TX_BUF_SIZE]; /* ATK-MO1218 UART发送缓冲 */
 
 /**
@@ -36,7 +42,8 @@ static uint8_t g_uart_tx_buf[ATK_MO1218_UART_TX_BUF_SIZE]; /* ATK-MO1218 UART发
  */
 void atk_mo1218_uart_send(uint8_t *dat, uint8_t len)
 {
-    HAL_UART_Transmit(&g_uart_handle, dat, len, HAL_MAX_DELAY);
+    /* UART由CubeMX初始化（huart2），g_uart_handle未初始化，不能用于发送 */
+    HAL_UART_Transmit(&huart2, dat, len, HAL_MAX_DELAY);
 }
 
 /**
@@ -58,78 +65,310 @@ void atk_mo1218_uart_printf(char *fmt, ...)
 }
 
 /**
- * @brief       ATK-MO1218 UART重新开始接收数据
+ * @brief       ATK-MO1218 UART初始化
+ * @param       baudrate: UART通讯波特率
+ * @retval      无
+ */
+void atk_mo1218_uart_init(uint32_t baudrate)
+{
+    g_uart_handle.Instance          = ATK_MO1218_UART_INTERFACE;    /* ATK-MO1218 UART */
+    g_uart_handle.Init.BaudRate     = baudrate;                     /* 波特率 */
+    g_uart_handle.Init.WordLength   = UART_WORDLENGTH_8B;           /* 数据位 */
+    g_uart_handle.Init.StopBits     = UART_STOPBITS_1;              /* 停止位 */
+    g_uart_handle.Init.Parity       = UART_PARITY_NONE;             /* 校验位 */
+    g_uart_handle.Init.Mode         = UART_MODE_TX_RX;              /* 收发模式 */
+    g_uart_handle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;          /* 无硬件流控 */
+    g_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;         /* 过采样 */
+    if (HAL_UART_Init(&g_uart_handle) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /* 使能ATK-MO1218 UART
+     * HAL_UART_Init()会调用函数HAL_UART_MspInit()
+     * 该函数定义在文件usart.c中
+     */
+
+}
+
+/**
+ * @brief       修改ATK-MO1218 UART通讯波特率
+ * @note        等待发送完成后重新配置UART，并重新启动循环DMA接收，
+ *              环形缓冲中未读取的数据被丢弃
+ * @param       baudrate: UART通讯波特率
+ * @retval      无
+ */
+void atk_mo1218_uart_set_baudrate(uint32_t baudrate)
+{
+    while (__HAL_UART_GET_FLAG(&huart2, UART_FLAG_TC) == RESET);
+    
+    HAL_UART_AbortReceive(&huart2);
+    huart2.Init.BaudRate = baudrate;
+    if (HAL_UART_Init(&huart2) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    
+    atk_mo1218_uart_rx_ring_start();
+}
+
+/**
+ * @brief       获取ATK-MO1218 UART通讯波特率
+ * @param       无
+ * @retval      UART通讯波特率
+ */
+uint32_t atk_mo1218_uart_get_baudrate(void)
+{
+    return huart2.Init.BaudRate;
+}
+
+/**
+ * @brief       启动ATK-MO1218 UART循环DMA接收
+ * @note        DMA工作在循环模式，启动后无需再重新配置，
+ *              IDLE、半传输和传输完成事件均会调用atk_mo1218_uart_rx_ring_update()
  * @param       无
  * @retval      无
  */
-void atk_mo1218_uart_rx_restart(void)
+void atk_mo1218_uart_rx_ring_start(void)
 {
-    g_uart_rx_frame.sta.len     = 0;
-    g_uart_rx_frame.sta.finsh   = 0;
-    u2_start_idle_receive(); // 自行添加的
+    /* 使能DWT周期计数器，用于统计中断处理耗时 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    g_uart_rx_ring.head = 0;
+    g_uart_rx_ring.resync = 1;                                  /* 由读取方丢弃重新启动前的数据 */
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart2, g_uart_rx_ring.buf, ATK_MO1218_UART_RX_RING_SIZE);
 }
 
 /**
- * @brief       获取ATK-MO1218 UART接收到的一帧数据
+ * @brief       根据DMA传输进度更新环形缓冲写位置
+ * @note        可在中断或应用中调用
  * @param       无
- * @retval      NULL: 未接收到一帧数据
- *              其他: 接收到的一帧数据
+ * @retval      无
  */
-uint8_t *atk_mo1218_uart_rx_get_frame(void)
+void atk_mo1218_uart_rx_ring_update(void)
 {
-    if (g_uart_rx_frame.sta.finsh == 1)
+    uint32_t primask;
+    uint16_t pos;
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    pos = ATK_MO1218_UART_RX_RING_SIZE - __HAL_DMA_GET_COUNTER(huart2.hdmarx);
+    if (pos >= ATK_MO1218_UART_RX_RING_SIZE)
     {
-        g_uart_rx_frame.buf[g_uart_rx_frame.sta.len] = '\0';
-        return g_uart_rx_frame.buf;
+        pos = 0;
     }
-    else
+    
+    g_uart_rx_ring.head_cnt += (uint16_t)(pos + ATK_MO1218_UART_RX_RING_SIZE - g_uart_rx_ring.head) % ATK_MO1218_UART_RX_RING_SIZE;
+    g_uart_rx_ring.head = pos;
+    
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief       ATK-MO1218 UART接收事件处理
+ * @note        在HAL_UARTEx_RxEventCallback()中调用，仅更新写位置，
+ *              数据的提取和解析在应用中完成，见atk_mo1218_get_nmea_sentence()
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_uart_rx_event_from_isr(void)
+{
+    uint32_t cycles;
+    
+    cycles = DWT->CYCCNT;
+    
+    atk_mo1218_uart_rx_ring_update();
+    
+    cycles = DWT->CYCCNT - cycles;
+    if (cycles > g_uart_rx_isr.isr_max_cycles)
     {
-        return NULL;
+        g_uart_rx_isr.isr_max_cycles = cycles;
     }
 }
 
 /**
- * @brief       获取ATK-MO1218 UART接收到的一帧数据的长度
+ * @brief       获取接收事件中断处理的最大耗时
+ * @param       无
+ * @retval      最大耗时，单位：CPU周期（72MHz下72个周期为1微秒）
+ */
+uint32_t atk_mo1218_uart_rx_get_isr_max_cycles(void)
+{
+    return g_uart_rx_isr.isr_max_cycles;
+}
+
+/**
+ * @brief       获取环形缓冲中未读取数据的长度
+ * @note        若DMA已覆盖未读取的数据，则丢弃全部未读取数据并记录一次溢出
  * @param       无
- * @retval      0   : 未接收到一帧数据
- *              其他: 接收到的一帧数据的长度
+ * @retval      未读取数据的长度
  */
-uint16_t atk_mo1218_uart_rx_get_frame_len(void)
+uint16_t atk_mo1218_uart_rx_ring_available(void)
 {
-    if (g_uart_rx_frame.sta.finsh == 1)
+    uint32_t primask;
+    uint32_t len;
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    if (g_uart_rx_ring.resync != 0)
     {
-        return g_uart_rx_frame.sta.len;
+        g_uart_rx_ring.resync = 0;
+        g_uart_rx_ring.tail = g_uart_rx_ring.head;
+        g_uart_rx_ring.tail_cnt = g_uart_rx_ring.head_cnt;
     }
-    else
+    
+    len = g_uart_rx_ring.head_cnt - g_uart_rx_ring.tail_cnt;
+    if (len >= ATK_MO1218_UART_RX_RING_SIZE)
+    {
+        g_uart_rx_ring.overflow++;
+        g_uart_rx_ring.tail = g_uart_rx_ring.head;
+        g_uart_rx_ring.tail_cnt = g_uart_rx_ring.head_cnt;
+        len = 0;
+    }
+    
+    __set_PRIMASK(primask);
+    
+    return (uint16_t)len;
+}
+
+/**
+ * @brief       获取环形缓冲中可连续读取的数据块
+ * @note        数据块直接指向DMA接收缓冲，读取完毕后需调用atk_mo1218_uart_rx_ring_consume()释放
+ * @param       block: 数据块的起始地址
+ * @retval      数据块的长度
+ */
+uint16_t atk_mo1218_uart_rx_ring_get_block(uint8_t **block)
+{
+    uint16_t len;
+    
+    if (block == NULL)
     {
         return 0;
     }
+    
+    len = atk_mo1218_uart_rx_ring_available();
+    if (len > (ATK_MO1218_UART_RX_RING_SIZE - g_uart_rx_ring.tail))
+    {
+        len = ATK_MO1218_UART_RX_RING_SIZE - g_uart_rx_ring.tail;
+    }
+    
+    *block = &g_uart_rx_ring.buf[g_uart_rx_ring.tail];
+    
+    return len;
 }
 
 /**
- * @brief       ATK-MO1218 UART初始化
- * @param       baudrate: UART通讯波特率
+ * @brief       释放环形缓冲中已读取的数据
+ * @param       len: 已读取数据的长度
  * @retval      无
  */
-void atk_mo1218_uart_init(uint32_t baudrate)
+void atk_mo1218_uart_rx_ring_consume(uint16_t len)
 {
-    g_uart_handle.Instance          = ATK_MO1218_UART_INTERFACE;    /* ATK-MO1218 UART */
-    g_uart_handle.Init.BaudRate     = baudrate;                     /* 波特率 */
-    g_uart_handle.Init.WordLength   = UART_WORDLENGTH_8B;           /* 数据位 */
-    g_uart_handle.Init.StopBits     = UART_STOPBITS_1;              /* 停止位 */
-    g_uart_handle.Init.Parity       = UART_PARITY_NONE;             /* 校验位 */
-    g_uart_handle.Init.Mode         = UART_MODE_TX_RX;              /* 收发模式 */
-    g_uart_handle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;          /* 无硬件流控 */
-    g_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;         /* 过采样 */
-    if (HAL_UART_Init(&g_uart_handle) != HAL_OK)
+    g_uart_rx_ring.tail = (g_uart_rx_ring.tail + len) % ATK_MO1218_UART_RX_RING_SIZE;
+    g_uart_rx_ring.tail_cnt += len;
+}
+
+/**
+ * @brief       从环形缓冲中读取数据
+ * @param       buf: 读取数据的缓冲
+ *              len: 最多读取数据的长度
+ * @retval      实际读取数据的长度
+ */
+uint16_t atk_mo1218_uart_rx_ring_read(uint8_t *buf, uint16_t len)
+{
+    uint8_t *block;
+    uint16_t block_len;
+    uint16_t read_len = 0;
+    
+    if (buf == NULL)
     {
-        Error_Handler();
+        return 0;
     }
-    /* 使能ATK-MO1218 UART
-     * HAL_UART_Init()会调用函数HAL_UART_MspInit()
-     * 该函数定义在文件usart.c中
-     */
+    
+    while (read_len < len)
+    {
+        block_len = atk_mo1218_uart_rx_ring_get_block(&block);
+        if (block_len == 0)
+        {
+            break;
+        }
+        
+        if (block_len > (len - read_len))
+        {
+            block_len = len - read_len;
+        }
+        
+        memcpy(&buf[read_len], block, block_len);
+        atk_mo1218_uart_rx_ring_consume(block_len);
+        read_len += block_len;
+    }
+    
+    return read_len;
+}
 
+/**
+ * @brief       从环形缓冲中复制数据，不释放
+ * @note        用于拼接跨越环形缓冲末尾的数据，复制后仍需调用atk_mo1218_uart_rx_ring_consume()释放
+ * @param       buf: 复制数据的缓冲
+ *              len: 最多复制数据的长度
+ * @retval      实际复制数据的长度
+ */
+uint16_t atk_mo1218_uart_rx_ring_peek(uint8_t *buf, uint16_t len)
+{
+    uint16_t available;
+    uint16_t first_len;
+    
+    if (buf == NULL)
+    {
+        return 0;
+    }
+    
+    available = atk_mo1218_uart_rx_ring_available();
+    if (len > available)
+    {
+        len = available;
+    }
+    
+    first_len = ATK_MO1218_UART_RX_RING_SIZE - g_uart_rx_ring.tail;
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+    
+    memcpy(buf, &g_uart_rx_ring.buf[g_uart_rx_ring.tail], first_len);
+    memcpy(&buf[first_len], &g_uart_rx_ring.buf[0], len - first_len);
+    
+    return len;
+}
+
+/**
+ * @brief       丢弃环形缓冲中未读取的数据
+ * @param       无
+ * @retval      无
+ */
+void atk_mo1218_uart_rx_ring_flush(void)
+{
+    uint32_t primask;
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    g_uart_rx_ring.resync = 0;
+    g_uart_rx_ring.tail = g_uart_rx_ring.head;
+    g_uart_rx_ring.tail_cnt = g_uart_rx_ring.head_cnt;
+    
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief       获取环形缓冲溢出次数
+ * @param       无
+ * @retval      溢出次数
+ */
+uint32_t atk_mo1218_uart_rx_ring_get_overflow(void)
+{
+    return g_uart_rx_ring.overflow;
 }
 
 // /**
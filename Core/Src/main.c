@@ -34,6 +34,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define USER_GPS_DEBUG 0        /* 为1时每个历元额外打印卫星数据库、串口、队列和NMEA消息的统计信息，以及不完整的历元 */
 
 /* USER CODE END PD */
 
@@ -45,7 +46,7 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-
+uint8_t print_mode = 1; /* 串口屏打印模式，由串口屏发来的命令切换 */
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -59,68 +60,113 @@ void SystemClock_Config(void);
 
 #include<string.h>
 #include "atk_mo1218.h"
+#include "atk_mo1218_ephemeris.h"
 #include "delay.h"
 
-typedef struct
+/* ATK-MO1218模块配置，未列入mask的配置项保持模块当前配置 */
+static const atk_mo1218_config_t user_gps_config =
 {
-  uint8_t ret;
-  atk_mo1218_time_t utc;
-  atk_mo1218_position_t position;
-  int16_t altitude;
-  uint16_t speed;
-  atk_mo1218_fix_info_t fix_info;
-  atk_mo1218_visible_satellite_info_t gps_satellite_info;
-  atk_mo1218_visible_satellite_info_t beidou_satellite_info;
-  uint8_t satellite_index;
-} user_gps_data_t;
-
-user_gps_data_t gps_data;
+  .mask = ATK_MO1218_CONFIG_OUTPUT_TYPE | ATK_MO1218_CONFIG_NMEA_INTERVAL | ATK_MO1218_CONFIG_GNSS,
+  .output_type = ATK_MO1218_OUTPUT_NMEA,
+  .nmea_interval = {.gga = 1, .gsa = 1, .gsv = 1, .gll = 1, .rmc = 1, .vtg = 1, .zda = 0, .gbs = 1, .gst = 1},
+  .gnss = ATK_MO1218_GNSS_GPS_BEIDOU,
+};
 
 uint8_t user_gps_init(void)
 {
   uint8_t ret;
+  atk_mo1218_rate_result_t rate_result;
 
   /* 初始化ATK-MO1218模块 */
-  ret = atk_mo1218_init(38400);  // 注意 UART 初始化已经由 CubeMX 接管，此处设置的波特率无效。
+  ret = atk_mo1218_init(38400);  // 模块无响应时自动探测其当前波特率（如只复位了MCU）
   // if (ret != 0)
   // {
   //   u1_printf("ATK-MO1218 init failed!\r\n");
   //   return 1;
   // }
 
-  /* 配置ATK-MO1218模块 */
-  ret = atk_mo1218_factory_reset(ATK_MO1218_FACTORY_RESET_REBOOT);
-  ret += atk_mo1218_config_output_type(ATK_MO1218_OUTPUT_NMEA, ATK_MO1218_SAVE_SRAM);
-  ret += atk_mo1218_config_nmea_msg(1, 1, 1, 1, 1, 1, 0, ATK_MO1218_SAVE_SRAM);
-  ret += atk_mo1218_config_position_rate(ATK_MO1218_POSITION_RATE_1HZ, ATK_MO1218_SAVE_SRAM);
-  ret += atk_mo1218_config_gnss_for_navigation(ATK_MO1218_GNSS_GPS_BEIDOU, ATK_MO1218_SAVE_SRAM);
+  /* 配置ATK-MO1218模块
+   * 先读取模块当前配置，只发送不同的配置项；配置保存到模块Flash，下次上电通常无需再发送
+   * 输出类型无法读取，每次上电都发送，但只写入模块SRAM
+   */
+  ret = atk_mo1218_config_apply(&user_gps_config, ATK_MO1218_SAVE_SRAM_FLASH);
   if (ret != 0)
   {
     u1_printf("ATK-MO1218 configure failed!\r\n");
     return 2;
   }
+
+  /* 提升波特率，并按实测的每个历元字节数选择最高的位置更新频率
+   * 只保存到模块SRAM，模块掉电后恢复为38400bps、1Hz
+   */
+  ret = atk_mo1218_rate_negotiate(ATK_MO1218_SERIAL_BAUDRATE_115200, ATK_MO1218_POSITION_RATE_10HZ, ATK_MO1218_SAVE_SRAM, &rate_result);
+  if (ret != 0)
+  {
+    u1_printf("ATK-MO1218 rate negotiation failed!\r\n");
+    return 3;
+  }
+  u1_printf("ATK-MO1218 rate: baudrate index %d, position rate index %d, %lu bytes/epoch\r\n", rate_result.baudrate, rate_result.position_rate, (unsigned long)rate_result.bytes_per_epoch);
   return 0;
 }
 
-void user_gps_getdata(void)
+/**
+ * @description: 打印定位历元中的误差统计（GST）和故障卫星（GBS），这两条消息通常在历元完成后才收到
+ * @param {atk_mo1218_fix_t} *fix
+ * @return {*}
+ */
+static void user_gps_print_integrity(const atk_mo1218_fix_t *fix)
 {
-  /* 结构体清零 */
-  memset(&gps_data, 0, sizeof(gps_data));
+  /* 纬度、经度、高度误差的标准差（扩大了100倍） */
+  if ((fix->mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GST)) != 0)
+  {
+    u1_printf("Accuracy: lat %ld.%02ldm, lon %ld.%02ldm, alt %ld.%02ldm\r\n", (long)(fix->accuracy.latitude_deviation / 100), (long)(fix->accuracy.latitude_deviation % 100), (long)(fix->accuracy.longitude_deviation / 100), (long)(fix->accuracy.longitude_deviation % 100), (long)(fix->accuracy.altitude_deviation / 100), (long)(fix->accuracy.altitude_deviation % 100));
+  }
 
-  // TODO: 把这些下面获取到的信息保存进结构体
+  /* 检测到的故障卫星及其偏差估计（扩大了100倍） */
+  if (((fix->mask & ATK_MO1218_NMEA_MSG_MASK(ATK_MO1218_NMEA_MSG_GBS)) != 0) && ((fix->integrity.valid & ATK_MO1218_NMEA_GBS_SATELLITE_ID) != 0))
+  {
+    u1_printf("Failed satellite: %d, bias: %ldcm\r\n", fix->integrity.satellite_id, (long)fix->integrity.bias);
+  }
+}
 
+void user_gps_fix_callback(const atk_mo1218_fix_t *fix, uint8_t republished)
+{
   uint8_t ret;
   atk_mo1218_time_t utc;
   atk_mo1218_position_t position;
-  int16_t altitude;
+  int32_t altitude;
   uint16_t speed;
   atk_mo1218_fix_info_t fix_info;
-  atk_mo1218_visible_satellite_info_t gps_satellite_info = {0};
-  atk_mo1218_visible_satellite_info_t beidou_satellite_info = {0};
   uint8_t satellite_index;
+#if USER_GPS_DEBUG
+  atk_mo1218_nmea_stats_t nmea_stats;
+  uint32_t nmea_bad_checksum;
+  uint32_t nmea_truncated;
+  uint8_t nmea_index;
+  uart_tx_stats_t tx_stats;
+  spsc_queue_stats_t queue_stats;
+  uint8_t satdb_num;
+  uint8_t satdb_used_num;
+#endif
+
+  /* 从定位历元中取出数据 */
+  ret = ((fix->mask & ATK_MO1218_EPOCH_REQUIRED_DEFAULT) == ATK_MO1218_EPOCH_REQUIRED_DEFAULT) ? ATK_MO1218_EOK : ATK_MO1218_ERROR;
+  utc = fix->utc;
+  position = fix->position;
+  altitude = fix->altitude;
+  speed = fix->speed;
+  fix_info = fix->fix_info;
+
+  /* 同一历元再次发布时只打印后到的数据，不重复打印整个历元 */
+  if (republished != 0)
+  {
+    if (ret == ATK_MO1218_EOK)
+    {
+      user_gps_print_integrity(fix);
+    }
+    return;
+  }
 
-  /* 获取并更新ATK-MO1218模块数据 */
-  ret = atk_mo1218_update(&utc, &position, &altitude, &speed, &fix_info, NULL, NULL, 5000);
   if (ret == ATK_MO1218_EOK)
   {
     u1_printf("\r\n");
@@ -132,7 +178,7 @@ void user_gps_getdata(void)
     u1_printf("Position: %d.%d'%s %d.%d'%s\r\n", position.longitude.degree / 100000, position.longitude.degree % 100000, (position.longitude.indicator == ATK_MO1218_LONGITUDE_EAST) ? "E" : "W", position.latitude.degree / 100000, position.latitude.degree % 100000, (position.latitude.indicator == ATK_MO1218_LATITUDE_NORTH) ? "N" : "S");
 
     /* 海拔高度（放大了10倍） */
-    u1_printf("Altitude: %d.%dm\r\n", altitude / 10, altitude % 10);
+    u1_printf("Altitude: %ld.%ldm\r\n", (long)(altitude / 10), (long)(altitude % 10));
 
     /* 速度（放大了10倍） */
     u1_printf("Speed: %d.%dKm/H\r\n", speed / 10, speed % 10);
@@ -147,14 +193,14 @@ void user_gps_getdata(void)
     u1_printf("Fix type: %s\r\n", (fix_info.type == ATK_MO1218_FIX_NOT_AVAILABLE) ? "Unavailable" : ((fix_info.type == ATK_MO1218_FIX_2D) ? "2D" : "3D"));
 
     /* 用于定位的卫星编号 */
-    for (satellite_index = 0; satellite_index < fix_info.satellite_num; satellite_index++)
+    for (satellite_index = 0; satellite_index < fix_info.satellite_id_num; satellite_index++)
     {
       if (satellite_index == 0)
       {
         u1_printf("Satellite ID:");
       }
       u1_printf(" %d", fix_info.satellite_id[satellite_index]);
-      if (satellite_index == fix_info.satellite_num - 1)
+      if (satellite_index == fix_info.satellite_id_num - 1)
       {
         u1_printf("\r\n");
       }
@@ -165,21 +211,82 @@ void user_gps_getdata(void)
     u1_printf("HDOP: %d.%d\r\n", fix_info.hdop / 10, fix_info.hdop % 10);
     u1_printf("VDOP: %d.%d\r\n", fix_info.vdop / 10, fix_info.vdop % 10);
 
+    /* 误差统计和故障卫星 */
+    user_gps_print_integrity(fix);
+
     /* 可见的GPS、北斗卫星数量 */
-    u1_printf("Number of GPS visible satellite: %d\r\n", gps_satellite_info.satellite_num);
-    u1_printf("Number of Beidou visible satellite: %d\r\n", beidou_satellite_info.satellite_num);
+    u1_printf("Number of GPS visible satellite: %d\r\n", fix->satellite_info[ATK_MO1218_SATDB_GPS].satellite_view);
+    u1_printf("Number of Beidou visible satellite: %d\r\n", fix->satellite_info[ATK_MO1218_SATDB_BEIDOU].satellite_view);
+
+#if USER_GPS_DEBUG
+    /* 卫星数据库中的卫星数量和用于定位的卫星数量 */
+    satdb_num = atk_mo1218_satdb_get_num(ATK_MO1218_SATDB_GPS, &satdb_used_num);
+    u1_printf("(DBG) satdb GPS: %d tracked, %d used\r\n", satdb_num, satdb_used_num);
+    satdb_num = atk_mo1218_satdb_get_num(ATK_MO1218_SATDB_BEIDOU, &satdb_used_num);
+    u1_printf("(DBG) satdb Beidou: %d tracked, %d used\r\n", satdb_num, satdb_used_num);
+
+    /* 接收中断的最大耗时、环形缓冲溢出次数 */
+    u1_printf("(DBG) USART2 ISR max: %lu cycles, ring overflow: %lu\r\n", (unsigned long)atk_mo1218_uart_rx_get_isr_max_cycles(), (unsigned long)atk_mo1218_uart_rx_ring_get_overflow());
+
+    /* USART1 发送队列的最大占用和丢弃的消息数 */
+    uart_tx_get_stats(&huart1, &tx_stats);
+    u1_printf("(DBG) USART1 TX high water: %u bytes, dropped: %lu\r\n", tx_stats.high_water, (unsigned long)tx_stats.dropped);
+
+    /* 各队列的最大占用和溢出数、串口错误次数 */
+    atk_mo1218_get_fix_event_stats(&queue_stats);
+    u1_printf("(DBG) fix event queue high water: %u, dropped: %lu\r\n", queue_stats.high_water, (unsigned long)queue_stats.overflow);
+    u3_get_rx_stats(&queue_stats);
+    u1_printf("(DBG) USART3 frame queue high water: %u, dropped: %lu, truncated: %lu\r\n", queue_stats.high_water, (unsigned long)queue_stats.overflow, (unsigned long)u3_get_rx_truncated());
+    u1_printf("(DBG) UART errors: USART2 %lu, USART3 %lu\r\n", (unsigned long)uart_get_error_count(&huart2), (unsigned long)uart_get_error_count(&huart3));
+
+    /* NMEA消息校验和错误、不完整的总数 */
+    atk_mo1218_get_nmea_stats(&nmea_stats);
+    nmea_bad_checksum = nmea_stats.unknown.bad_checksum;
+    nmea_truncated = nmea_stats.unknown.truncated;
+    for (nmea_index = 0; nmea_index < ATK_MO1218_NMEA_MSG_NUM; nmea_index++)
+    {
+      nmea_bad_checksum += nmea_stats.msg[nmea_index].bad_checksum;
+      nmea_truncated += nmea_stats.msg[nmea_index].truncated;
+    }
+    u1_printf("(DBG) NMEA %s ok: %lu, bad checksum: %lu, truncated: %lu\r\n", atk_mo1218_get_nmea_msg_address(ATK_MO1218_NMEA_MSG_GGA), (unsigned long)nmea_stats.msg[ATK_MO1218_NMEA_MSG_GGA].ok, (unsigned long)nmea_bad_checksum, (unsigned long)nmea_truncated);
+
+    /* 首次定位时间 */
+    u1_printf("(DBG) TTFF: %lu ms\r\n", (unsigned long)atk_mo1218_ephemeris_get_ttff());
+#endif
 
     u1_printf("\r\n");
   }
+#if USER_GPS_DEBUG
   else
   {
-    /* ATK-MO1218模块未定位时，
-     * 不输出NMEA协议的GSV语句，
-     * 导致因获取不到可见GPS、北斗卫星的信息而超时失败，
-     * 此时可将函数atk_mo1218_update()的入参gps_satellite_info和beidou_satellite_info
-     * 传入NULL，从而获取未定位时的其他数据
-     */
-    u1_printf("(DBG) atk_mo1218_update Error\r\n");
+    /* 下一个历元已开始，但本历元缺少所需的NMEA消息 */
+    u1_printf("(DBG) incomplete epoch, mask: 0x%02lX\r\n", (unsigned long)fix->mask);
+  }
+#endif
+}
+
+void user_hmi_process(void)
+{
+  usart3_rx_frame_t frame;
+
+  /* 接收中断把每帧放入队列并立即重新启动接收，这里逐帧处理 */
+  while (u3_get_frame(&frame) == 0)
+  {
+    // 判断举例：
+    if (frame.len > 1)
+    {
+      if (frame.data[1] == 0x01)
+      {
+        print_mode = 1; // print mode 用于后续控制打印给串口屏的内容
+      }
+      else if (frame.data[1] == 0x02)
+      {
+        print_mode = 2;
+      }
+    }
+
+    // 以下 todo: for test only, 实现把接受到的数据从 USART3 重新发送出去。
+    u3_write(frame.data, frame.len);
   }
 }
 
@@ -221,7 +328,10 @@ int main(void)
   delay_init(72);
   u1_printf("(DBG) System Started.\r\n");
   u2_start_idle_receive();
-  // user_gps_init(); // 其实不需要
+  atk_mo1218_set_fix_callback(user_gps_fix_callback);
+  atk_mo1218_ephemeris_init();
+  /* 配置只发送与模块当前配置不同的项，配置一致时只有几次查询，无需再跳过初始化 */
+  user_gps_init();
   u3_start_idle_receive();
 
   
@@ -231,8 +341,10 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-    // user_gps_getdata();
-    delay_ms(200);
+    /* 中断只负责接收，GPS数据的解析在主循环中完成，定位历元完成时回调打印 */
+    atk_mo1218_process();
+    atk_mo1218_ephemeris_process();
+    user_hmi_process();
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
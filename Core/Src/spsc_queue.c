@@ -0,0 +1,149 @@
+/**
+ ****************************************************************************************************
+ * @file        spsc_queue.c
+ * @author      正点原子团队(ALIENTEK)
+ * @version     V1.0
+ * @date        2022-06-21
+ * @brief       单生产者单消费者无锁队列代码
+ * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
+ ****************************************************************************************************
+ * @attention
+ *
+ * 实验平台:正点原子 MiniSTM32 V4开发板
+ * 在线视频:www.yuanzige.com
+ * 技术论坛:www.openedv.com
+ * 公司网址:www.alientek.com
+ * 购买地址:openedv.taobao.com
+ *
+ ****************************************************************************************************
+ */
+
+#include "spsc_queue.h"
+#include <string.h>
+
+/**
+ * @brief       元素入队
+ * @note        仅由生产者调用；元素拷贝完成后才发布写索引，消费者不会读到不完整的元素
+ * @param       queue: 队列
+ *              elem : 入队的元素
+ * @retval      SPSC_QUEUE_EOK  : 入队成功
+ *              SPSC_QUEUE_ERROR: 队列满，元素被丢弃
+ */
+uint8_t spsc_queue_push(spsc_queue_t *queue, const void *elem)
+{
+    uint16_t wr = queue->wr;
+    uint16_t count;
+    
+    count = (uint16_t)(wr - queue->rd);
+    if (count >= queue->size)
+    {
+        queue->overflow++;
+        return SPSC_QUEUE_ERROR;
+    }
+    
+    memcpy(&queue->buf[(wr & (queue->size - 1)) * queue->elem_size], elem, queue->elem_size);
+    __DMB();                                                /* 元素写入完成后再发布 */
+    queue->wr = wr + 1;
+    
+    if ((count + 1) > queue->high_water)
+    {
+        queue->high_water = count + 1;
+    }
+    
+    return SPSC_QUEUE_EOK;
+}
+
+/**
+ * @brief       获取队首元素，不出队
+ * @note        仅由消费者调用，元素在调用spsc_queue_release()前有效
+ * @param       queue: 队列
+ * @retval      NULL: 队列空
+ *              其他: 队首元素
+ */
+void *spsc_queue_front(spsc_queue_t *queue)
+{
+    uint16_t rd = queue->rd;
+    
+    if (rd == queue->wr)
+    {
+        return NULL;
+    }
+    
+    __DMB();                                                /* 读到写索引后再读元素 */
+    
+    return &queue->buf[(rd & (queue->size - 1)) * queue->elem_size];
+}
+
+/**
+ * @brief       释放队首元素
+ * @note        仅由消费者调用，元素读取完成后才发布读索引，生产者不会覆盖正在读取的元素
+ * @param       queue: 队列
+ * @retval      无
+ */
+void spsc_queue_release(spsc_queue_t *queue)
+{
+    if (queue->rd == queue->wr)
+    {
+        return;
+    }
+    
+    __DMB();
+    queue->rd++;
+}
+
+/**
+ * @brief       元素出队
+ * @param       queue: 队列
+ *              elem : 出队的元素
+ * @retval      SPSC_QUEUE_EOK  : 出队成功
+ *              SPSC_QUEUE_ERROR: 队列空
+ */
+uint8_t spsc_queue_pop(spsc_queue_t *queue, void *elem)
+{
+    void *front;
+    
+    front = spsc_queue_front(queue);
+    if (front == NULL)
+    {
+        return SPSC_QUEUE_ERROR;
+    }
+    
+    memcpy(elem, front, queue->elem_size);
+    spsc_queue_release(queue);
+    
+    return SPSC_QUEUE_EOK;
+}
+
+/**
+ * @brief       丢弃队列中的全部元素
+ * @note        仅由消费者调用
+ * @param       queue: 队列
+ * @retval      无
+ */
+void spsc_queue_flush(spsc_queue_t *queue)
+{
+    __DMB();
+    queue->rd = queue->wr;
+}
+
+/**
+ * @brief       获取队列中的元素个数
+ * @param       queue: 队列
+ * @retval      元素个数
+ */
+uint16_t spsc_queue_count(spsc_queue_t *queue)
+{
+    return (uint16_t)(queue->wr - queue->rd);
+}
+
+/**
+ * @brief       获取队列统计
+ * @param       queue: 队列
+ *              stats: 队列统计
+ * @retval      无
+ */
+void spsc_queue_get_stats(spsc_queue_t *queue, spsc_queue_stats_t *stats)
+{
+    stats->high_water = queue->high_water;
+    stats->overflow = queue->overflow;
+}
@@ -27,6 +27,7 @@
 #include<stdio.h>
 
 #include "atk_mo1218_uart.h"
+#include "spsc_queue.h"
 
 uint8_t USART1_TxBUF[USART1_MAX_SENDLEN];
 uint8_t USART1_RxBUF[USART1_MAX_RECVLEN];
@@ -34,17 +35,47 @@ uint8_t USART2_TxBUF[USART2_MAX_SENDLEN];
 uint8_t USART2_RxBUF[USART2_MAX_RECVLEN];
 uint8_t USART3_TxBUF[USART3_MAX_SENDLEN];
 uint8_t USART3_RxBUF[USART3_MAX_RECVLEN];
-volatile uint16_t USART2_RxLen = 0, USART3_RxLen = 0;
-volatile uint8_t USART2_RecvEndFlag = 0, USART3_RecvEndFlag = 0;
-volatile uint8_t print_mode = 1;
+volatile uint16_t USART2_RxLen = 0;
+volatile uint8_t USART2_RecvEndFlag = 0;
+
+/* USART3 接收帧队列，接收中断为生产者，主循环为消费者 */
+SPSC_QUEUE_DEFINE(g_u3_rx_queue, usart3_rx_frame_t, USART3_RX_FRAME_QUEUE_SIZE);
+
+/* USART3 超过 USART3_RX_FRAME_MAXLEN 被截断的帧数，仅由接收中断修改 */
+static volatile uint32_t g_u3_rx_truncated = 0;
+
+/* 串口错误计数，仅由错误中断回调修改，在主循环中打印 */
+static volatile uint32_t g_uart_error_count[3] = {0};
+
+/* USART1/USART3 发送队列
+ * 消息按字节写入环形缓冲，DMA 从 tail 起发送一段连续的数据，发送完成中断中接着发送下一段，
+ * 调用 u1_printf()/u3_printf() 只需格式化和拷贝，不等待串口发送；
+ * 主循环为唯一的生产者，只写 head，发送完成中断为消费者，只写 tail，拷贝数据时无需关中断
+ */
+typedef struct
+{
+  UART_HandleTypeDef *huart;
+  uint8_t *buf;
+  uint16_t size;
+  uart_tx_policy_t policy;
+  volatile uint16_t head;               /* 写入位置 */
+  volatile uint16_t tail;               /* 发送位置 */
+  volatile uint16_t dma_len;            /* 正在由 DMA 发送的字节数，0 表示 DMA 空闲 */
+  uart_tx_stats_t stats;
+} uart_tx_queue_t;
+
+static uart_tx_queue_t g_u1_tx = {&huart1, USART1_TxBUF, USART1_MAX_SENDLEN, UART_TX_POLICY_DROP, 0, 0, 0, {0}};
+static uart_tx_queue_t g_u3_tx = {&huart3, USART3_TxBUF, USART3_MAX_SENDLEN, UART_TX_POLICY_BLOCK, 0, 0, 0, {0}};
 
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart2;
 UART_HandleTypeDef huart3;
+DMA_HandleTypeDef hdma_usart1_tx;
 DMA_HandleTypeDef hdma_usart2_rx;
 DMA_HandleTypeDef hdma_usart3_rx;
+DMA_HandleTypeDef hdma_usart3_tx;
 
 /* USART1 init function */
 
@@ -161,6 +192,26 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+    /* USART1 DMA Init */
+    /* USART1_TX Init */
+    hdma_usart1_tx.Instance = DMA1_Channel4;
+    hdma_usart1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart1_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart1_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart1_tx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_usart1_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmatx,hdma_usart1_tx);
+
+    /* USART1 interrupt Init */
+    HAL_NVIC_SetPriority(USART1_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
   /* USER CODE BEGIN USART1_MspInit 1 */
 
   /* USER CODE END USART1_MspInit 1 */
@@ -196,7 +247,7 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
     hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
     hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart2_rx.Init.Mode = DMA_NORMAL;
+    hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
     hdma_usart2_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
     if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK)
     {
@@ -252,6 +303,22 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
 
     __HAL_LINKDMA(uartHandle,hdmarx,hdma_usart3_rx);
 
+    /* USART3_TX Init */
+    hdma_usart3_tx.Instance = DMA1_Channel2;
+    hdma_usart3_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart3_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart3_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart3_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart3_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart3_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart3_tx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_usart3_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmatx,hdma_usart3_tx);
+
     /* USART3 interrupt Init */
     HAL_NVIC_SetPriority(USART3_IRQn, 1, 1);
     HAL_NVIC_EnableIRQ(USART3_IRQn);
@@ -278,6 +345,11 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     */
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9|GPIO_PIN_10);
 
+    /* USART1 DMA DeInit */
+    HAL_DMA_DeInit(uartHandle->hdmatx);
+
+    /* USART1 interrupt Deinit */
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
   /* USER CODE BEGIN USART1_MspDeInit 1 */
 
   /* USER CODE END USART1_MspDeInit 1 */
@@ -321,6 +393,7 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
 
     /* USART3 DMA DeInit */
     HAL_DMA_DeInit(uartHandle->hdmarx);
+    HAL_DMA_DeInit(uartHandle->hdmatx);
 
     /* USART3 interrupt Deinit */
     HAL_NVIC_DisableIRQ(USART3_IRQn);
@@ -343,35 +416,36 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
 	if(huart->Instance==USART2)
 	{
-    u1_printf("(DBG) USART2 IDLE\r\n"); // for test
-    g_uart_rx_frame.sta.len = Size; /* 覆盖之前收到的数据 */
-    g_uart_rx_frame.sta.finsh = 1;  /* 标记帧接收完成 */
-    user_gps_getdata();
-    u2_start_idle_receive();
+    /* 循环DMA模式下，IDLE、半传输和传输完成事件都会进入此回调，DMA 无需重新启动
+     * 中断中只更新环形缓冲写位置，解析和打印在主循环中完成
+     */
+    atk_mo1218_uart_rx_event_from_isr();
   }
   else if(huart->Instance==USART3)
 	{
-    USART3_RxLen = Size;
-    USART3_RecvEndFlag = 1;
-    // 进入此中断，USART3 接受到的数据存放在 USART3_RxBUF 里面，可以调试以下看看是什么，然后做判断。
-    // 判断举例：
-    if (USART3_RxBUF[1] == 0x01)
+    /* 半传输事件时 DMA 仍在接收，等待 IDLE 或传输完成事件 */
+    if (HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_HT)
     {
-      print_mode = 1; // print mode 用于后续控制打印给串口屏的内容
+      return;
     }
-    else if (USART3_RxBUF[1] == 0x02)
+
+    /* 把接收到的一帧拷贝到队列后立即重新启动接收，帧的处理在主循环中完成，见 user_hmi_process() */
+    usart3_rx_frame_t frame;
+    frame.len = (Size < USART3_RX_FRAME_MAXLEN) ? Size : USART3_RX_FRAME_MAXLEN;
+    if (Size > USART3_RX_FRAME_MAXLEN)
     {
-      print_mode = 2;
+      g_u3_rx_truncated++;
     }
-
-    // 以下 todo: for test only, 实现把接受到的数据从 USART3 重新发送出去。
-    u3_printf((char *)USART3_RxBUF);
+    memcpy(frame.data, USART3_RxBUF, frame.len);
+    spsc_queue_push(&g_u3_rx_queue, &frame);
     u3_start_idle_receive();
   }
 }
 
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
+  uart_tx_error(huart);
+
   if (__HAL_UART_GET_FLAG(huart, UART_FLAG_ORE) != RESET) /* UART接收过载错误中断 */
   {
     __HAL_UART_CLEAR_OREFLAG(huart); /* 清除接收过载错误中断标志 */
@@ -380,36 +454,31 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
     huart->RxState = HAL_UART_STATE_READY;
     huart->Lock = HAL_UNLOCKED;
   }
+  /* 中断中不打印，只计数 */
   if (huart->Instance == USART2)
   {
-    u1_printf("(DBG) USART2 ORE\r\n");
+    g_uart_error_count[1]++;
     u2_start_idle_receive();
   }
   else if (huart->Instance == USART3)
   {
-    u1_printf("(DBG) USART3 ORE\r\n");
+    g_uart_error_count[2]++;
     u3_start_idle_receive();
   }
   else
   {
-    u1_printf("(DBG) ORE ERROR\r\n");
+    g_uart_error_count[0]++;
   }
 }
 
 /**
- * @description: 启动串口2接受空闲中断
+ * @description: 启动串口2循环 DMA 接收，仅在上电或出错后调用一次
  * @return {*}
  */
 void u2_start_idle_receive(void)
 {
-  // USART2_RecvEndFlag = 0;
-  // memset(USART2_RxBUF, 0, USART2_MAX_RECVLEN);
-  // HAL_UARTEx_ReceiveToIdle_IT(&huart2, USART2_RxBUF, USART2_MAX_RECVLEN);
-  g_uart_rx_frame.sta.len = 0;
-  g_uart_rx_frame.sta.finsh = 0;
-  memset(g_uart_rx_frame.buf, 0, ATK_MO1218_UART_RX_BUF_SIZE);
-  // HAL_UARTEx_ReceiveToIdle_IT(&huart2, g_uart_rx_frame.buf, ATK_MO1218_UART_RX_BUF_SIZE);
-  HAL_UARTEx_ReceiveToIdle_DMA(&huart2, g_uart_rx_frame.buf, ATK_MO1218_UART_RX_BUF_SIZE);
+  /* 重新启动前的数据和帧描述符由读取方丢弃，这里不修改读取方的状态 */
+  atk_mo1218_uart_rx_ring_start();
 }
 
 /**
@@ -418,96 +487,368 @@ void u2_start_idle_receive(void)
  */
 void u3_start_idle_receive(void)
 {
-  USART3_RecvEndFlag = 0;
-  memset(USART3_RxBUF, 0, USART3_MAX_RECVLEN);
   HAL_UARTEx_ReceiveToIdle_DMA(&huart3, USART3_RxBUF, USART3_MAX_RECVLEN);
 }
 
 /**
- * @description: 向 USART1 串口发送缓冲区中字符串 注意，\00将被移除
- * @param {char} *fmt 需要发送的字符串
+ * @description: 从接收帧队列取出 USART3 接收到的一帧
+ * @param {usart3_rx_frame_t} *frame
+ * @return {*} 0: 取到一帧；1: 队列空
+ */
+uint8_t u3_get_frame(usart3_rx_frame_t *frame)
+{
+  return spsc_queue_pop(&g_u3_rx_queue, frame);
+}
+
+/**
+ * @description: 获取 USART3 接收帧队列统计
+ * @param {spsc_queue_stats_t} *stats
  * @return {*}
  */
-void u1_printf(char *fmt, ...)
+void u3_get_rx_stats(spsc_queue_stats_t *stats)
 {
-  memset(USART1_TxBUF, 0, USART1_MAX_SENDLEN);
-  uint16_t i, j;
-  va_list ap;
-  va_start(ap, fmt);
-  vsprintf((char *)USART1_TxBUF, fmt, ap);
-  va_end(ap);
+  spsc_queue_get_stats(&g_u3_rx_queue, stats);
+}
+
+/**
+ * @description: 获取 USART3 接收帧被截断的次数
+ * @return {*} 超过 USART3_RX_FRAME_MAXLEN 被截断的帧数
+ */
+uint32_t u3_get_rx_truncated(void)
+{
+  return g_u3_rx_truncated;
+}
+
+/**
+ * @description: 获取串口错误（如接收过载）次数
+ * @param {UART_HandleTypeDef} *huart
+ * @return {*}
+ */
+uint32_t uart_get_error_count(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART1)
+  {
+    return g_uart_error_count[0];
+  }
+  else if (huart->Instance == USART2)
+  {
+    return g_uart_error_count[1];
+  }
+  else if (huart->Instance == USART3)
+  {
+    return g_uart_error_count[2];
+  }
+
+  return 0;
+}
 
-  for (i = 0; i < USART1_MAX_SENDLEN; i++)
+/**
+ * @description: 获取串口对应的发送队列
+ * @param {UART_HandleTypeDef} *huart
+ * @return {*} 发送队列，没有发送队列的串口返回 NULL
+ */
+static uart_tx_queue_t *uart_tx_get_queue(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART1)
+  {
+    return &g_u1_tx;
+  }
+  else if (huart->Instance == USART3)
   {
-    j = i + 1;
-    if (USART1_TxBUF[i] == '\00')
+    return &g_u3_tx;
+  }
+
+  return NULL;
+}
+
+/**
+ * @description: 获取发送队列中待发送（含正在发送）的字节数
+ * @param {uart_tx_queue_t} *q
+ * @return {*}
+ */
+static uint16_t uart_tx_used(uart_tx_queue_t *q)
+{
+  return (uint16_t)((q->head + q->size - q->tail) % q->size);
+}
+
+/**
+ * @description: DMA 空闲时启动发送队列中的下一段连续数据，需在关中断或发送完成中断中调用
+ * @param {uart_tx_queue_t} *q
+ * @return {*}
+ */
+static void uart_tx_kick(uart_tx_queue_t *q)
+{
+  uint16_t len;
+
+  if ((q->dma_len != 0) || (q->head == q->tail))
+  {
+    return;
+  }
+
+  /* 数据跨过缓冲末尾时分两段发送 */
+  len = (q->head > q->tail) ? (q->head - q->tail) : (q->size - q->tail);
+  if (HAL_UART_Transmit_DMA(q->huart, &q->buf[q->tail], len) == HAL_OK)
+  {
+    q->dma_len = len;
+  }
+}
+
+/**
+ * @description: 将数据写入发送队列并启动发送
+ * @param {uart_tx_queue_t} *q
+ * @param {uint8_t} *data
+ * @param {uint16_t} len
+ * @return {*} 写入的字节数，队列空间不足被丢弃时返回 0
+ */
+static uint16_t uart_tx_enqueue(uart_tx_queue_t *q, const uint8_t *data, uint16_t len)
+{
+  uint32_t primask;
+  uint32_t start;
+  uint16_t head;
+  uint16_t first;
+  uint16_t used;
+
+  if (len == 0)
+  {
+    return 0;
+  }
+
+  /* 中断中写入会破坏单生产者约定；比队列还长的消息等待也放不下，都直接丢弃 */
+  if ((__get_IPSR() != 0) || (len >= q->size))
+  {
+    q->stats.dropped++;
+    q->stats.dropped_bytes += len;
+    return 0;
+  }
+
+  /* 队列空间不足时，按策略丢弃或等待发送完成中断释放空间（关中断时不能等待） */
+  start = HAL_GetTick();
+  while ((q->size - 1 - uart_tx_used(q)) < len)
+  {
+    if ((q->policy == UART_TX_POLICY_DROP) || (__get_PRIMASK() != 0) || ((HAL_GetTick() - start) >= UART_TX_BLOCK_TIMEOUT))
     {
-      for (; j < USART1_MAX_SENDLEN; j++)
-      {
-        USART1_TxBUF[j - 1] = USART1_TxBUF[j];
-      }
+      q->stats.dropped++;
+      q->stats.dropped_bytes += len;
+      return 0;
     }
   }
-  i = strlen((const char *)USART1_TxBUF);
-  HAL_UART_Transmit(&huart1, (uint8_t *)USART1_TxBUF, i, 200);
+
+  head = q->head;
+  first = q->size - head;
+  if (first > len)
+  {
+    first = len;
+  }
+  memcpy(&q->buf[head], data, first);
+  memcpy(q->buf, &data[first], len - first);
+  __DMB();                              /* 数据写入完成后再发布 head */
+  q->head = (head + len) % q->size;
+
+  q->stats.queued++;
+  used = uart_tx_used(q);
+  if (used > q->stats.high_water)
+  {
+    q->stats.high_water = used;
+  }
+
+  /* 判断 DMA 是否空闲与启动发送需在关中断时完成，否则可能与发送完成中断同时判断为不需要启动 */
+  primask = __get_PRIMASK();
+  __disable_irq();
+  uart_tx_kick(q);
+  __set_PRIMASK(primask);
+
+  return len;
+}
+
+/**
+ * @description: 格式化字符串并写入发送队列
+ * @param {uart_tx_queue_t} *q
+ * @param {char} *fmt
+ * @param {va_list} ap
+ * @return {*}
+ */
+static void uart_tx_vprintf(uart_tx_queue_t *q, char *fmt, va_list ap)
+{
+  char msg[UART_TX_MSG_MAXLEN];
+  int len;
+
+  len = vsnprintf(msg, sizeof(msg), fmt, ap);
+  if (len < 0)
+  {
+    return;
+  }
+
+  /* 超长的消息被截断 */
+  if (len >= (int)sizeof(msg))
+  {
+    len = sizeof(msg) - 1;
+  }
+
+  uart_tx_enqueue(q, (const uint8_t *)msg, (uint16_t)len);
 }
 
 /**
- * @description: 向 USART2 串口发送缓冲区中字符串 注意，\00将被移除
+ * @description: DMA 发送完成中断回调，接着发送队列中的下一段数据
+ * @param {UART_HandleTypeDef} *huart
+ * @return {*}
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  uart_tx_queue_t *q = uart_tx_get_queue(huart);
+  uint32_t primask;
+
+  if (q == NULL)
+  {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  q->tail = (q->tail + q->dma_len) % q->size;
+  q->dma_len = 0;
+  uart_tx_kick(q);
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @description: 串口出错时恢复发送队列，DMA 发送被 HAL 中止时重新发送未完成的一段
+ * @param {UART_HandleTypeDef} *huart
+ * @return {*}
+ */
+void uart_tx_error(UART_HandleTypeDef *huart)
+{
+  uart_tx_queue_t *q = uart_tx_get_queue(huart);
+  uint32_t primask;
+
+  if (q == NULL)
+  {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if ((q->dma_len != 0) && (huart->gState == HAL_UART_STATE_READY))
+  {
+    q->dma_len = 0;
+    uart_tx_kick(q);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @description: 获取发送队列统计
+ * @param {UART_HandleTypeDef} *huart 串口，仅 USART1、USART3 有发送队列
+ * @param {uart_tx_stats_t} *stats
+ * @return {*}
+ */
+void uart_tx_get_stats(UART_HandleTypeDef *huart, uart_tx_stats_t *stats)
+{
+  uart_tx_queue_t *q = uart_tx_get_queue(huart);
+  uint32_t primask;
+
+  if (q == NULL)
+  {
+    memset(stats, 0, sizeof(uart_tx_stats_t));
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  memcpy(stats, &q->stats, sizeof(uart_tx_stats_t));
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @description: 等待发送队列中的数据全部发送完成（如复位前）
+ * @param {UART_HandleTypeDef} *huart 串口，仅 USART1、USART3 有发送队列
+ * @param {uint32_t} timeout 超时时间，单位：1毫秒
+ * @return {*}
+ */
+void uart_tx_flush(UART_HandleTypeDef *huart, uint32_t timeout)
+{
+  uart_tx_queue_t *q = uart_tx_get_queue(huart);
+  uint32_t start = HAL_GetTick();
+
+  if (q == NULL)
+  {
+    return;
+  }
+
+  while (((q->head != q->tail) || (q->dma_len != 0)) && ((HAL_GetTick() - start) < timeout))
+  {
+  }
+}
+
+/**
+ * @description: 向 USART1 发送格式化字符串，写入发送队列后立即返回
+ * @param {char} *fmt 需要发送的字符串
+ * @return {*}
+ */
+void u1_printf(char *fmt, ...)
+{
+  va_list ap;
+  va_start(ap, fmt);
+  uart_tx_vprintf(&g_u1_tx, fmt, ap);
+  va_end(ap);
+}
+
+/**
+ * @description: 向 USART2 串口发送缓冲区中字符串（阻塞发送）
  * @param {char} *fmt 需要发送的字符串
  * @return {*}
  */
 void u2_printf(char *fmt, ...)
 {
-  memset(USART2_TxBUF, 0, USART2_MAX_SENDLEN);
-  uint16_t i, j;
+  int len;
   va_list ap;
   va_start(ap, fmt);
-  vsprintf((char *)USART2_TxBUF, fmt, ap);
+  len = vsnprintf((char *)USART2_TxBUF, USART2_MAX_SENDLEN, fmt, ap);
   va_end(ap);
 
-  for (i = 0; i < USART2_MAX_SENDLEN; i++)
+  if (len < 0)
   {
-    j = i + 1;
-    if (USART2_TxBUF[i] == '\00')
-    {
-      for (; j < USART2_MAX_SENDLEN; j++)
-      {
-        USART2_TxBUF[j - 1] = USART2_TxBUF[j];
-      }
-    }
+    return;
+  }
+  if (len >= USART2_MAX_SENDLEN)
+  {
+    len = USART2_MAX_SENDLEN - 1;
   }
-  i = strlen((const char *)USART2_TxBUF);
-  HAL_UART_Transmit(&huart2, (uint8_t *)USART2_TxBUF, i, 200);
+  HAL_UART_Transmit(&huart2, (uint8_t *)USART2_TxBUF, len, 200);
 }
 
 /**
- * @description: 向 USART3 串口发送缓冲区中字符串 注意，\00将被移除
+ * @description: 向 USART3 发送格式化字符串，写入发送队列后立即返回
  * @param {char} *fmt 需要发送的字符串
  * @return {*}
  */
 void u3_printf(char *fmt, ...)
 {
-  memset(USART3_TxBUF, 0, USART3_MAX_SENDLEN);
-  uint16_t i, j;
   va_list ap;
   va_start(ap, fmt);
-  vsprintf((char *)USART3_TxBUF, fmt, ap);
+  uart_tx_vprintf(&g_u3_tx, fmt, ap);
   va_end(ap);
+}
 
-  for (i = 0; i < USART3_MAX_SENDLEN; i++)
-  {
-    j = i + 1;
-    if (USART3_TxBUF[i] == '\00')
-    {
-      for (; j < USART3_MAX_SENDLEN; j++)
-      {
-        USART3_TxBUF[j - 1] = USART3_TxBUF[j];
-      }
-    }
-  }
-  i = strlen((const char *)USART3_TxBUF);
-  HAL_UART_Transmit(&huart3, (uint8_t *)USART3_TxBUF, i, 200);
+/**
+ * @description: 向 USART1 发送原始数据，写入发送队列后立即返回
+ * @param {uint8_t} *data
+ * @param {uint16_t} len
+ * @return {*} 写入的字节数，被丢弃时返回 0
+ */
+uint16_t u1_write(const uint8_t *data, uint16_t len)
+{
+  return uart_tx_enqueue(&g_u1_tx, data, len);
+}
+
+/**
+ * @description: 向 USART3 发送原始数据，写入发送队列后立即返回
+ * @param {uint8_t} *data
+ * @param {uint16_t} len
+ * @return {*} 写入的字节数，被丢弃时返回 0
+ */
+uint16_t u3_write(const uint8_t *data, uint16_t len)
+{
+  return uart_tx_enqueue(&g_u3_tx, data, len);
 }
 
 /* USER CODE END 1 */